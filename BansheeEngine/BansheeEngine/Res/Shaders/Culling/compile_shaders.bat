@@ -0,0 +1,5 @@
+C:/VulkanSDK/1.3.283.0/Bin/glslc.exe cull.comp -o cull_comp.spv
+C:/VulkanSDK/1.3.283.0/Bin/glslc.exe -DOCCLUSION_CULLING cull.comp -o cull_occlusion_comp.spv
+C:/VulkanSDK/1.3.283.0/Bin/glslc.exe depth_pyramid.comp -o depth_pyramid_comp.spv
+C:/VulkanSDK/1.3.283.0/Bin/glslc.exe compact_draws.comp -o compact_draws_comp.spv
+pause
\ No newline at end of file
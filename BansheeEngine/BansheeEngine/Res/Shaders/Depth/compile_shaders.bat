@@ -0,0 +1,2 @@
+C:/VulkanSDK/1.3.283.0/Bin/glslc.exe depth.vert -o depth_vert.spv
+pause
\ No newline at end of file
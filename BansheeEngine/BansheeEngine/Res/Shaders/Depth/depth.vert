@@ -0,0 +1,31 @@
+#version 450
+
+layout (location = 0) in vec3 in_vertex_position;
+
+layout (set = 0, binding = 0) uniform ViewProjBuffer
+{
+	mat4 view;
+	mat4 proj;
+} u_ViewProj;
+
+struct InstanceData
+{
+	mat4 model;
+	int textureId;
+	int hasCustomTexture;
+	int materialIndex;
+};
+
+layout (std430, set = 0, binding = 5) readonly buffer InstanceBuffer
+{
+	InstanceData instances[];
+} u_Instances;
+
+// Same expression as the shading passes, which test EQUAL against the depth written here
+invariant gl_Position;
+
+void main()
+{
+	const InstanceData instance = u_Instances.instances[gl_InstanceIndex];
+	gl_Position = u_ViewProj.proj * u_ViewProj.view * instance.model * vec4(in_vertex_position, 1.0f);
+}
\ No newline at end of file
@@ -0,0 +1,2 @@
+C:/VulkanSDK/1.3.283.0/Bin/glslc.exe cluster_lights.comp -o cluster_lights_comp.spv
+pause
\ No newline at end of file
@@ -7,58 +7,193 @@ layout (location = 2) flat in int in_texture_index;
 layout (location = 3) flat in int in_texture_available;
 layout (location = 4) in vec3 in_fragment_position;
 layout (location = 5) in vec3 in_fragment_normal;
+layout (location = 6) flat in int in_material_index;
 
 layout (location = 0) out vec4 out_frag_color;
 
 layout (binding = 2) uniform texture2D textures[];
 layout (binding = 3) uniform sampler texture_sampler;
 
-layout (set = 0, binding = 1) uniform Material
+struct MaterialData
 {
-	vec3 diffuseColor;
-	vec3 specularColor;
+	vec4 diffuseColor;
+	vec4 specularColor;
 	float shininess;
-} u_Material;
+};
 
-layout (set = 0, binding = 4) uniform LightUBO
+layout (std430, set = 0, binding = 1) readonly buffer MaterialBuffer
+{
+	MaterialData materials[];
+} u_Materials;
+
+// Lights are binned into view-space clusters by Res/Shaders/Lighting/cluster_lights.comp, and a fragment only visits its cluster's lights
+layout (set = 0, binding = 4) uniform ClusterUBO
+{
+	uvec4 gridSize;   // Clusters along x, y and z, cluster list stride
+	vec4 params;      // Tile width and height in pixels, depth slice scale and bias
+} u_Clusters;
+
+struct LightData
 {
 	vec3 position;
-	float padding1;
+	float range;
 	vec3 color;
+	int shadowTile;
+	vec3 direction;
+	float spotScale;
+	float spotOffset;
+	float padding0;
+	float padding1;
 	float padding2;
-} u_Light;
+};
+
+layout (std430, set = 0, binding = 6) readonly buffer LightBuffer
+{
+	LightData lights[];
+} u_Lights;
+
+// Per cluster, the light count followed by the indices of the lights reaching it
+layout (std430, set = 0, binding = 7) readonly buffer ClusterLightListBuffer
+{
+	uint lists[];
+} u_ClusterLightLists;
+
+const uint SHADOW_TILE_COUNT = 16;
+
+// Shadow maps share one depth atlas. Tile matrices take view-space positions to atlas texture coordinates and depth,
+// the directional light's cascades occupy the first tiles
+layout (set = 0, binding = 8) uniform ShadowUBO
+{
+	mat4 tileMatrices[SHADOW_TILE_COUNT];
+	vec4 cascadeSplits;          // View-space distance at which each cascade ends
+	vec4 directionalDirection;   // View-space direction the light travels, cascade count in w (0 without shadows)
+	vec4 directionalColor;       // 1 in w when there is a directional light
+	vec4 params;                 // Atlas texel size, tile size in texture coordinates, tiles per row
+} u_Shadows;
+
+layout (binding = 9) uniform texture2D shadowAtlas;
+layout (binding = 10) uniform sampler shadowSampler;
+
+uint GetClusterIndex()
+{
+	const uvec3 gridSize = u_Clusters.gridSize.xyz;
+	const uvec2 tile = min(uvec2(gl_FragCoord.xy / u_Clusters.params.xy), gridSize.xy - 1);
+	const float slice = log(max(-in_fragment_position.z, 1e-4f)) * u_Clusters.params.z + u_Clusters.params.w;
+	const uint z = uint(clamp(slice, 0.0f, float(gridSize.z - 1)));
+	return tile.x + tile.y * gridSize.x + z * gridSize.x * gridSize.y;
+}
+
+// 3x3 PCF. Taps are kept inside the tile, so filtering never reads a neighbouring shadow map
+float SampleShadow(const int tile)
+{
+	const vec4 shadowCoord = u_Shadows.tileMatrices[tile] * vec4(in_fragment_position, 1.0f);
+	if (shadowCoord.w <= 0.0f)
+	{
+		return 1.0f;
+	}
+
+	const vec3 coord = shadowCoord.xyz / shadowCoord.w;
+	const float texelSize = u_Shadows.params.x;
+	const float tileSize = u_Shadows.params.y;
+	const vec2 tileMin = vec2(tile % int(u_Shadows.params.z), tile / int(u_Shadows.params.z)) * tileSize;
+	const vec2 tileMax = tileMin + tileSize;
+	if (coord.z > 1.0f || any(lessThan(coord.xy, tileMin)) || any(greaterThan(coord.xy, tileMax)))
+	{
+		return 1.0f;
+	}
+
+	const vec2 innerMin = tileMin + 1.5f * texelSize;
+	const vec2 innerMax = tileMax - 1.5f * texelSize;
+	float shadow = 0.0f;
+	for (int y = -1; y <= 1; ++y)
+	{
+		for (int x = -1; x <= 1; ++x)
+		{
+			const vec2 uv = clamp(coord.xy + vec2(x, y) * texelSize, innerMin, innerMax);
+			shadow += texture(sampler2DShadow(shadowAtlas, shadowSampler), vec3(uv, coord.z));
+		}
+	}
+
+	return shadow / 9.0f;
+}
 
 void main()
 {
- 	vec4 baseColor = vec4(u_Material.diffuseColor, 1.0f);
+	const MaterialData material = u_Materials.materials[in_material_index];
+ 	vec4 baseColor = vec4(material.diffuseColor.rgb, 1.0f);
 
 	if (in_texture_available == 1)
 	{
 		vec4 texColor = texture(sampler2D(textures[in_texture_index], texture_sampler), in_vertex_texCoord);
-		baseColor = texColor * vec4(u_Material.diffuseColor, 1.0);
+		baseColor = texColor * vec4(material.diffuseColor.rgb, 1.0);
 	}
 
-	// Ambient 
 	const float ambientStrength = 0.1f;
+	const float specularStrength = 0.5f;
 	const vec3 minimumAmbient = vec3(0.1f, 0.1f, 0.1f);
-	const vec3 lightColor = u_Light.color + minimumAmbient;
-    const vec3 ambient = ambientStrength * u_Light.color;
-
-	// Diffuse
 	const vec3 norm = normalize(in_fragment_normal);
-	const vec3 lightDir = normalize(u_Light.position - in_fragment_position);
-	const float diffuseImpact = max(dot(norm, lightDir), 0.0);
-	const vec3 diffuse = diffuseImpact * lightColor;
-
-	// Specular
-    const float specularStrength = 0.5f;
-    const vec3 viewDir = normalize(-in_fragment_position);
-    const vec3 reflectDir = reflect(-lightDir, norm);
-    const float spec = pow(max(dot(viewDir, reflectDir), 0.0), u_Material.shininess);
-    const vec3 specular = specularStrength * spec * lightColor; 
-
-	// Combine lighting effect
-	const vec3 lighting = ambient + diffuse + specular;
+	const vec3 viewDir = normalize(-in_fragment_position);
+
+	const uint cluster = GetClusterIndex();
+	const uint list = cluster * u_Clusters.gridSize.w;
+	const uint lightCount = u_ClusterLightLists.lists[list];
+	vec3 lighting = minimumAmbient;
+
+	for (uint i = 0; i < lightCount; ++i)
+	{
+		const LightData light = u_Lights.lights[u_ClusterLightLists.lists[list + 1 + i]];
+		const vec3 toLight = light.position - in_fragment_position;
+		const float distance = length(toLight);
+
+		// Smooth falloff reaching zero at the light's range, so lights outside a cluster contribute nothing there either
+		const float falloff = clamp(1.0f - (distance * distance) / (light.range * light.range), 0.0f, 1.0f);
+		float attenuation = falloff * falloff;
+
+		// Ambient
+		const vec3 ambient = ambientStrength * light.color;
+
+		// Spot lights fade out between their inner and outer cone, point lights have a cone covering everything
+		const vec3 lightDir = toLight / max(distance, 1e-4f);
+		const float spot = clamp(dot(-lightDir, light.direction) * light.spotScale + light.spotOffset, 0.0f, 1.0f);
+		const float shadow = light.shadowTile >= 0 ? SampleShadow(light.shadowTile) : 1.0f;
+
+		// Diffuse
+		const float diffuseImpact = max(dot(norm, lightDir), 0.0);
+		const vec3 diffuse = diffuseImpact * light.color;
+
+		// Specular
+		const vec3 reflectDir = reflect(-lightDir, norm);
+		const float spec = pow(max(dot(viewDir, reflectDir), 0.0), material.shininess);
+		const vec3 specular = specularStrength * spec * light.color;
+
+		attenuation *= spot * spot;
+		lighting += attenuation * (ambient + shadow * (diffuse + specular));
+	}
+
+	// The directional light reaches every fragment. Cascades are picked by view depth, and there is no shadow past the last one
+	if (u_Shadows.directionalColor.w > 0.0f)
+	{
+		const vec3 color = u_Shadows.directionalColor.rgb;
+		const vec3 lightDir = -normalize(u_Shadows.directionalDirection.xyz);
+		const int cascadeCount = int(u_Shadows.directionalDirection.w);
+		const float depth = -in_fragment_position.z;
+
+		float shadow = 1.0f;
+		for (int cascade = 0; cascade < cascadeCount; ++cascade)
+		{
+			if (depth <= u_Shadows.cascadeSplits[cascade])
+			{
+				shadow = SampleShadow(cascade);
+				break;
+			}
+		}
+
+		const vec3 ambient = ambientStrength * color;
+		const vec3 diffuse = max(dot(norm, lightDir), 0.0) * color;
+		const vec3 reflectDir = reflect(-lightDir, norm);
+		const vec3 specular = specularStrength * pow(max(dot(viewDir, reflectDir), 0.0), material.shininess) * color;
+		lighting += ambient + shadow * (diffuse + specular);
+	}
 
 	out_frag_color = baseColor * vec4(lighting, 1.0f);
 }
\ No newline at end of file
@@ -10,6 +10,7 @@ layout (location = 2) out int out_texture_index;
 layout (location = 3) out int out_texture_available;
 layout (location = 4) out vec3 out_fragment_position;
 layout (location = 5) out vec3 out_fragment_normal;
+layout (location = 6) out int out_material_index;
 
 layout (set = 0, binding = 0) uniform ViewProjBuffer
 {
@@ -17,21 +18,33 @@ layout (set = 0, binding = 0) uniform ViewProjBuffer
 	mat4 proj;
 } u_ViewProj;
 
-layout (push_constant) uniform PushConstants
+struct InstanceData
 {
 	mat4 model;
 	int textureId;
 	int hasCustomTexture;
-} u_PushConstants;
+	int materialIndex;
+};
+
+// Instanced draws start at their group's first instance, so gl_InstanceIndex addresses this frame's instance array directly
+layout (std430, set = 0, binding = 5) readonly buffer InstanceBuffer
+{
+	InstanceData instances[];
+} u_Instances;
+
+// Must match the depth prepass bit for bit, as opaque geometry is shaded with depth test EQUAL against it
+invariant gl_Position;
 
 void main()
 {
-	gl_Position = u_ViewProj.proj * u_ViewProj.view * u_PushConstants.model * vec4(in_vertex_position, 1.0f);
-	out_fragment_position = vec3(u_ViewProj.view * u_PushConstants.model * vec4(in_vertex_position, 1.0f));
-	out_fragment_normal = mat3(transpose(inverse(u_ViewProj.view * u_PushConstants.model))) * in_vertex_normal;
+	const InstanceData instance = u_Instances.instances[gl_InstanceIndex];
+	gl_Position = u_ViewProj.proj * u_ViewProj.view * instance.model * vec4(in_vertex_position, 1.0f);
+	out_fragment_position = vec3(u_ViewProj.view * instance.model * vec4(in_vertex_position, 1.0f));
+	out_fragment_normal = mat3(transpose(inverse(u_ViewProj.view * instance.model))) * in_vertex_normal;
 	
 	out_vertex_texCoord = in_vertex_texCoord;
 	out_vertex_normal = in_vertex_normal;
-	out_texture_available = u_PushConstants.hasCustomTexture;
-	out_texture_index = u_PushConstants.textureId;
+	out_texture_available = instance.hasCustomTexture;
+	out_texture_index = instance.textureId;
+	out_material_index = instance.materialIndex;
 }
\ No newline at end of file
@@ -2,7 +2,11 @@
 #include "Foundation/Logging/Logger.h"
 #include "Foundation/INIParser.h"
 #include "Foundation/Timer/Timer.h"
+#include "Foundation/Jobs/JobSystem.h"
+#include "Foundation/Systems/SystemScheduler.h"
+#include "Foundation/Events/ComponentEvents.h"
 #include "Graphics/Window.h"
+#include "Graphics/Systems/TransformSystem.h"
 #include "Graphics/Vulkan/VulkanRenderer.h"
 
 namespace Banshee
@@ -11,11 +15,15 @@ namespace Banshee
 		m_INIParser{ std::make_unique<INIParser>() },
 		m_Window{ nullptr },
 		m_Renderer{ nullptr },
-		m_Timer{ std::make_unique<Timer>() }
+		m_Timer{ std::make_unique<Timer>() },
+		m_JobSystem{ std::make_unique<JobSystem>() },
+		m_SystemScheduler{ std::make_unique<SystemScheduler>(*m_JobSystem) },
+		m_TransformSystem{ std::make_unique<TransformSystem>() }
 	{
 		BE_LOG(LogCategory::Trace, "[APPLICATION]: Banshee initializing");
 		const EngineConfig configSettings = m_INIParser->ParseConfigSettings("config.ini");
-		m_Window = std::make_unique<Window>(configSettings.m_WindowWidth, configSettings.m_WindowHeight, configSettings.m_WindowTitle);
+		m_Window = std::make_unique<Window>(configSettings.m_WindowWidth, configSettings.m_WindowHeight, configSettings.m_WindowTitle,
+			configSettings.m_Headless, configSettings.m_FrameLimit);
 	}
 
 	Application::~Application()
@@ -26,7 +34,7 @@ namespace Banshee
 	void Application::InitializeRenderer()
 	{
 		BE_LOG(LogCategory::Trace, "[APPLICATION]: Beginning post-client initialization step");
-		m_Renderer = std::make_unique<VulkanRenderer>(*m_Window.get());
+		m_Renderer = std::make_unique<VulkanRenderer>(*m_Window.get(), m_INIParser->GetConfigSettings(), *m_JobSystem);
 	}
 
 	void Application::Run() const
@@ -36,8 +44,28 @@ namespace Banshee
 		while (!m_Window->ShouldWindowClose())
 		{
 			m_Timer->Update();
+			m_SystemScheduler->Run(m_Timer->GetDeltaTime());
+			// Deliver the component events batched up since the last frame, once every worker is idle again
+			ComponentEvents::Flush();
+			// World matrices are resolved after every system had a chance to move things this frame
+			m_TransformSystem->Update();
 			m_Renderer->DrawFrame(m_Timer->GetDeltaTime());
 			m_Window->PollEvents();
 		}
 	}
+
+	SystemScheduler& Application::GetSystemScheduler() const noexcept
+	{
+		return *m_SystemScheduler;
+	}
+
+	CullingStats Application::GetCullingStats() const noexcept
+	{
+		return m_Renderer ? m_Renderer->GetCullingStats() : CullingStats{};
+	}
+
+	CommandEncoderStats Application::GetCommandStats() const noexcept
+	{
+		return m_Renderer ? m_Renderer->GetCommandStats() : CommandEncoderStats{};
+	}
 } // End of Banshee namespace
\ No newline at end of file
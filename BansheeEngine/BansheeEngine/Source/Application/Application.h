@@ -9,6 +9,11 @@ namespace Banshee
 	class Window;
 	class VulkanRenderer;
 	class Timer;
+	class JobSystem;
+	class SystemScheduler;
+	class TransformSystem;
+	struct CullingStats;
+	struct CommandEncoderStats;
 
 	class Application
 	{
@@ -18,6 +23,11 @@ namespace Banshee
 
 		BANSHEE_ENGINE void InitializeRenderer();
 		BANSHEE_ENGINE void Run() const;
+		BANSHEE_ENGINE SystemScheduler& GetSystemScheduler() const noexcept;
+		// Visible and culled sub-mesh counts of the last rendered frame, or of the last one the GPU finished when culling runs on the GPU
+		BANSHEE_ENGINE CullingStats GetCullingStats() const noexcept;
+		// Pipeline, buffer and descriptor set binds, push constant updates and draws recorded in the last rendered frame
+		BANSHEE_ENGINE CommandEncoderStats GetCommandStats() const noexcept;
 
 		Application(const Application&) = delete;
 		Application(Application&&) = delete;
@@ -29,5 +39,8 @@ namespace Banshee
 		std::unique_ptr<Window> m_Window;
 		std::unique_ptr<VulkanRenderer> m_Renderer;
 		std::unique_ptr<Timer> m_Timer;
+		std::unique_ptr<JobSystem> m_JobSystem;
+		std::unique_ptr<SystemScheduler> m_SystemScheduler;
+		std::unique_ptr<TransformSystem> m_TransformSystem;
 	};
 } // End of Banshee namespace
@@ -1,36 +1,24 @@
 #pragma once
 
-#include <vector>
-#include <memory>
+#include "Foundation/Entity/Entity.h"
 
 namespace Banshee
 {
-	class Entity;
-	class Observer;
-
+	// Changes to component data are broadcast through ComponentEvents rather than per-component listeners.
+	// Components are never deleted through a base pointer (archetypes destroy them by concrete type), so the base carries no vtable
 	class Component
 	{
 	public:
 		Component() noexcept :
-			m_Dirty{ false },
-			m_Owner{ nullptr },
-			m_Observers{ nullptr }
+			m_Owner{}
 		{}
 
-		virtual ~Component() noexcept = default;
-
-		void SetDirty(const bool _dirty);
-		bool GetDirty() const noexcept { return m_Dirty; }
-		void SetOwner(const std::shared_ptr<Entity>& _owner) noexcept { m_Owner = _owner; }
-		const std::shared_ptr<Entity>& GetOwner() const noexcept { return m_Owner; }
-		void RegisterObserver(const std::shared_ptr<Observer>& _observer) noexcept;
+		~Component() noexcept = default;
 
-	private:
-		void NotifyObservers() const;
+		void SetOwner(const Entity _owner) noexcept { m_Owner = _owner; }
+		Entity GetOwner() const noexcept { return m_Owner; }
 
 	protected:
-		bool m_Dirty;
-		std::shared_ptr<Entity> m_Owner;
-		std::vector<std::shared_ptr<Observer>> m_Observers;
+		Entity m_Owner;
 	};
 } // End of Banshee namespace
\ No newline at end of file
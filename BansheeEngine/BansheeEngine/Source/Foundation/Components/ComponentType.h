@@ -0,0 +1,33 @@
+#pragma once
+
+#include "Foundation/Platform.h"
+
+namespace Banshee
+{
+	// Every component type declares its id as 'static constexpr ComponentType s_ComponentType'.
+	// Client components use ids from EngineComponentCount upwards
+	enum class ComponentType : uint8
+	{
+		Transform,
+		Mesh,
+		Light,
+		EngineComponentCount
+	};
+
+	// One bit per component type, so an entity can hold at most 64 different component types
+	typedef uint64 ComponentMask;
+	constexpr uint32 g_MaxComponentTypes{ 64 };
+
+	template<typename T>
+	constexpr uint32 GetComponentTypeId() noexcept
+	{
+		static_assert(static_cast<uint32>(T::s_ComponentType) < g_MaxComponentTypes, "Component type id exceeds the component mask width");
+		return static_cast<uint32>(T::s_ComponentType);
+	}
+
+	template<typename... Ts>
+	constexpr ComponentMask MakeComponentMask() noexcept
+	{
+		return (ComponentMask{ 0 } | ... | (ComponentMask{ 1 } << GetComponentTypeId<Ts>()));
+	}
+} // End of Banshee namespace
\ No newline at end of file
@@ -11,11 +11,33 @@ namespace Banshee
 		EngineConfig() noexcept :
 			m_WindowWidth{ 400 },
 			m_WindowHeight{ 300 },
-			m_WindowTitle{ "Untitled" }
+			m_WindowTitle{ "Untitled" },
+			m_Headless{ false },
+			m_FrameLimit{ 0 },
+			m_FramesInFlight{ 2 },
+			m_MaxInstances{ 8192 },
+			m_GpuDrivenRendering{ false },
+			m_DepthPrepass{ false },
+			m_OcclusionCulling{ false }
 		{};
 
 		uint32 m_WindowWidth;
 		uint32 m_WindowHeight;
 		std::string m_WindowTitle;
+		// Presents to a VK_EXT_headless_surface instead of a GLFW window, for machines without a display such as CI runners using lavapipe or SwiftShader
+		bool m_Headless;
+		// Closes the application after this many frames, 0 runs until the window is closed. Headless runs have no other way to end
+		uint32 m_FrameLimit;
+		// How many frames the CPU may record ahead of the GPU. More frames hide GPU stalls at the cost of input latency
+		uint32 m_FramesInFlight;
+		// Upper bound on sub-mesh instances drawn per frame. Sizes the per-frame instance memory, so only raise it for dense scenes
+		uint32 m_MaxInstances;
+		// Frustum culls and builds draw commands in a compute pass, drawn with vkCmdDrawIndexedIndirectCount. Needs Res/Shaders/Culling compiled
+		bool m_GpuDrivenRendering;
+		// Lays down opaque depth with a position-only pass so the main pass shades each pixel once. Needs Res/Shaders/Depth compiled
+		bool m_DepthPrepass;
+		// Also culls what the previous frame's depth hides, in two phases so objects coming into view are drawn the frame they appear.
+		// Only used with m_GpuDrivenRendering
+		bool m_OcclusionCulling;
 	};
 } // End of Banshee namespace
\ No newline at end of file
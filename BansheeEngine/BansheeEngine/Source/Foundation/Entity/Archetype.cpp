@@ -0,0 +1,186 @@
+#include "Archetype.h"
+#include <cassert>
+#include <malloc.h>
+
+namespace Banshee
+{
+	static uint32 AlignUp(const uint32 _value, const uint32 _alignment) noexcept
+	{
+		return (_value + _alignment - 1) & ~(_alignment - 1);
+	}
+
+	Archetype::Archetype(const std::vector<const ComponentTypeInfo*>& _types, ChunkPool& _chunkPool) :
+		m_Types{ _types },
+		m_ColumnOffsets(_types.size(), 0),
+		m_Chunks{},
+		m_ChunkPool{ _chunkPool },
+		m_ColumnLookup{},
+		m_AddEdges{},
+		m_RemoveEdges{},
+		m_Mask{ 0 },
+		m_ChunkBytes{ 0 },
+		m_ChunkCapacity{ 0 },
+		m_EntityCount{ 0 },
+		m_RowVersion{ 0 }
+	{
+		m_ColumnLookup.fill(-1);
+
+		for (size_t column = 0; column < m_Types.size(); ++column)
+		{
+			m_ColumnLookup[m_Types[column]->m_TypeId] = static_cast<int8>(column);
+			m_Mask |= ComponentMask{ 1 } << m_Types[column]->m_TypeId;
+		}
+
+		ComputeChunkLayout();
+	}
+
+	Archetype::~Archetype()
+	{
+		for (uint32 row = 0; row < m_EntityCount; ++row)
+		{
+			for (size_t column = 0; column < m_Types.size(); ++column)
+			{
+				m_Types[column]->m_Destroy(GetComponent(static_cast<int32>(column), row));
+			}
+		}
+
+		for (uint8* const chunk : m_Chunks)
+		{
+			FreeChunk(chunk);
+		}
+	}
+
+	void Archetype::ComputeChunkLayout()
+	{
+		// The entity id array sits at the start of the chunk, followed by one cache line aligned array per component type
+		const auto computeLayout = [this](const uint32 _capacity) noexcept
+		{
+			uint32 offset = AlignUp(_capacity * static_cast<uint32>(sizeof(uint32)), s_ChunkAlignment);
+			for (size_t i = 0; i < m_Types.size(); ++i)
+			{
+				assert(m_Types[i]->m_Alignment <= s_ChunkAlignment);
+				m_ColumnOffsets[i] = offset;
+				offset = AlignUp(offset + _capacity * m_Types[i]->m_Size, s_ChunkAlignment);
+			}
+			return offset;
+		};
+
+		uint32 rowSize = static_cast<uint32>(sizeof(uint32));
+		for (const ComponentTypeInfo* const type : m_Types)
+		{
+			rowSize += type->m_Size;
+		}
+
+		m_ChunkCapacity = std::max(1u, s_ChunkSize / rowSize);
+		while (m_ChunkCapacity > 1 && computeLayout(m_ChunkCapacity) > s_ChunkSize)
+		{
+			--m_ChunkCapacity;
+		}
+
+		// Components larger than a chunk still get one row per chunk
+		m_ChunkBytes = std::max(s_ChunkSize, computeLayout(m_ChunkCapacity));
+	}
+
+	uint32 Archetype::AddRow(const uint32 _entityId)
+	{
+		const uint32 row = m_EntityCount;
+		if (row / m_ChunkCapacity >= m_Chunks.size())
+		{
+			m_Chunks.push_back(AllocateChunk());
+		}
+
+		uint32* const entities = reinterpret_cast<uint32*>(m_Chunks[row / m_ChunkCapacity]);
+		entities[row % m_ChunkCapacity] = _entityId;
+		++m_EntityCount;
+		++m_RowVersion;
+
+		return row;
+	}
+
+	uint32 Archetype::AddRows(const uint32* const _entityIds, const uint32 _count)
+	{
+		const uint32 firstRow = m_EntityCount;
+		const uint32 requiredChunks = (firstRow + _count + m_ChunkCapacity - 1) / m_ChunkCapacity;
+		while (m_Chunks.size() < requiredChunks)
+		{
+			m_Chunks.push_back(AllocateChunk());
+		}
+
+		// Entity ids are copied one chunk segment at a time
+		uint32 copied{ 0 };
+		while (copied < _count)
+		{
+			const uint32 row = firstRow + copied;
+			const uint32 rowInChunk = row % m_ChunkCapacity;
+			const uint32 segment = std::min(_count - copied, m_ChunkCapacity - rowInChunk);
+			uint32* const entities = reinterpret_cast<uint32*>(m_Chunks[row / m_ChunkCapacity]);
+			std::copy_n(_entityIds + copied, segment, entities + rowInChunk);
+			copied += segment;
+		}
+
+		m_EntityCount += _count;
+		++m_RowVersion;
+		return firstRow;
+	}
+
+	uint32 Archetype::RemoveRow(const uint32 _row)
+	{
+		assert(_row < m_EntityCount);
+
+		const uint32 lastRow = m_EntityCount - 1;
+		uint32 movedEntityId = s_InvalidRow;
+
+		for (size_t column = 0; column < m_Types.size(); ++column)
+		{
+			void* const component = GetComponent(static_cast<int32>(column), _row);
+			m_Types[column]->m_Destroy(component);
+
+			if (_row != lastRow)
+			{
+				void* const lastComponent = GetComponent(static_cast<int32>(column), lastRow);
+				m_Types[column]->m_MoveConstruct(component, lastComponent);
+				m_Types[column]->m_Destroy(lastComponent);
+			}
+		}
+
+		if (_row != lastRow)
+		{
+			movedEntityId = GetChunkEntities(lastRow / m_ChunkCapacity)[lastRow % m_ChunkCapacity];
+			reinterpret_cast<uint32*>(m_Chunks[_row / m_ChunkCapacity])[_row % m_ChunkCapacity] = movedEntityId;
+		}
+
+		--m_EntityCount;
+		++m_RowVersion;
+
+		const uint32 usedChunks = (m_EntityCount + m_ChunkCapacity - 1) / m_ChunkCapacity;
+		while (m_Chunks.size() > usedChunks + 1)
+		{
+			FreeChunk(m_Chunks.back());
+			m_Chunks.pop_back();
+		}
+
+		return movedEntityId;
+	}
+
+	uint8* Archetype::AllocateChunk()
+	{
+		// Rows too large for a pooled block get a dedicated allocation
+		if (m_ChunkBytes > m_ChunkPool.GetBlockSize())
+		{
+			return static_cast<uint8*>(_aligned_malloc(m_ChunkBytes, s_ChunkAlignment));
+		}
+
+		return m_ChunkPool.Allocate();
+	}
+
+	void Archetype::FreeChunk(uint8* const _chunk) noexcept
+	{
+		if (m_ChunkBytes > m_ChunkPool.GetBlockSize())
+		{
+			_aligned_free(_chunk);
+			return;
+		}
+
+		m_ChunkPool.Free(_chunk);
+	}
+} // End of Banshee namespace
\ No newline at end of file
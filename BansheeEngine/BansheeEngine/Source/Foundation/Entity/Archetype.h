@@ -0,0 +1,80 @@
+#pragma once
+
+#include "ComponentTypeInfo.h"
+#include "ChunkPool.h"
+#include "Foundation/DLLConfig.h"
+#include <vector>
+#include <array>
+#include <algorithm>
+
+namespace Banshee
+{
+	// An archetype owns every entity that has exactly the same set of component types.
+	// Components are stored in fixed-size chunks as one contiguous array per type (SoA), so iterating a component type is a linear walk over memory.
+	// Rows are addressed globally (chunk * capacity + row in chunk) and removed with swap-remove to keep every chunk but the last one full.
+	// Chunks come from a shared ChunkPool and are handed back once the archetype shrinks, keeping one spare to avoid thrashing at a chunk boundary
+	class Archetype
+	{
+	public:
+		static constexpr uint32 s_ChunkSize{ 16 * 1024 };
+		static constexpr uint32 s_ChunkAlignment{ 64 };
+		static constexpr uint32 s_InvalidRow{ UINT32_MAX };
+
+		BANSHEE_ENGINE Archetype(const std::vector<const ComponentTypeInfo*>& _types, ChunkPool& _chunkPool);
+		BANSHEE_ENGINE ~Archetype();
+
+		// Reserves a row for the entity. The component memory of the row is left uninitialized and must be constructed by the caller
+		BANSHEE_ENGINE uint32 AddRow(const uint32 _entityId);
+		// Reserves _count consecutive rows at once and returns the first one. Component memory is left uninitialized as with AddRow
+		BANSHEE_ENGINE uint32 AddRows(const uint32* const _entityIds, const uint32 _count);
+		// Destroys the components of the row and fills the gap with the last row. Returns the id of the entity moved into the row, or s_InvalidRow
+		BANSHEE_ENGINE uint32 RemoveRow(const uint32 _row);
+
+		// Column lookups are a direct index by compile-time component type id
+		int32 GetColumnIndex(const uint32 _typeId) const noexcept { return m_ColumnLookup[_typeId]; }
+		bool HasComponents(const ComponentMask _mask) const noexcept { return (m_Mask & _mask) == _mask; }
+		Archetype* GetAddEdge(const uint32 _typeId) const noexcept { return m_AddEdges[_typeId]; }
+		void SetAddEdge(const uint32 _typeId, Archetype* const _archetype) noexcept { m_AddEdges[_typeId] = _archetype; }
+		Archetype* GetRemoveEdge(const uint32 _typeId) const noexcept { return m_RemoveEdges[_typeId]; }
+		void SetRemoveEdge(const uint32 _typeId, Archetype* const _archetype) noexcept { m_RemoveEdges[_typeId] = _archetype; }
+
+		const std::vector<const ComponentTypeInfo*>& GetTypes() const noexcept { return m_Types; }
+		ComponentMask GetMask() const noexcept { return m_Mask; }
+		uint32 GetEntityCount() const noexcept { return m_EntityCount; }
+		// Incremented whenever rows are added or removed. Component addresses cached from the archetype stay valid until it changes
+		uint32 GetRowVersion() const noexcept { return m_RowVersion; }
+		uint32 GetChunkCapacity() const noexcept { return m_ChunkCapacity; }
+		uint32 GetChunkCount() const noexcept { return (m_EntityCount + m_ChunkCapacity - 1) / m_ChunkCapacity; }
+		uint32 GetChunkEntityCount(const uint32 _chunk) const noexcept { return std::min(m_ChunkCapacity, m_EntityCount - _chunk * m_ChunkCapacity); }
+		const uint32* GetChunkEntities(const uint32 _chunk) const noexcept { return reinterpret_cast<const uint32*>(m_Chunks[_chunk]); }
+		void* GetChunkColumn(const uint32 _chunk, const int32 _column) const noexcept { return m_Chunks[_chunk] + m_ColumnOffsets[_column]; }
+		void* GetComponent(const int32 _column, const uint32 _row) const noexcept
+		{
+			return m_Chunks[_row / m_ChunkCapacity] + m_ColumnOffsets[_column] + static_cast<uint64>(_row % m_ChunkCapacity) * m_Types[_column]->m_Size;
+		}
+
+		Archetype(const Archetype&) = delete;
+		Archetype& operator=(const Archetype&) = delete;
+		Archetype(Archetype&&) = delete;
+		Archetype& operator=(Archetype&&) = delete;
+
+	private:
+		void ComputeChunkLayout();
+		uint8* AllocateChunk();
+		void FreeChunk(uint8* const _chunk) noexcept;
+
+	private:
+		std::vector<const ComponentTypeInfo*> m_Types;
+		std::vector<uint32> m_ColumnOffsets;
+		std::vector<uint8*> m_Chunks;
+		ChunkPool& m_ChunkPool;
+		std::array<int8, g_MaxComponentTypes> m_ColumnLookup;
+		std::array<Archetype*, g_MaxComponentTypes> m_AddEdges;
+		std::array<Archetype*, g_MaxComponentTypes> m_RemoveEdges;
+		ComponentMask m_Mask;
+		uint32 m_ChunkBytes;
+		uint32 m_ChunkCapacity;
+		uint32 m_EntityCount;
+		uint32 m_RowVersion;
+	};
+} // End of Banshee namespace
\ No newline at end of file
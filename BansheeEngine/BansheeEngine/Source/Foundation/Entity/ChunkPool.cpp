@@ -0,0 +1,64 @@
+#include "ChunkPool.h"
+#include <malloc.h>
+#include <stdexcept>
+
+namespace Banshee
+{
+	ChunkPool::ChunkPool(const uint32 _blockSize, const uint32 _blockAlignment, const uint32 _blocksPerSlab) noexcept :
+		m_Slabs{},
+		m_FreeList{ nullptr },
+		m_BlockSize{ _blockSize },
+		m_BlockAlignment{ _blockAlignment },
+		m_BlocksPerSlab{ _blocksPerSlab },
+		m_UsedBlockCount{ 0 }
+	{}
+
+	ChunkPool::~ChunkPool()
+	{
+		for (uint8* const slab : m_Slabs)
+		{
+			_aligned_free(slab);
+		}
+	}
+
+	uint8* ChunkPool::Allocate()
+	{
+		if (!m_FreeList)
+		{
+			AllocateSlab();
+		}
+
+		FreeBlock* const block = m_FreeList;
+		m_FreeList = block->m_Next;
+		++m_UsedBlockCount;
+
+		return reinterpret_cast<uint8*>(block);
+	}
+
+	void ChunkPool::Free(uint8* const _block) noexcept
+	{
+		FreeBlock* const block = reinterpret_cast<FreeBlock*>(_block);
+		block->m_Next = m_FreeList;
+		m_FreeList = block;
+		--m_UsedBlockCount;
+	}
+
+	void ChunkPool::AllocateSlab()
+	{
+		uint8* const slab = static_cast<uint8*>(_aligned_malloc(static_cast<uint64>(m_BlockSize) * m_BlocksPerSlab, m_BlockAlignment));
+		if (!slab)
+		{
+			throw std::runtime_error("ERROR: Failed to allocate chunk pool slab");
+		}
+
+		m_Slabs.push_back(slab);
+
+		// Thread the new blocks onto the free list in address order so consecutive allocations are adjacent in memory
+		for (uint32 i = m_BlocksPerSlab; i > 0; --i)
+		{
+			FreeBlock* const block = reinterpret_cast<FreeBlock*>(slab + static_cast<uint64>(i - 1) * m_BlockSize);
+			block->m_Next = m_FreeList;
+			m_FreeList = block;
+		}
+	}
+} // End of Banshee namespace
\ No newline at end of file
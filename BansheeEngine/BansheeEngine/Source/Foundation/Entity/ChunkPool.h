@@ -0,0 +1,45 @@
+#pragma once
+
+#include "Foundation/Platform.h"
+#include <vector>
+
+namespace Banshee
+{
+	// Fixed-block allocator for archetype chunks. Blocks are carved out of large slabs and recycled through an intrusive free list,
+	// so creating and destroying entities does not go to the heap once the pool is warm and every archetype draws from the same memory.
+	// Not thread-safe: chunks are only allocated and freed while entities are added or removed, which happens on the main thread
+	class ChunkPool
+	{
+	public:
+		ChunkPool(const uint32 _blockSize, const uint32 _blockAlignment, const uint32 _blocksPerSlab) noexcept;
+		~ChunkPool();
+
+		uint8* Allocate();
+		void Free(uint8* const _block) noexcept;
+
+		uint32 GetBlockSize() const noexcept { return m_BlockSize; }
+		uint32 GetUsedBlockCount() const noexcept { return m_UsedBlockCount; }
+		uint64 GetReservedBytes() const noexcept { return static_cast<uint64>(m_Slabs.size()) * m_BlockSize * m_BlocksPerSlab; }
+
+		ChunkPool(const ChunkPool&) = delete;
+		ChunkPool& operator=(const ChunkPool&) = delete;
+		ChunkPool(ChunkPool&&) = delete;
+		ChunkPool& operator=(ChunkPool&&) = delete;
+
+	private:
+		struct FreeBlock
+		{
+			FreeBlock* m_Next;
+		};
+
+		void AllocateSlab();
+
+	private:
+		std::vector<uint8*> m_Slabs;
+		FreeBlock* m_FreeList;
+		uint32 m_BlockSize;
+		uint32 m_BlockAlignment;
+		uint32 m_BlocksPerSlab;
+		uint32 m_UsedBlockCount;
+	};
+} // End of Banshee namespace
\ No newline at end of file
@@ -0,0 +1,72 @@
+#pragma once
+
+#include "Foundation/Components/ComponentType.h"
+#include "Foundation/Serialization/SnapshotStream.h"
+#include "Entity.h"
+#include <utility>
+#include <new>
+
+namespace Banshee
+{
+	// Components that are not trivially copyable can still be saved in a scene snapshot by providing
+	// 'void Save(SnapshotWriter&) const' and a constructor taking a SnapshotReader&
+	template<typename T>
+	concept IsSnapshotSerializable = requires(const T& _component, SnapshotWriter& _writer, SnapshotReader& _reader)
+	{
+		_component.Save(_writer);
+		T(_reader);
+	};
+
+	// Type-erased description of a component type, used by archetypes to move and destroy components stored in raw chunk memory
+	struct ComponentTypeInfo
+	{
+		uint32 m_TypeId;
+		uint32 m_Size;
+		uint32 m_Alignment;
+		void(*m_MoveConstruct)(void* const _dst, void* const _src);
+		void(*m_Destroy)(void* const _component);
+		// Snapshot support. Trivially copyable components are saved as raw column bytes, the others through m_Save and m_Load.
+		// Types with neither are left out of snapshots
+		bool m_TriviallyCopyable;
+		void(*m_Save)(const void* const _component, SnapshotWriter& _writer);
+		void(*m_Load)(void* const _dst, SnapshotReader& _reader, const Entity _owner);
+	};
+
+	template<typename T>
+	const ComponentTypeInfo& GetComponentTypeInfo() noexcept
+	{
+		static const ComponentTypeInfo typeInfo
+		{
+			GetComponentTypeId<T>(),
+			static_cast<uint32>(sizeof(T)),
+			static_cast<uint32>(alignof(T)),
+			[](void* const _dst, void* const _src) { new (_dst) T(std::move(*static_cast<T*>(_src))); },
+			[](void* const _component) { static_cast<T*>(_component)->~T(); },
+			std::is_trivially_copyable_v<T>,
+			[]() -> void(*)(const void* const, SnapshotWriter&)
+			{
+				if constexpr (IsSnapshotSerializable<T>)
+				{
+					return [](const void* const _component, SnapshotWriter& _writer) { static_cast<const T*>(_component)->Save(_writer); };
+				}
+				else
+				{
+					return nullptr;
+				}
+			}(),
+			[]() -> void(*)(void* const, SnapshotReader&, const Entity)
+			{
+				if constexpr (IsSnapshotSerializable<T>)
+				{
+					return [](void* const _dst, SnapshotReader& _reader, const Entity _owner) { new (_dst) T(_reader); static_cast<T*>(_dst)->SetOwner(_owner); };
+				}
+				else
+				{
+					return nullptr;
+				}
+			}()
+		};
+
+		return typeInfo;
+	}
+} // End of Banshee namespace
\ No newline at end of file
@@ -1,11 +1,16 @@
 #include "Entity.h"
-#include "Foundation/Components/Component.h"
+#include "EntityManager.h"
+#include "Graphics/Components/TransformComponent.h"
 
 namespace Banshee
 {
-	Entity::Entity(const uint32 _id) noexcept :
-		m_Id{ _id },
-		m_Components{},
-		m_TransformComponent{}
-	{}
+	bool Entity::IsAlive() const noexcept
+	{
+		return EntityManager::IsAlive(*this);
+	}
+
+	TransformComponent* Entity::GetTransform() const noexcept
+	{
+		return EntityManager::GetComponent<TransformComponent>(*this);
+	}
 } // End of Banshee namespace
\ No newline at end of file
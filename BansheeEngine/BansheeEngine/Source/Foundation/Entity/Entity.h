@@ -2,8 +2,7 @@
 
 #include "Foundation/DLLConfig.h"
 #include "Foundation/Platform.h"
-#include <vector>
-#include <memory>
+#include "Foundation/Components/ComponentType.h"
 #include <concepts>
 
 namespace Banshee
@@ -12,62 +11,66 @@ namespace Banshee
 	class TransformComponent;
 
 	template<typename T>
-	concept IsComponent = std::is_base_of<Component, T>::value;
+	concept IsComponent = std::is_base_of<Component, T>::value && requires
+	{
+		{ T::s_ComponentType } -> std::convertible_to<ComponentType>;
+	};
 
-	class Entity : public std::enable_shared_from_this<Entity>
+	// Lightweight 32-bit handle to an entity whose components live in the EntityManager's archetype storage.
+	// The low 24 bits index the entity table and the high 8 bits hold the generation of that slot, so handles to destroyed entities are detected as stale.
+	// The component templates are defined in EntityManager.h
+	class Entity
 	{
 	public:
-		BANSHEE_ENGINE explicit Entity(const uint32 _id) noexcept;
-		BANSHEE_ENGINE ~Entity() noexcept = default;
+		static constexpr uint32 s_IndexBits{ 24 };
+		static constexpr uint32 s_IndexMask{ (1u << s_IndexBits) - 1 };
+		static constexpr uint32 s_InvalidId{ UINT32_MAX };
+
+		constexpr Entity() noexcept :
+			m_Id{ s_InvalidId }
+		{}
+
+		constexpr explicit Entity(const uint32 _id) noexcept :
+			m_Id{ _id }
+		{}
+
+		constexpr Entity(const uint32 _index, const uint8 _generation) noexcept :
+			m_Id{ (static_cast<uint32>(_generation) << s_IndexBits) | (_index & s_IndexMask) }
+		{}
 
-		BANSHEE_ENGINE const uint32 GetUniqueId() const noexcept { return m_Id; }
+		uint32 GetUniqueId() const noexcept { return m_Id; }
+		uint32 GetIndex() const noexcept { return m_Id & s_IndexMask; }
+		uint8 GetGeneration() const noexcept { return static_cast<uint8>(m_Id >> s_IndexBits); }
+		bool IsValid() const noexcept { return m_Id != s_InvalidId; }
+		BANSHEE_ENGINE bool IsAlive() const noexcept;
 
+		// The returned pointer stays valid until a component is added to this entity or an entity sharing its archetype is removed
 		template<typename T, typename... Args>
 		requires IsComponent<T>
-		std::shared_ptr<T> AddComponent(Args&&... _args);
+		T* AddComponent(Args&&... _args) const;
 
 		template<typename T>
 		requires IsComponent<T>
-		std::shared_ptr<T> GetComponent() const noexcept;
+		void RemoveComponent() const;
 
-		const std::shared_ptr<TransformComponent>& GetTransform() const noexcept { return m_TransformComponent; }
+		template<typename T>
+		requires IsComponent<T>
+		T* GetComponent() const noexcept;
 
-	private:
-		uint32 m_Id;
-		std::vector<std::shared_ptr<Component>> m_Components;
-		std::shared_ptr<TransformComponent> m_TransformComponent;
-	};
+		template<typename T>
+		requires IsComponent<T>
+		bool HasComponent() const noexcept;
 
-	template<typename T, typename... Args>
-	requires IsComponent<T>
-	std::shared_ptr<T> Entity::AddComponent(Args&&... _args)
-	{
-		auto component = std::make_shared<T>(std::forward<Args>(_args)...);
-		component->SetOwner(shared_from_this());
-		m_Components.emplace_back(component);
+		template<typename... Ts>
+		requires (IsComponent<Ts> && ...)
+		bool HasComponents() const noexcept;
 
-		if (auto transform = std::dynamic_pointer_cast<TransformComponent>(component))
-		{
-			m_TransformComponent = transform;
-		}
+		BANSHEE_ENGINE TransformComponent* GetTransform() const noexcept;
 
-		return component;
-	}
+		bool operator==(const Entity& _other) const noexcept { return m_Id == _other.m_Id; }
+		bool operator!=(const Entity& _other) const noexcept { return m_Id != _other.m_Id; }
 
-	template<typename T>
-	requires IsComponent<T>
-	std::shared_ptr<T> Entity::GetComponent() const noexcept
-	{
-		static_assert(std::is_base_of<Component, T>::value, "T must derive from Component");
-
-		for (const auto& component : m_Components)
-		{
-			if (auto castedComponent = std::dynamic_pointer_cast<T>(component))
-			{
-				return castedComponent;
-			}
-		}
-
-		return nullptr;
-	}
+	private:
+		uint32 m_Id;
+	};
 } // End of Banshee namespace
\ No newline at end of file
@@ -1,19 +1,252 @@
 #include "EntityManager.h"
+#include "Foundation/Logging/Logger.h"
+#include "Foundation/Events/ComponentEvents.h"
+#include <algorithm>
+#include <bit>
+#include <stdexcept>
 
 namespace Banshee
 {
-    uint32 EntityManager::m_TotalEntities{ 0 };
-    std::vector<std::shared_ptr<Entity>> EntityManager::m_Entities{};
+    std::vector<EntityManager::EntityRecord> EntityManager::m_EntityRecords{};
+    std::deque<uint32> EntityManager::m_FreeIndices{};
+    uint32 EntityManager::m_AliveEntities{ 0 };
+    ChunkPool EntityManager::m_ChunkPool{ Archetype::s_ChunkSize, Archetype::s_ChunkAlignment, s_ChunksPerSlab };
+    std::vector<std::unique_ptr<Archetype>> EntityManager::m_Archetypes{};
+    std::unordered_map<ComponentMask, Archetype*> EntityManager::m_ArchetypeLookup{};
 
-    std::shared_ptr<Entity> EntityManager::CreateEntity()
+    Entity EntityManager::CreateEntity()
     {
-        auto entity = std::make_shared<Entity>(++m_TotalEntities);
-        m_Entities.push_back(entity);
+        uint32 index{ 0 };
+
+        if (m_FreeIndices.size() > s_MinFreeIndices)
+        {
+            index = m_FreeIndices.front();
+            m_FreeIndices.pop_front();
+        }
+        else
+        {
+            index = static_cast<uint32>(m_EntityRecords.size());
+            if (index >= Entity::s_IndexMask)
+            {
+                throw std::runtime_error("ERROR: Exceeded the maximum number of entities");
+            }
+
+            m_EntityRecords.push_back({ nullptr, 0, 0, 0 });
+        }
+
+        EntityRecord& record = m_EntityRecords[index];
+        const Entity entity{ index, record.m_Generation };
+        Archetype* const emptyArchetype = GetOrCreateArchetype({});
+        record.m_Archetype = emptyArchetype;
+        record.m_Row = emptyArchetype->AddRow(entity.GetUniqueId());
+        record.m_Mask = 0;
+        ++m_AliveEntities;
+
         return entity;
     }
 
-    const std::vector<std::shared_ptr<Entity>>& EntityManager::GetAllEntities() noexcept
+    void EntityManager::DestroyEntity(const Entity _entity)
+    {
+        EntityRecord* const record = GetRecord(_entity);
+        if (!record)
+        {
+            BE_LOG(LogCategory::Warning, "[ENTITY MANAGER]: Attempted to destroy a stale entity handle: %u", _entity.GetUniqueId());
+            return;
+        }
+
+        EmitComponentEvents(_entity, 0, record->m_Mask);
+
+        const uint32 movedEntityId = record->m_Archetype->RemoveRow(record->m_Row);
+        if (movedEntityId != Archetype::s_InvalidRow)
+        {
+            m_EntityRecords[Entity(movedEntityId).GetIndex()].m_Row = record->m_Row;
+        }
+
+        record->m_Archetype = nullptr;
+        record->m_Row = 0;
+        record->m_Mask = 0;
+        ++record->m_Generation;
+        m_FreeIndices.push_back(_entity.GetIndex());
+        --m_AliveEntities;
+    }
+
+    bool EntityManager::IsAlive(const Entity _entity) noexcept
+    {
+        return GetRecord(_entity) != nullptr;
+    }
+
+    uint32 EntityManager::GetEntityCount() noexcept
+    {
+        return m_AliveEntities;
+    }
+
+    const std::vector<std::unique_ptr<Archetype>>& EntityManager::GetArchetypes() noexcept
+    {
+        return m_Archetypes;
+    }
+
+    void* EntityManager::AddComponentData(const Entity _entity, const ComponentTypeInfo& _typeInfo, void* const _component)
+    {
+        EntityRecord* const liveRecord = GetRecord(_entity);
+        if (!liveRecord)
+        {
+            throw std::runtime_error("ERROR: Attempted to add a component to a stale entity");
+        }
+
+        EntityRecord& record = *liveRecord;
+        Archetype* const srcArchetype = record.m_Archetype;
+
+        const ComponentMask typeBit = ComponentMask{ 1 } << _typeInfo.m_TypeId;
+
+        // Replace the existing component in place if the entity already has one of this type
+        const int32 existingColumn = srcArchetype->GetColumnIndex(_typeInfo.m_TypeId);
+        if (existingColumn >= 0)
+        {
+            void* const existingComponent = srcArchetype->GetComponent(existingColumn, record.m_Row);
+            _typeInfo.m_Destroy(existingComponent);
+            _typeInfo.m_MoveConstruct(existingComponent, _component);
+            EmitComponentEvents(_entity, typeBit, typeBit);
+            return existingComponent;
+        }
+
+        Archetype* dstArchetype = srcArchetype->GetAddEdge(_typeInfo.m_TypeId);
+        if (!dstArchetype)
+        {
+            std::vector<const ComponentTypeInfo*> types = srcArchetype->GetTypes();
+            types.push_back(&_typeInfo);
+            dstArchetype = GetOrCreateArchetype(types);
+            srcArchetype->SetAddEdge(_typeInfo.m_TypeId, dstArchetype);
+        }
+
+        MoveEntity(_entity, record, dstArchetype);
+
+        void* const newComponent = dstArchetype->GetComponent(dstArchetype->GetColumnIndex(_typeInfo.m_TypeId), record.m_Row);
+        _typeInfo.m_MoveConstruct(newComponent, _component);
+        EmitComponentEvents(_entity, typeBit, 0);
+
+        return newComponent;
+    }
+
+    void EntityManager::RemoveComponentData(const Entity _entity, const uint32 _typeId)
     {
-        return m_Entities;
+        EntityRecord* const record = GetRecord(_entity);
+        if (!record || (record->m_Mask & (ComponentMask{ 1 } << _typeId)) == 0)
+        {
+            return;
+        }
+
+        Archetype* const srcArchetype = record->m_Archetype;
+        Archetype* dstArchetype = srcArchetype->GetRemoveEdge(_typeId);
+        if (!dstArchetype)
+        {
+            std::vector<const ComponentTypeInfo*> types = srcArchetype->GetTypes();
+            std::erase_if(types, [_typeId](const ComponentTypeInfo* const _type) noexcept { return _type->m_TypeId == _typeId; });
+            dstArchetype = GetOrCreateArchetype(types);
+            srcArchetype->SetRemoveEdge(_typeId, dstArchetype);
+        }
+
+        // The removed component is destroyed along with the rest of the source row
+        MoveEntity(_entity, *record, dstArchetype);
+        EmitComponentEvents(_entity, 0, ComponentMask{ 1 } << _typeId);
+    }
+
+    void* EntityManager::GetComponentData(const Entity _entity, const uint32 _typeId) noexcept
+    {
+        const EntityRecord* const record = GetRecord(_entity);
+        if (!record || (record->m_Mask & (ComponentMask{ 1 } << _typeId)) == 0)
+        {
+            return nullptr;
+        }
+
+        return record->m_Archetype->GetComponent(record->m_Archetype->GetColumnIndex(_typeId), record->m_Row);
+    }
+
+    ComponentMask EntityManager::GetComponentMask(const Entity _entity) noexcept
+    {
+        const EntityRecord* const record = GetRecord(_entity);
+        return record ? record->m_Mask : 0;
+    }
+
+    EntityManager::EntityRecord* EntityManager::GetRecord(const Entity _entity) noexcept
+    {
+        const uint32 index = _entity.GetIndex();
+        if (!_entity.IsValid() || index >= m_EntityRecords.size())
+        {
+            return nullptr;
+        }
+
+        EntityRecord& record = m_EntityRecords[index];
+        return record.m_Archetype && record.m_Generation == _entity.GetGeneration() ? &record : nullptr;
+    }
+
+    void EntityManager::MoveEntity(const Entity _entity, EntityRecord& _record, Archetype* const _dstArchetype)
+    {
+        // Move the components both archetypes share, then compact the source. Components only the destination has are left for the caller to construct
+        Archetype* const srcArchetype = _record.m_Archetype;
+        const uint32 dstRow = _dstArchetype->AddRow(_entity.GetUniqueId());
+        const auto& srcTypes = srcArchetype->GetTypes();
+
+        for (size_t column = 0; column < srcTypes.size(); ++column)
+        {
+            const int32 dstColumn = _dstArchetype->GetColumnIndex(srcTypes[column]->m_TypeId);
+            if (dstColumn >= 0)
+            {
+                srcTypes[column]->m_MoveConstruct(_dstArchetype->GetComponent(dstColumn, dstRow), srcArchetype->GetComponent(static_cast<int32>(column), _record.m_Row));
+            }
+        }
+
+        const uint32 movedEntityId = srcArchetype->RemoveRow(_record.m_Row);
+        if (movedEntityId != Archetype::s_InvalidRow)
+        {
+            m_EntityRecords[Entity(movedEntityId).GetIndex()].m_Row = _record.m_Row;
+        }
+
+        _record.m_Archetype = _dstArchetype;
+        _record.m_Row = dstRow;
+        _record.m_Mask = _dstArchetype->GetMask();
+    }
+
+    void EntityManager::EmitComponentEvents(const Entity _entity, const ComponentMask _added, const ComponentMask _removed)
+    {
+        ComponentMask removed = _removed;
+        while (removed != 0)
+        {
+            ComponentEvents::Emit(ComponentEvent::Removed, static_cast<uint32>(std::countr_zero(removed)), _entity);
+            removed &= removed - 1;
+        }
+
+        ComponentMask added = _added;
+        while (added != 0)
+        {
+            ComponentEvents::Emit(ComponentEvent::Added, static_cast<uint32>(std::countr_zero(added)), _entity);
+            added &= added - 1;
+        }
+    }
+
+    Archetype* EntityManager::GetOrCreateArchetype(const std::vector<const ComponentTypeInfo*>& _types)
+    {
+        // Archetypes are keyed by their component mask, so the order components were added in does not matter
+        ComponentMask mask{ 0 };
+        for (const ComponentTypeInfo* const type : _types)
+        {
+            mask |= ComponentMask{ 1 } << type->m_TypeId;
+        }
+
+        auto it = m_ArchetypeLookup.find(mask);
+        if (it != m_ArchetypeLookup.end())
+        {
+            return it->second;
+        }
+
+        // Columns are ordered by type id
+        std::vector<const ComponentTypeInfo*> sortedTypes = _types;
+        std::sort(sortedTypes.begin(), sortedTypes.end(), [](const ComponentTypeInfo* const _a, const ComponentTypeInfo* const _b) noexcept
+            {
+                return _a->m_TypeId < _b->m_TypeId;
+            });
+
+        Archetype* const archetype = m_Archetypes.emplace_back(std::make_unique<Archetype>(sortedTypes, m_ChunkPool)).get();
+        m_ArchetypeLookup.emplace(mask, archetype);
+        return archetype;
     }
 } // End of Banshee namespace
\ No newline at end of file
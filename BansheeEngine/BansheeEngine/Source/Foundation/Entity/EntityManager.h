@@ -1,17 +1,204 @@
 #pragma once
 
 #include "Entity.h"
+#include "Archetype.h"
+#include <array>
+#include <deque>
+#include <unordered_map>
+#include <memory>
+#include <tuple>
+#include <utility>
 
 namespace Banshee
 {
 	class EntityManager
 	{
     public:
-        BANSHEE_ENGINE static std::shared_ptr<Entity> CreateEntity();
-        BANSHEE_ENGINE static const std::vector<std::shared_ptr<Entity>>& GetAllEntities() noexcept;
+        BANSHEE_ENGINE static Entity CreateEntity();
+        // Destroys the entity and its components. Its index is recycled with a bumped generation so existing handles become stale
+        BANSHEE_ENGINE static void DestroyEntity(const Entity _entity);
+        BANSHEE_ENGINE static bool IsAlive(const Entity _entity) noexcept;
+        BANSHEE_ENGINE static uint32 GetEntityCount() noexcept;
+        BANSHEE_ENGINE static const std::vector<std::unique_ptr<Archetype>>& GetArchetypes() noexcept;
+
+        template<typename T, typename... Args>
+        requires IsComponent<T>
+        static T* AddComponent(const Entity _entity, Args&&... _args);
+
+        template<typename T>
+        requires IsComponent<T>
+        static void RemoveComponent(const Entity _entity);
+
+        template<typename T>
+        requires IsComponent<T>
+        static T* GetComponent(const Entity _entity) noexcept;
+
+        template<typename T>
+        requires IsComponent<T>
+        static bool HasComponent(const Entity _entity) noexcept;
+
+        template<typename... Ts>
+        requires (IsComponent<Ts> && ...)
+        static bool HasComponents(const Entity _entity) noexcept;
+
+        // Calls _func(Entity, Ts&...) for every entity that has all of the requested components, walking each matching archetype chunk by chunk.
+        // Adding components while iterating is not supported
+        template<typename... Ts, typename Func>
+        requires (IsComponent<Ts> && ...)
+        static void ForEach(Func&& _func);
+
+        // Calls _func(Entity, Ts&...) for every row of an archetype known to contain all of Ts
+        template<typename... Ts, typename Func>
+        requires (IsComponent<Ts> && ...)
+        static void ForEachInArchetype(const Archetype& _archetype, Func&& _func);
+
+        // Type-erased entry points used by the templates above. AddComponentData move-constructs _component into the entity's new archetype
+        BANSHEE_ENGINE static void* AddComponentData(const Entity _entity, const ComponentTypeInfo& _typeInfo, void* const _component);
+        BANSHEE_ENGINE static void RemoveComponentData(const Entity _entity, const uint32 _typeId);
+        BANSHEE_ENGINE static void* GetComponentData(const Entity _entity, const uint32 _typeId) noexcept;
+        BANSHEE_ENGINE static ComponentMask GetComponentMask(const Entity _entity) noexcept;
 
     private:
-        static uint32 m_TotalEntities;
-        static std::vector<std::shared_ptr<Entity>> m_Entities;
+        // Restores the entity table and archetype rows directly when loading a snapshot
+        friend class SceneSnapshot;
+
+        struct EntityRecord
+        {
+            Archetype* m_Archetype;     // Null while the slot is free
+            uint32 m_Row;
+            ComponentMask m_Mask;
+            uint8 m_Generation;
+        };
+
+        // Chunks are pooled in slabs of this many
+        static constexpr uint32 s_ChunksPerSlab{ 64 };
+        // Freed indices are only reused once this many are queued, which spreads generation increments out and makes 8-bit wrap-around unlikely
+        static constexpr uint32 s_MinFreeIndices{ 1024 };
+
+        static EntityRecord* GetRecord(const Entity _entity) noexcept;
+        static Archetype* GetOrCreateArchetype(const std::vector<const ComponentTypeInfo*>& _types);
+        static void MoveEntity(const Entity _entity, EntityRecord& _record, Archetype* const _dstArchetype);
+        // Emits ComponentEvent::Added and ComponentEvent::Removed for every type in the masks. Removal events refer to entities
+        // whose component is already gone, so subscribers must keep whatever state they need to release
+        static void EmitComponentEvents(const Entity _entity, const ComponentMask _added, const ComponentMask _removed);
+
+    private:
+        static std::vector<EntityRecord> m_EntityRecords;
+        static std::deque<uint32> m_FreeIndices;
+        static uint32 m_AliveEntities;
+        // Declared before the archetypes so it outlives them during static destruction
+        static ChunkPool m_ChunkPool;
+        static std::vector<std::unique_ptr<Archetype>> m_Archetypes;
+        static std::unordered_map<ComponentMask, Archetype*> m_ArchetypeLookup;
 	};
+
+    template<typename T, typename... Args>
+    requires IsComponent<T>
+    T* EntityManager::AddComponent(const Entity _entity, Args&&... _args)
+    {
+        T component(std::forward<Args>(_args)...);
+        component.SetOwner(_entity);
+        return static_cast<T*>(AddComponentData(_entity, GetComponentTypeInfo<T>(), &component));
+    }
+
+    template<typename T>
+    requires IsComponent<T>
+    void EntityManager::RemoveComponent(const Entity _entity)
+    {
+        RemoveComponentData(_entity, GetComponentTypeId<T>());
+    }
+
+    template<typename T>
+    requires IsComponent<T>
+    T* EntityManager::GetComponent(const Entity _entity) noexcept
+    {
+        return static_cast<T*>(GetComponentData(_entity, GetComponentTypeId<T>()));
+    }
+
+    template<typename T>
+    requires IsComponent<T>
+    bool EntityManager::HasComponent(const Entity _entity) noexcept
+    {
+        return (GetComponentMask(_entity) & MakeComponentMask<T>()) != 0;
+    }
+
+    template<typename... Ts>
+    requires (IsComponent<Ts> && ...)
+    bool EntityManager::HasComponents(const Entity _entity) noexcept
+    {
+        constexpr ComponentMask mask{ MakeComponentMask<Ts...>() };
+        return (GetComponentMask(_entity) & mask) == mask;
+    }
+
+    template<typename... Ts, typename Func>
+    requires (IsComponent<Ts> && ...)
+    void EntityManager::ForEach(Func&& _func)
+    {
+        constexpr ComponentMask mask{ MakeComponentMask<Ts...>() };
+
+        for (const auto& archetype : GetArchetypes())
+        {
+            if (archetype->GetEntityCount() > 0 && archetype->HasComponents(mask))
+            {
+                ForEachInArchetype<Ts...>(*archetype, _func);
+            }
+        }
+    }
+
+    template<typename... Ts, typename Func>
+    requires (IsComponent<Ts> && ...)
+    void EntityManager::ForEachInArchetype(const Archetype& _archetype, Func&& _func)
+    {
+        const std::array<int32, sizeof...(Ts)> columns{ _archetype.GetColumnIndex(GetComponentTypeId<Ts>())... };
+
+        for (uint32 chunk = 0; chunk < _archetype.GetChunkCount(); ++chunk)
+        {
+            const uint32 count = _archetype.GetChunkEntityCount(chunk);
+            const uint32* const entities = _archetype.GetChunkEntities(chunk);
+
+            [&]<size_t... Is>(std::index_sequence<Is...>)
+            {
+                const std::tuple<Ts*...> componentArrays{ static_cast<Ts*>(_archetype.GetChunkColumn(chunk, columns[Is]))... };
+                for (uint32 i = 0; i < count; ++i)
+                {
+                    _func(Entity{ entities[i] }, std::get<Is>(componentArrays)[i]...);
+                }
+            }(std::index_sequence_for<Ts...>{});
+        }
+    }
+
+    template<typename T, typename... Args>
+    requires IsComponent<T>
+    T* Entity::AddComponent(Args&&... _args) const
+    {
+        return EntityManager::AddComponent<T>(*this, std::forward<Args>(_args)...);
+    }
+
+    template<typename T>
+    requires IsComponent<T>
+    void Entity::RemoveComponent() const
+    {
+        EntityManager::RemoveComponent<T>(*this);
+    }
+
+    template<typename T>
+    requires IsComponent<T>
+    T* Entity::GetComponent() const noexcept
+    {
+        return EntityManager::GetComponent<T>(*this);
+    }
+
+    template<typename T>
+    requires IsComponent<T>
+    bool Entity::HasComponent() const noexcept
+    {
+        return EntityManager::HasComponent<T>(*this);
+    }
+
+    template<typename... Ts>
+    requires (IsComponent<Ts> && ...)
+    bool Entity::HasComponents() const noexcept
+    {
+        return EntityManager::HasComponents<Ts...>(*this);
+    }
 } // End of Banshee namespace
\ No newline at end of file
@@ -0,0 +1,75 @@
+#pragma once
+
+#include "EntityManager.h"
+
+namespace Banshee
+{
+	// Cached query over every entity that has all of Ts.
+	// The view remembers which archetypes match and only inspects archetypes created since its last use, so iterating
+	// costs the matching entities rather than a scan of the whole world. Entities moving between archetypes are picked
+	// up automatically because membership is tracked per archetype.
+	template<typename... Ts>
+	requires (IsComponent<Ts> && ...)
+	class View
+	{
+	public:
+		View() noexcept :
+			m_MatchingArchetypes{},
+			m_CheckedArchetypeCount{ 0 }
+		{}
+
+		template<typename Func>
+		void ForEach(Func&& _func)
+		{
+			Refresh();
+
+			for (const Archetype* const archetype : m_MatchingArchetypes)
+			{
+				if (archetype->GetEntityCount() > 0)
+				{
+					EntityManager::ForEachInArchetype<Ts...>(*archetype, _func);
+				}
+			}
+		}
+
+		uint32 GetEntityCount()
+		{
+			Refresh();
+
+			uint32 count{ 0 };
+			for (const Archetype* const archetype : m_MatchingArchetypes)
+			{
+				count += archetype->GetEntityCount();
+			}
+
+			return count;
+		}
+
+		const std::vector<Archetype*>& GetArchetypes()
+		{
+			Refresh();
+			return m_MatchingArchetypes;
+		}
+
+	private:
+		void Refresh()
+		{
+			// Archetypes are never destroyed, so only the ones appended since the last refresh need checking
+			const auto& archetypes = EntityManager::GetArchetypes();
+			for (; m_CheckedArchetypeCount < archetypes.size(); ++m_CheckedArchetypeCount)
+			{
+				Archetype* const archetype = archetypes[m_CheckedArchetypeCount].get();
+				if (archetype->HasComponents(s_Mask))
+				{
+					m_MatchingArchetypes.push_back(archetype);
+				}
+			}
+		}
+
+	private:
+		static constexpr ComponentMask s_Mask{ MakeComponentMask<Ts...>() };
+
+		std::vector<Archetype*> m_MatchingArchetypes;
+		size_t m_CheckedArchetypeCount;
+	};
+} // End of Banshee namespace
\ No newline at end of file
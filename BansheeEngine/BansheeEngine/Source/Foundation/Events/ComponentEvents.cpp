@@ -0,0 +1,142 @@
+#include "ComponentEvents.h"
+#include <algorithm>
+
+namespace Banshee
+{
+	std::array<std::vector<Entity>, g_MaxComponentTypes * ComponentEvents::s_EventCount> ComponentEvents::m_Buffers{};
+	std::array<std::vector<ComponentEvents::Subscription>, g_MaxComponentTypes * ComponentEvents::s_EventCount> ComponentEvents::m_Subscriptions{};
+	std::array<ComponentMask, ComponentEvents::s_EventCount> ComponentEvents::m_SubscribedMasks{};
+	std::vector<Entity> ComponentEvents::m_FlushBuffer{};
+	uint32 ComponentEvents::m_NextSubscriptionId{ 1 };
+	std::array<ComponentEvents::PendingEvent, ComponentEvents::s_ConcurrentCapacity> ComponentEvents::m_ConcurrentEvents{};
+	std::atomic<uint32> ComponentEvents::m_ConcurrentEventCount{ 0 };
+	std::vector<ComponentEvents::PendingEvent> ComponentEvents::m_OverflowEvents{};
+	std::mutex ComponentEvents::m_OverflowMutex{};
+
+	void ComponentEvents::Emit(const ComponentEvent _event, const uint32 _typeId, const Entity _entity)
+	{
+		if (HasSubscribers(_event, _typeId))
+		{
+			m_Buffers[GetBufferIndex(_event, _typeId)].push_back(_entity);
+		}
+	}
+
+	void ComponentEvents::EmitConcurrent(const ComponentEvent _event, const uint32 _typeId, const Entity _entity)
+	{
+		// Subscriptions only change on the main thread between flushes, so reading the mask here does not race with writers
+		if (!HasSubscribers(_event, _typeId))
+		{
+			return;
+		}
+
+		const PendingEvent pendingEvent{ _entity.GetUniqueId(), static_cast<uint8>(_typeId), _event };
+		const uint32 slot = m_ConcurrentEventCount.fetch_add(1, std::memory_order_relaxed);
+
+		if (slot < s_ConcurrentCapacity)
+		{
+			m_ConcurrentEvents[slot] = pendingEvent;
+		}
+		else
+		{
+			std::lock_guard<std::mutex> lock(m_OverflowMutex);
+			m_OverflowEvents.push_back(pendingEvent);
+		}
+	}
+
+	uint32 ComponentEvents::Subscribe(const ComponentEvent _event, const uint32 _typeId, ComponentEventHandler _handler)
+	{
+		if (!_handler)
+		{
+			return s_InvalidSubscription;
+		}
+
+		const uint32 subscriptionId = m_NextSubscriptionId++;
+		m_Subscriptions[GetBufferIndex(_event, _typeId)].push_back({ subscriptionId, std::move(_handler) });
+		m_SubscribedMasks[static_cast<uint32>(_event)] |= ComponentMask{ 1 } << _typeId;
+
+		return subscriptionId;
+	}
+
+	void ComponentEvents::Unsubscribe(const uint32 _subscription)
+	{
+		for (uint32 bufferIndex = 0; bufferIndex < m_Subscriptions.size(); ++bufferIndex)
+		{
+			std::vector<Subscription>& subscriptions = m_Subscriptions[bufferIndex];
+			const size_t erased = std::erase_if(subscriptions, [_subscription](const Subscription& _other) noexcept { return _other.m_Id == _subscription; });
+
+			if (erased > 0)
+			{
+				if (subscriptions.empty())
+				{
+					const uint32 event = bufferIndex % s_EventCount;
+					const uint32 typeId = bufferIndex / s_EventCount;
+					m_SubscribedMasks[event] &= ~(ComponentMask{ 1 } << typeId);
+					m_Buffers[bufferIndex].clear();
+				}
+
+				return;
+			}
+		}
+	}
+
+	bool ComponentEvents::HasSubscribers(const ComponentEvent _event, const uint32 _typeId) noexcept
+	{
+		return (m_SubscribedMasks[static_cast<uint32>(_event)] & (ComponentMask{ 1 } << _typeId)) != 0;
+	}
+
+	void ComponentEvents::Flush()
+	{
+		DrainConcurrentEvents();
+
+		constexpr std::array<ComponentEvent, s_EventCount> deliveryOrder{ ComponentEvent::Removed, ComponentEvent::Added, ComponentEvent::Changed };
+
+		for (uint32 typeId = 0; typeId < g_MaxComponentTypes; ++typeId)
+		{
+			for (const ComponentEvent event : deliveryOrder)
+			{
+				const uint32 bufferIndex = GetBufferIndex(event, typeId);
+				if (m_Buffers[bufferIndex].empty())
+				{
+					continue;
+				}
+
+				// Handlers see a stable batch even if they emit new events of the same kind
+				m_FlushBuffer.swap(m_Buffers[bufferIndex]);
+
+				for (const Subscription& subscription : m_Subscriptions[bufferIndex])
+				{
+					subscription.m_Handler(m_FlushBuffer);
+				}
+
+				m_FlushBuffer.clear();
+				if (m_Buffers[bufferIndex].empty())
+				{
+					m_FlushBuffer.swap(m_Buffers[bufferIndex]);
+				}
+			}
+		}
+	}
+
+	void ComponentEvents::DrainConcurrentEvents()
+	{
+		const uint32 eventCount = std::min(m_ConcurrentEventCount.exchange(0, std::memory_order_acquire), s_ConcurrentCapacity);
+
+		const auto append = [](const PendingEvent& _pendingEvent)
+			{
+				Emit(_pendingEvent.m_Event, _pendingEvent.m_TypeId, Entity{ _pendingEvent.m_EntityId });
+			};
+
+		for (uint32 i = 0; i < eventCount; ++i)
+		{
+			append(m_ConcurrentEvents[i]);
+		}
+
+		std::lock_guard<std::mutex> lock(m_OverflowMutex);
+		for (const PendingEvent& pendingEvent : m_OverflowEvents)
+		{
+			append(pendingEvent);
+		}
+
+		m_OverflowEvents.clear();
+	}
+} // End of Banshee namespace
\ No newline at end of file
@@ -0,0 +1,113 @@
+#pragma once
+
+#include "Foundation/DLLConfig.h"
+#include "Foundation/Entity/Entity.h"
+#include "Foundation/Components/ComponentType.h"
+#include <array>
+#include <atomic>
+#include <functional>
+#include <mutex>
+#include <span>
+#include <vector>
+
+namespace Banshee
+{
+	enum class ComponentEvent : uint8
+	{
+		Added,
+		Removed,
+		Changed,
+		Count
+	};
+
+	typedef std::function<void(std::span<const Entity>)> ComponentEventHandler;
+
+	// Deferred component events. Events are recorded into one buffer per (event, component type) pair and handed to subscribers
+	// as a single batch per buffer when Flush runs once per frame, instead of calling every listener as each change happens.
+	// Events with no subscriber are dropped at the emit site
+	class ComponentEvents
+	{
+	public:
+		static constexpr uint32 s_InvalidSubscription{ 0 };
+
+		// Main thread only
+		template<typename T>
+		requires IsComponent<T>
+		static void Emit(const ComponentEvent _event, const Entity _entity);
+
+		// Safe to call from any thread while Flush is not running. Slots are reserved with a single atomic increment and only
+		// fall back to a lock once the fixed-size concurrent buffer is full
+		template<typename T>
+		requires IsComponent<T>
+		static void EmitConcurrent(const ComponentEvent _event, const Entity _entity);
+
+		// Returns an id that can be passed to Unsubscribe
+		template<typename T>
+		requires IsComponent<T>
+		static uint32 Subscribe(const ComponentEvent _event, ComponentEventHandler _handler);
+
+		BANSHEE_ENGINE static void Emit(const ComponentEvent _event, const uint32 _typeId, const Entity _entity);
+		BANSHEE_ENGINE static void EmitConcurrent(const ComponentEvent _event, const uint32 _typeId, const Entity _entity);
+		BANSHEE_ENGINE static uint32 Subscribe(const ComponentEvent _event, const uint32 _typeId, ComponentEventHandler _handler);
+		BANSHEE_ENGINE static void Unsubscribe(const uint32 _subscription);
+		BANSHEE_ENGINE static bool HasSubscribers(const ComponentEvent _event, const uint32 _typeId) noexcept;
+
+		// Delivers every pending event, grouped per component type with removals first, then additions, then changes.
+		// Must run on the main thread while no worker is emitting, and handlers must not subscribe or unsubscribe. An event a
+		// handler emits into the batch being delivered waits for the next flush. One for a later component type, or for a later
+		// event kind of the same type, is delivered in this flush
+		BANSHEE_ENGINE static void Flush();
+
+	private:
+		struct PendingEvent
+		{
+			uint32 m_EntityId;
+			uint8 m_TypeId;
+			ComponentEvent m_Event;
+		};
+
+		struct Subscription
+		{
+			uint32 m_Id;
+			ComponentEventHandler m_Handler;
+		};
+
+		static constexpr uint32 s_EventCount{ static_cast<uint32>(ComponentEvent::Count) };
+		static constexpr uint32 s_ConcurrentCapacity{ 16 * 1024 };
+
+		static uint32 GetBufferIndex(const ComponentEvent _event, const uint32 _typeId) noexcept { return _typeId * s_EventCount + static_cast<uint32>(_event); }
+		static void DrainConcurrentEvents();
+
+	private:
+		static std::array<std::vector<Entity>, g_MaxComponentTypes * s_EventCount> m_Buffers;
+		static std::array<std::vector<Subscription>, g_MaxComponentTypes * s_EventCount> m_Subscriptions;
+		static std::array<ComponentMask, s_EventCount> m_SubscribedMasks;
+		static std::vector<Entity> m_FlushBuffer;
+		static uint32 m_NextSubscriptionId;
+		static std::array<PendingEvent, s_ConcurrentCapacity> m_ConcurrentEvents;
+		static std::atomic<uint32> m_ConcurrentEventCount;
+		static std::vector<PendingEvent> m_OverflowEvents;
+		static std::mutex m_OverflowMutex;
+	};
+
+	template<typename T>
+	requires IsComponent<T>
+	void ComponentEvents::Emit(const ComponentEvent _event, const Entity _entity)
+	{
+		Emit(_event, GetComponentTypeId<T>(), _entity);
+	}
+
+	template<typename T>
+	requires IsComponent<T>
+	void ComponentEvents::EmitConcurrent(const ComponentEvent _event, const Entity _entity)
+	{
+		EmitConcurrent(_event, GetComponentTypeId<T>(), _entity);
+	}
+
+	template<typename T>
+	requires IsComponent<T>
+	uint32 ComponentEvents::Subscribe(const ComponentEvent _event, ComponentEventHandler _handler)
+	{
+		return Subscribe(_event, GetComponentTypeId<T>(), std::move(_handler));
+	}
+} // End of Banshee namespace
\ No newline at end of file
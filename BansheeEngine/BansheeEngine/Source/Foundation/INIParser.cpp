@@ -1,6 +1,7 @@
 #include "INIParser.h"
 #include "Foundation/ResourceManager/ResourceManager.h"
 #include "Foundation/Logging/Logger.h"
+#include <algorithm>
 
 namespace Banshee
 {
@@ -43,6 +44,34 @@ namespace Banshee
 			{
 				m_Config.m_WindowHeight = std::stoul(std::string(value));
 			}
+			else if (key == "Headless")
+			{
+				m_Config.m_Headless = std::stoul(std::string(value)) != 0;
+			}
+			else if (key == "FrameLimit")
+			{
+				m_Config.m_FrameLimit = std::stoul(std::string(value));
+			}
+			else if (key == "FramesInFlight")
+			{
+				m_Config.m_FramesInFlight = std::max(1ul, std::stoul(std::string(value)));
+			}
+			else if (key == "MaxInstances")
+			{
+				m_Config.m_MaxInstances = std::max(1ul, std::stoul(std::string(value)));
+			}
+			else if (key == "GpuDrivenRendering")
+			{
+				m_Config.m_GpuDrivenRendering = std::stoul(std::string(value)) != 0;
+			}
+			else if (key == "DepthPrepass")
+			{
+				m_Config.m_DepthPrepass = std::stoul(std::string(value)) != 0;
+			}
+			else if (key == "OcclusionCulling")
+			{
+				m_Config.m_OcclusionCulling = std::stoul(std::string(value)) != 0;
+			}
 		}
 
 		BE_LOG(LogCategory::Info, "[CONFIG]: Loaded config.ini");
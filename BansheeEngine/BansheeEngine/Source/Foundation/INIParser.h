@@ -8,6 +8,7 @@ namespace Banshee
 	{
 	public:
 		const EngineConfig& ParseConfigSettings(std::string_view _filePath);
+		const EngineConfig& GetConfigSettings() const noexcept { return m_Config; }
 
 	private:
 		EngineConfig m_Config{};
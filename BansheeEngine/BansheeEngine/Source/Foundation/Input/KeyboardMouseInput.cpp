@@ -45,21 +45,28 @@ namespace Banshee
 
 	bool KeyboardMouseInput::IsKeyPressed(const int32 _key) const noexcept
 	{
-		return glfwGetKey(m_Window, _key) == GLFW_PRESS;
+		return m_Window && glfwGetKey(m_Window, _key) == GLFW_PRESS;
 	}
 
 	bool KeyboardMouseInput::IsButtonPressed(const int32 _button) const noexcept
 	{
-		return glfwGetMouseButton(m_Window, _button) == GLFW_PRESS;
+		return m_Window && glfwGetMouseButton(m_Window, _button) == GLFW_PRESS;
 	}
 
 	void KeyboardMouseInput::GetCursorPosition(double& _x, double& _y) const noexcept
 	{
-		glfwGetCursorPos(m_Window, &_x, &_y);
+		// Headless runs have no window to read input from, so the cursor stays put
+		if (m_Window)
+		{
+			glfwGetCursorPos(m_Window, &_x, &_y);
+		}
 	}
 
 	void KeyboardMouseInput::LockCursor() noexcept
 	{
-		glfwSetInputMode(m_Window, GLFW_CURSOR, GLFW_CURSOR_DISABLED);
+		if (m_Window)
+		{
+			glfwSetInputMode(m_Window, GLFW_CURSOR, GLFW_CURSOR_DISABLED);
+		}
 	}
 } // End of Banshee namespace
\ No newline at end of file
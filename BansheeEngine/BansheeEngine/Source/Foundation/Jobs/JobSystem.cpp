@@ -0,0 +1,138 @@
+#include "JobSystem.h"
+#include "Foundation/Logging/Logger.h"
+#include <algorithm>
+
+namespace Banshee
+{
+	JobSystem::JobSystem(const uint32 _workerCount) :
+		m_Workers{},
+		m_Jobs{},
+		m_JobsMutex{},
+		m_JobAvailable{},
+		m_ShuttingDown{ false }
+	{
+		// Leave one hardware thread for the main thread, which also runs jobs while it waits
+		const uint32 hardwareThreads = std::max(2u, std::thread::hardware_concurrency());
+		const uint32 workerCount = _workerCount > 0 ? _workerCount : hardwareThreads - 1;
+
+		m_Workers.reserve(workerCount);
+		for (uint32 i = 0; i < workerCount; ++i)
+		{
+			m_Workers.emplace_back(&JobSystem::WorkerLoop, this);
+		}
+
+		BE_LOG(LogCategory::Trace, "[JOB SYSTEM]: Started %d worker threads", workerCount);
+	}
+
+	JobSystem::~JobSystem()
+	{
+		{
+			std::lock_guard<std::mutex> lock(m_JobsMutex);
+			m_ShuttingDown = true;
+		}
+
+		m_JobAvailable.notify_all();
+
+		for (auto& worker : m_Workers)
+		{
+			worker.join();
+		}
+	}
+
+	void JobSystem::Submit(std::function<void()> _job, std::atomic<uint32>* const _counter)
+	{
+		if (_counter)
+		{
+			_counter->fetch_add(1, std::memory_order_relaxed);
+		}
+
+		{
+			std::lock_guard<std::mutex> lock(m_JobsMutex);
+			m_Jobs.push_back({ std::move(_job), _counter });
+		}
+
+		m_JobAvailable.notify_one();
+	}
+
+	void JobSystem::Wait(const std::atomic<uint32>& _counter)
+	{
+		while (_counter.load(std::memory_order_acquire) > 0)
+		{
+			if (!TryRunJob())
+			{
+				std::this_thread::yield();
+			}
+		}
+	}
+
+	void JobSystem::ParallelFor(const uint32 _count, const uint32 _batchSize, const std::function<void(const uint32, const uint32)>& _func)
+	{
+		if (_count == 0)
+		{
+			return;
+		}
+
+		const uint32 batchSize = std::max(1u, _batchSize);
+		std::atomic<uint32> counter{ 0 };
+
+		for (uint32 begin = 0; begin < _count; begin += batchSize)
+		{
+			const uint32 end = std::min(_count, begin + batchSize);
+			Submit([&_func, begin, end]() { _func(begin, end); }, &counter);
+		}
+
+		Wait(counter);
+	}
+
+	void JobSystem::WorkerLoop()
+	{
+		while (true)
+		{
+			Job job{};
+
+			{
+				std::unique_lock<std::mutex> lock(m_JobsMutex);
+				m_JobAvailable.wait(lock, [this]() { return m_ShuttingDown || !m_Jobs.empty(); });
+
+				if (m_ShuttingDown && m_Jobs.empty())
+				{
+					return;
+				}
+
+				job = std::move(m_Jobs.front());
+				m_Jobs.pop_front();
+			}
+
+			RunJob(job);
+		}
+	}
+
+	bool JobSystem::TryRunJob()
+	{
+		Job job{};
+
+		{
+			std::lock_guard<std::mutex> lock(m_JobsMutex);
+			if (m_Jobs.empty())
+			{
+				return false;
+			}
+
+			job = std::move(m_Jobs.front());
+			m_Jobs.pop_front();
+		}
+
+		RunJob(job);
+		return true;
+	}
+
+	void JobSystem::RunJob(Job& _job)
+	{
+		_job.m_Function();
+
+		if (_job.m_Counter)
+		{
+			_job.m_Counter->fetch_sub(1, std::memory_order_release);
+		}
+	}
+} // End of Banshee namespace
\ No newline at end of file
@@ -0,0 +1,53 @@
+#pragma once
+
+#include "Foundation/DLLConfig.h"
+#include "Foundation/Platform.h"
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace Banshee
+{
+	// Fixed pool of worker threads pulling jobs from a shared queue.
+	// A job may be tied to a counter that is incremented on submission and decremented on completion, which Wait uses to join work.
+	class JobSystem
+	{
+	public:
+		BANSHEE_ENGINE explicit JobSystem(const uint32 _workerCount = 0);
+		BANSHEE_ENGINE ~JobSystem();
+
+		BANSHEE_ENGINE void Submit(std::function<void()> _job, std::atomic<uint32>* const _counter = nullptr);
+		// Executes queued jobs on the calling thread until the counter reaches zero
+		BANSHEE_ENGINE void Wait(const std::atomic<uint32>& _counter);
+		// Splits [0, _count) into batches of _batchSize and runs _func(begin, end) on them in parallel, returning once all batches are done
+		BANSHEE_ENGINE void ParallelFor(const uint32 _count, const uint32 _batchSize, const std::function<void(const uint32, const uint32)>& _func);
+		uint32 GetWorkerCount() const noexcept { return static_cast<uint32>(m_Workers.size()); }
+
+		JobSystem(const JobSystem&) = delete;
+		JobSystem& operator=(const JobSystem&) = delete;
+		JobSystem(JobSystem&&) = delete;
+		JobSystem& operator=(JobSystem&&) = delete;
+
+	private:
+		struct Job
+		{
+			std::function<void()> m_Function;
+			std::atomic<uint32>* m_Counter;
+		};
+
+		void WorkerLoop();
+		bool TryRunJob();
+		static void RunJob(Job& _job);
+
+	private:
+		std::vector<std::thread> m_Workers;
+		std::deque<Job> m_Jobs;
+		std::mutex m_JobsMutex;
+		std::condition_variable m_JobAvailable;
+		bool m_ShuttingDown;
+	};
+} // End of Banshee namespace
\ No newline at end of file
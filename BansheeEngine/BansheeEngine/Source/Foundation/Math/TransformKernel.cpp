@@ -0,0 +1,215 @@
+#include "TransformKernel.h"
+#include <glm/gtc/type_ptr.hpp>
+#include <immintrin.h>
+
+#if defined(_MSC_VER)
+	#include <intrin.h>
+	#define BE_TARGET_AVX
+#else
+	#define BE_TARGET_AVX __attribute__((target("avx")))
+#endif
+
+namespace Banshee
+{
+	namespace
+	{
+		void ComputeMatrixScalar(const TransformSoA& _transforms, const size_t _index, glm::mat4& _outMatrix) noexcept
+		{
+			const float qx = _transforms.m_RotationX[_index];
+			const float qy = _transforms.m_RotationY[_index];
+			const float qz = _transforms.m_RotationZ[_index];
+			const float qw = _transforms.m_RotationW[_index];
+			const float sx = _transforms.m_ScaleX[_index];
+			const float sy = _transforms.m_ScaleY[_index];
+			const float sz = _transforms.m_ScaleZ[_index];
+
+			const float xx = qx * qx, yy = qy * qy, zz = qz * qz;
+			const float xy = qx * qy, xz = qx * qz, yz = qy * qz;
+			const float wx = qw * qx, wy = qw * qy, wz = qw * qz;
+
+			_outMatrix[0] = glm::vec4((1.0f - 2.0f * (yy + zz)) * sx, 2.0f * (xy + wz) * sx, 2.0f * (xz - wy) * sx, 0.0f);
+			_outMatrix[1] = glm::vec4(2.0f * (xy - wz) * sy, (1.0f - 2.0f * (xx + zz)) * sy, 2.0f * (yz + wx) * sy, 0.0f);
+			_outMatrix[2] = glm::vec4(2.0f * (xz + wy) * sz, 2.0f * (yz - wx) * sz, (1.0f - 2.0f * (xx + yy)) * sz, 0.0f);
+			_outMatrix[3] = glm::vec4(_transforms.m_PositionX[_index], _transforms.m_PositionY[_index], _transforms.m_PositionZ[_index], 1.0f);
+		}
+
+		// Computes the 16 matrix terms of several transforms at once. _terms[column][row] holds that term for every transform in the batch
+		void ComputeMatrixTermsSSE(const TransformSoA& _transforms, const size_t _index, __m128 (&_terms)[4][4]) noexcept
+		{
+			const __m128 qx = _mm_loadu_ps(&_transforms.m_RotationX[_index]);
+			const __m128 qy = _mm_loadu_ps(&_transforms.m_RotationY[_index]);
+			const __m128 qz = _mm_loadu_ps(&_transforms.m_RotationZ[_index]);
+			const __m128 qw = _mm_loadu_ps(&_transforms.m_RotationW[_index]);
+			const __m128 sx = _mm_loadu_ps(&_transforms.m_ScaleX[_index]);
+			const __m128 sy = _mm_loadu_ps(&_transforms.m_ScaleY[_index]);
+			const __m128 sz = _mm_loadu_ps(&_transforms.m_ScaleZ[_index]);
+			const __m128 zero = _mm_setzero_ps();
+			const __m128 one = _mm_set1_ps(1.0f);
+			const __m128 two = _mm_set1_ps(2.0f);
+
+			const __m128 xx = _mm_mul_ps(qx, qx), yy = _mm_mul_ps(qy, qy), zz = _mm_mul_ps(qz, qz);
+			const __m128 xy = _mm_mul_ps(qx, qy), xz = _mm_mul_ps(qx, qz), yz = _mm_mul_ps(qy, qz);
+			const __m128 wx = _mm_mul_ps(qw, qx), wy = _mm_mul_ps(qw, qy), wz = _mm_mul_ps(qw, qz);
+
+			_terms[0][0] = _mm_mul_ps(_mm_sub_ps(one, _mm_mul_ps(two, _mm_add_ps(yy, zz))), sx);
+			_terms[0][1] = _mm_mul_ps(_mm_mul_ps(two, _mm_add_ps(xy, wz)), sx);
+			_terms[0][2] = _mm_mul_ps(_mm_mul_ps(two, _mm_sub_ps(xz, wy)), sx);
+			_terms[0][3] = zero;
+			_terms[1][0] = _mm_mul_ps(_mm_mul_ps(two, _mm_sub_ps(xy, wz)), sy);
+			_terms[1][1] = _mm_mul_ps(_mm_sub_ps(one, _mm_mul_ps(two, _mm_add_ps(xx, zz))), sy);
+			_terms[1][2] = _mm_mul_ps(_mm_mul_ps(two, _mm_add_ps(yz, wx)), sy);
+			_terms[1][3] = zero;
+			_terms[2][0] = _mm_mul_ps(_mm_mul_ps(two, _mm_add_ps(xz, wy)), sz);
+			_terms[2][1] = _mm_mul_ps(_mm_mul_ps(two, _mm_sub_ps(yz, wx)), sz);
+			_terms[2][2] = _mm_mul_ps(_mm_sub_ps(one, _mm_mul_ps(two, _mm_add_ps(xx, yy))), sz);
+			_terms[2][3] = zero;
+			_terms[3][0] = _mm_loadu_ps(&_transforms.m_PositionX[_index]);
+			_terms[3][1] = _mm_loadu_ps(&_transforms.m_PositionY[_index]);
+			_terms[3][2] = _mm_loadu_ps(&_transforms.m_PositionZ[_index]);
+			_terms[3][3] = one;
+		}
+
+		BE_TARGET_AVX void ComputeMatrixTermsAVX(const TransformSoA& _transforms, const size_t _index, __m256 (&_terms)[4][4]) noexcept
+		{
+			const __m256 qx = _mm256_loadu_ps(&_transforms.m_RotationX[_index]);
+			const __m256 qy = _mm256_loadu_ps(&_transforms.m_RotationY[_index]);
+			const __m256 qz = _mm256_loadu_ps(&_transforms.m_RotationZ[_index]);
+			const __m256 qw = _mm256_loadu_ps(&_transforms.m_RotationW[_index]);
+			const __m256 sx = _mm256_loadu_ps(&_transforms.m_ScaleX[_index]);
+			const __m256 sy = _mm256_loadu_ps(&_transforms.m_ScaleY[_index]);
+			const __m256 sz = _mm256_loadu_ps(&_transforms.m_ScaleZ[_index]);
+			const __m256 zero = _mm256_setzero_ps();
+			const __m256 one = _mm256_set1_ps(1.0f);
+			const __m256 two = _mm256_set1_ps(2.0f);
+
+			const __m256 xx = _mm256_mul_ps(qx, qx), yy = _mm256_mul_ps(qy, qy), zz = _mm256_mul_ps(qz, qz);
+			const __m256 xy = _mm256_mul_ps(qx, qy), xz = _mm256_mul_ps(qx, qz), yz = _mm256_mul_ps(qy, qz);
+			const __m256 wx = _mm256_mul_ps(qw, qx), wy = _mm256_mul_ps(qw, qy), wz = _mm256_mul_ps(qw, qz);
+
+			_terms[0][0] = _mm256_mul_ps(_mm256_sub_ps(one, _mm256_mul_ps(two, _mm256_add_ps(yy, zz))), sx);
+			_terms[0][1] = _mm256_mul_ps(_mm256_mul_ps(two, _mm256_add_ps(xy, wz)), sx);
+			_terms[0][2] = _mm256_mul_ps(_mm256_mul_ps(two, _mm256_sub_ps(xz, wy)), sx);
+			_terms[0][3] = zero;
+			_terms[1][0] = _mm256_mul_ps(_mm256_mul_ps(two, _mm256_sub_ps(xy, wz)), sy);
+			_terms[1][1] = _mm256_mul_ps(_mm256_sub_ps(one, _mm256_mul_ps(two, _mm256_add_ps(xx, zz))), sy);
+			_terms[1][2] = _mm256_mul_ps(_mm256_mul_ps(two, _mm256_add_ps(yz, wx)), sy);
+			_terms[1][3] = zero;
+			_terms[2][0] = _mm256_mul_ps(_mm256_mul_ps(two, _mm256_add_ps(xz, wy)), sz);
+			_terms[2][1] = _mm256_mul_ps(_mm256_mul_ps(two, _mm256_sub_ps(yz, wx)), sz);
+			_terms[2][2] = _mm256_mul_ps(_mm256_sub_ps(one, _mm256_mul_ps(two, _mm256_add_ps(xx, yy))), sz);
+			_terms[2][3] = zero;
+			_terms[3][0] = _mm256_loadu_ps(&_transforms.m_PositionX[_index]);
+			_terms[3][1] = _mm256_loadu_ps(&_transforms.m_PositionY[_index]);
+			_terms[3][2] = _mm256_loadu_ps(&_transforms.m_PositionZ[_index]);
+			_terms[3][3] = one;
+		}
+
+		BE_TARGET_AVX void ComputeMatricesAVXImpl(const TransformSoA& _transforms, glm::mat4* const _outMatrices) noexcept
+		{
+			const size_t count = _transforms.Size();
+			size_t i = 0;
+
+			for (; i + 8 <= count; i += 8)
+			{
+				__m256 terms[4][4];
+				ComputeMatrixTermsAVX(_transforms, i, terms);
+
+				// Transposing within each 128-bit lane yields one matrix column for transform k in the low half and for transform k + 4 in the high half
+				for (uint32 column = 0; column < 4; ++column)
+				{
+					const __m256 t0 = _mm256_unpacklo_ps(terms[column][0], terms[column][1]);
+					const __m256 t1 = _mm256_unpackhi_ps(terms[column][0], terms[column][1]);
+					const __m256 t2 = _mm256_unpacklo_ps(terms[column][2], terms[column][3]);
+					const __m256 t3 = _mm256_unpackhi_ps(terms[column][2], terms[column][3]);
+					const __m256 rows[4] =
+					{
+						_mm256_shuffle_ps(t0, t2, _MM_SHUFFLE(1, 0, 1, 0)),
+						_mm256_shuffle_ps(t0, t2, _MM_SHUFFLE(3, 2, 3, 2)),
+						_mm256_shuffle_ps(t1, t3, _MM_SHUFFLE(1, 0, 1, 0)),
+						_mm256_shuffle_ps(t1, t3, _MM_SHUFFLE(3, 2, 3, 2))
+					};
+
+					for (uint32 k = 0; k < 4; ++k)
+					{
+						_mm_storeu_ps(glm::value_ptr(_outMatrices[i + k]) + column * 4, _mm256_castps256_ps128(rows[k]));
+						_mm_storeu_ps(glm::value_ptr(_outMatrices[i + k + 4]) + column * 4, _mm256_extractf128_ps(rows[k], 1));
+					}
+				}
+			}
+
+			for (; i < count; ++i)
+			{
+				ComputeMatrixScalar(_transforms, i, _outMatrices[i]);
+			}
+		}
+	}
+
+	void TransformKernel::ComputeMatrices(const TransformSoA& _transforms, glm::mat4* const _outMatrices)
+	{
+		static const bool s_UseAVX{ IsAVXSupported() };
+
+		if (s_UseAVX)
+		{
+			ComputeMatricesAVX(_transforms, _outMatrices);
+		}
+		else
+		{
+			ComputeMatricesSSE(_transforms, _outMatrices);
+		}
+	}
+
+	void TransformKernel::ComputeMatricesScalar(const TransformSoA& _transforms, glm::mat4* const _outMatrices) noexcept
+	{
+		for (size_t i = 0; i < _transforms.Size(); ++i)
+		{
+			ComputeMatrixScalar(_transforms, i, _outMatrices[i]);
+		}
+	}
+
+	void TransformKernel::ComputeMatricesSSE(const TransformSoA& _transforms, glm::mat4* const _outMatrices) noexcept
+	{
+		const size_t count = _transforms.Size();
+		size_t i = 0;
+
+		for (; i + 4 <= count; i += 4)
+		{
+			__m128 terms[4][4];
+			ComputeMatrixTermsSSE(_transforms, i, terms);
+
+			for (uint32 column = 0; column < 4; ++column)
+			{
+				_MM_TRANSPOSE4_PS(terms[column][0], terms[column][1], terms[column][2], terms[column][3]);
+
+				for (uint32 k = 0; k < 4; ++k)
+				{
+					_mm_storeu_ps(glm::value_ptr(_outMatrices[i + k]) + column * 4, terms[column][k]);
+				}
+			}
+		}
+
+		for (; i < count; ++i)
+		{
+			ComputeMatrixScalar(_transforms, i, _outMatrices[i]);
+		}
+	}
+
+	void TransformKernel::ComputeMatricesAVX(const TransformSoA& _transforms, glm::mat4* const _outMatrices) noexcept
+	{
+		ComputeMatricesAVXImpl(_transforms, _outMatrices);
+	}
+
+	bool TransformKernel::IsAVXSupported() noexcept
+	{
+#if defined(_MSC_VER)
+		int32 cpuInfo[4]{};
+		__cpuid(cpuInfo, 1);
+
+		// AVX needs both CPU support and the OS saving the YMM registers on context switches
+		const bool osUsesXSave = (cpuInfo[2] & (1 << 27)) != 0;
+		const bool cpuHasAVX = (cpuInfo[2] & (1 << 28)) != 0;
+		return osUsesXSave && cpuHasAVX && (_xgetbv(0) & 0x6) == 0x6;
+#else
+		return __builtin_cpu_supports("avx");
+#endif
+	}
+} // End of Banshee namespace
\ No newline at end of file
@@ -0,0 +1,69 @@
+#pragma once
+
+#include "Foundation/DLLConfig.h"
+#include "Foundation/Platform.h"
+#include <glm/glm.hpp>
+#include <glm/gtc/quaternion.hpp>
+#include <vector>
+#include <array>
+
+namespace Banshee
+{
+	// Structure-of-arrays batch of translation, rotation and scale values, laid out so the SIMD kernels can load several transforms per instruction
+	struct TransformSoA
+	{
+		void Clear() noexcept
+		{
+			for (std::vector<float>* const stream : GetStreams())
+			{
+				stream->clear();
+			}
+		}
+
+		void Reserve(const size_t _count)
+		{
+			for (std::vector<float>* const stream : GetStreams())
+			{
+				stream->reserve(_count);
+			}
+		}
+
+		void Add(const glm::vec3& _position, const glm::quat& _rotation, const glm::vec3& _scale)
+		{
+			m_PositionX.push_back(_position.x);
+			m_PositionY.push_back(_position.y);
+			m_PositionZ.push_back(_position.z);
+			m_RotationX.push_back(_rotation.x);
+			m_RotationY.push_back(_rotation.y);
+			m_RotationZ.push_back(_rotation.z);
+			m_RotationW.push_back(_rotation.w);
+			m_ScaleX.push_back(_scale.x);
+			m_ScaleY.push_back(_scale.y);
+			m_ScaleZ.push_back(_scale.z);
+		}
+
+		size_t Size() const noexcept { return m_PositionX.size(); }
+
+		std::vector<float> m_PositionX, m_PositionY, m_PositionZ;
+		std::vector<float> m_RotationX, m_RotationY, m_RotationZ, m_RotationW;
+		std::vector<float> m_ScaleX, m_ScaleY, m_ScaleZ;
+
+	private:
+		std::array<std::vector<float>*, 10> GetStreams() noexcept
+		{
+			return { &m_PositionX, &m_PositionY, &m_PositionZ, &m_RotationX, &m_RotationY, &m_RotationZ, &m_RotationW, &m_ScaleX, &m_ScaleY, &m_ScaleZ };
+		}
+	};
+
+	// Builds translate * rotate * scale model matrices for a whole batch of transforms.
+	// ComputeMatrices picks the widest path the CPU supports. The explicit paths are exposed for benchmarking
+	class TransformKernel
+	{
+	public:
+		BANSHEE_ENGINE static void ComputeMatrices(const TransformSoA& _transforms, glm::mat4* const _outMatrices);
+		BANSHEE_ENGINE static void ComputeMatricesScalar(const TransformSoA& _transforms, glm::mat4* const _outMatrices) noexcept;
+		BANSHEE_ENGINE static void ComputeMatricesSSE(const TransformSoA& _transforms, glm::mat4* const _outMatrices) noexcept;
+		BANSHEE_ENGINE static void ComputeMatricesAVX(const TransformSoA& _transforms, glm::mat4* const _outMatrices) noexcept;
+		BANSHEE_ENGINE static bool IsAVXSupported() noexcept;
+	};
+} // End of Banshee namespace
\ No newline at end of file
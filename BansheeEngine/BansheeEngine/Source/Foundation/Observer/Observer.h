@@ -1,10 +0,0 @@
-#pragma once
-
-namespace Banshee
-{
-	class Observer
-	{
-	public:
-		virtual void OnNotify() = 0;
-	};
-} // End of Banshee namespace
\ No newline at end of file
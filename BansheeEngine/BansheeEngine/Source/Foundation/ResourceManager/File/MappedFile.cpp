@@ -0,0 +1,129 @@
+#include "MappedFile.h"
+#include "Foundation/Logging/Logger.h"
+
+#if defined(_WIN32)
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <Windows.h>
+#else
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+namespace Banshee
+{
+#if defined(_WIN32)
+	MappedFile::MappedFile() noexcept :
+		m_FileHandle{ INVALID_HANDLE_VALUE },
+		m_MappingHandle{ nullptr },
+		m_Data{ nullptr },
+		m_Size{ 0 }
+	{}
+#else
+	MappedFile::MappedFile() noexcept :
+		m_FileDescriptor{ -1 },
+		m_Data{ nullptr },
+		m_Size{ 0 }
+	{}
+#endif
+
+	MappedFile::~MappedFile()
+	{
+		Close();
+	}
+
+	bool MappedFile::Open(const std::string& _filePath)
+	{
+		Close();
+
+#if defined(_WIN32)
+		m_FileHandle = CreateFileA(_filePath.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+		if (m_FileHandle == INVALID_HANDLE_VALUE)
+		{
+			return false;
+		}
+
+		LARGE_INTEGER fileSize{};
+		if (!GetFileSizeEx(m_FileHandle, &fileSize) || fileSize.QuadPart == 0)
+		{
+			Close();
+			return false;
+		}
+
+		m_MappingHandle = CreateFileMappingA(m_FileHandle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+		if (!m_MappingHandle)
+		{
+			BE_LOG(LogCategory::Warning, "[MAPPED FILE]: Failed to create a file mapping for: %s", _filePath.c_str());
+			Close();
+			return false;
+		}
+
+		m_Data = static_cast<const uint8*>(MapViewOfFile(m_MappingHandle, FILE_MAP_READ, 0, 0, 0));
+		m_Size = static_cast<uint64>(fileSize.QuadPart);
+#else
+		m_FileDescriptor = open(_filePath.c_str(), O_RDONLY);
+		if (m_FileDescriptor < 0)
+		{
+			return false;
+		}
+
+		struct stat fileStats{};
+		if (fstat(m_FileDescriptor, &fileStats) != 0 || fileStats.st_size == 0)
+		{
+			Close();
+			return false;
+		}
+
+		void* const data = mmap(nullptr, static_cast<size_t>(fileStats.st_size), PROT_READ, MAP_PRIVATE, m_FileDescriptor, 0);
+		m_Data = data != MAP_FAILED ? static_cast<const uint8*>(data) : nullptr;
+		m_Size = static_cast<uint64>(fileStats.st_size);
+#endif
+
+		if (!m_Data)
+		{
+			BE_LOG(LogCategory::Warning, "[MAPPED FILE]: Failed to map file: %s", _filePath.c_str());
+			Close();
+			return false;
+		}
+
+		return true;
+	}
+
+	void MappedFile::Close() noexcept
+	{
+#if defined(_WIN32)
+		if (m_Data)
+		{
+			UnmapViewOfFile(m_Data);
+		}
+
+		if (m_MappingHandle)
+		{
+			CloseHandle(m_MappingHandle);
+			m_MappingHandle = nullptr;
+		}
+
+		if (m_FileHandle != INVALID_HANDLE_VALUE)
+		{
+			CloseHandle(m_FileHandle);
+			m_FileHandle = INVALID_HANDLE_VALUE;
+		}
+#else
+		if (m_Data)
+		{
+			munmap(const_cast<uint8*>(m_Data), static_cast<size_t>(m_Size));
+		}
+
+		if (m_FileDescriptor >= 0)
+		{
+			close(m_FileDescriptor);
+			m_FileDescriptor = -1;
+		}
+#endif
+
+		m_Data = nullptr;
+		m_Size = 0;
+	}
+} // End of Banshee namespace
\ No newline at end of file
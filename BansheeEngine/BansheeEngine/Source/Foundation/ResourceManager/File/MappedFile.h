@@ -0,0 +1,36 @@
+#pragma once
+
+#include "Foundation/Platform.h"
+#include <string>
+
+namespace Banshee
+{
+	// Read-only memory mapping of a whole file. The mapped bytes stay valid until the file is closed or the MappedFile is destroyed
+	class MappedFile
+	{
+	public:
+		MappedFile() noexcept;
+		~MappedFile();
+
+		bool Open(const std::string& _filePath);
+		void Close() noexcept;
+
+		const uint8* GetData() const noexcept { return m_Data; }
+		uint64 GetSize() const noexcept { return m_Size; }
+
+		MappedFile(const MappedFile&) = delete;
+		MappedFile& operator=(const MappedFile&) = delete;
+		MappedFile(MappedFile&&) = delete;
+		MappedFile& operator=(MappedFile&&) = delete;
+
+	private:
+#if defined(_WIN32)
+		void* m_FileHandle;
+		void* m_MappingHandle;
+#else
+		int32 m_FileDescriptor;
+#endif
+		const uint8* m_Data;
+		uint64 m_Size;
+	};
+} // End of Banshee namespace
\ No newline at end of file
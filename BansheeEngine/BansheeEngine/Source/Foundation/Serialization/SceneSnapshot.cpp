@@ -0,0 +1,356 @@
+#include "SceneSnapshot.h"
+#include "Foundation/Entity/EntityManager.h"
+#include "Foundation/ResourceManager/File/MappedFile.h"
+#include "Foundation/Paths/PathManager.h"
+#include "Foundation/Logging/Logger.h"
+#include "Components.h"
+#include <fstream>
+#include <cstddef>
+#include <memory>
+#include <vector>
+#include <malloc.h>
+
+namespace Banshee
+{
+	// Bump whenever the layout of the file or of a trivially copyable component changes
+	static constexpr uint32 s_SnapshotMagic{ 0x504E5342 }; // "BSNP"
+	static constexpr uint32 s_SnapshotVersion{ 3 };
+
+	struct SnapshotHeader
+	{
+		uint32 m_Magic;
+		uint32 m_Version;
+		uint32 m_EntityTableSize;
+		uint32 m_ArchetypeCount;
+	};
+
+	struct SnapshotArchetypeHeader
+	{
+		uint32 m_EntityCount;
+		uint32 m_ColumnCount;
+	};
+
+	struct SnapshotColumnHeader
+	{
+		uint32 m_TypeId;
+		uint32 m_ComponentSize;
+		uint64 m_ByteCount;
+	};
+
+	// Destroys the components constructed so far and frees their memory
+	struct StagedComponentsDeleter
+	{
+		const ComponentTypeInfo* m_TypeInfo;
+		uint32 m_Count;
+
+		void operator()(uint8* const _components) const noexcept
+		{
+			for (uint32 i = 0; i < m_Count; ++i)
+			{
+				m_TypeInfo->m_Destroy(_components + static_cast<uint64>(i) * m_TypeInfo->m_Size);
+			}
+
+			_aligned_free(_components);
+		}
+	};
+
+	struct SnapshotColumn
+	{
+		const ComponentTypeInfo* m_TypeInfo;
+		const uint8* m_Data;
+		// Components that are not trivially copyable are loaded while the file is validated and moved into the world afterwards
+		std::unique_ptr<uint8, StagedComponentsDeleter> m_Staged;
+	};
+
+	struct SnapshotSection
+	{
+		std::vector<const ComponentTypeInfo*> m_Types;
+		std::vector<SnapshotColumn> m_Columns;
+		const uint32* m_EntityIds;
+		uint32 m_EntityCount;
+	};
+
+	std::array<const ComponentTypeInfo*, g_MaxComponentTypes> SceneSnapshot::s_ComponentTypes{};
+
+	static void CopyColumn(Archetype& _archetype, const int32 _column, const uint32 _firstRow, const uint32 _count, const uint8* const _data, const uint32 _componentSize) noexcept
+	{
+		// Rows are contiguous within a chunk, so the column is copied one chunk segment at a time
+		const uint32 chunkCapacity = _archetype.GetChunkCapacity();
+		uint32 copied{ 0 };
+		while (copied < _count)
+		{
+			const uint32 row = _firstRow + copied;
+			const uint32 segment = std::min(_count - copied, chunkCapacity - row % chunkCapacity);
+			std::memcpy(_archetype.GetComponent(_column, row), _data + static_cast<uint64>(copied) * _componentSize, static_cast<uint64>(segment) * _componentSize);
+			copied += segment;
+		}
+	}
+
+	bool SceneSnapshot::Save(std::string_view _fileName)
+	{
+		RegisterEngineComponentTypes();
+
+		SnapshotWriter writer{};
+		writer.Write(SnapshotHeader{ s_SnapshotMagic, s_SnapshotVersion, static_cast<uint32>(EntityManager::m_EntityRecords.size()), 0 });
+
+		for (const EntityManager::EntityRecord& record : EntityManager::m_EntityRecords)
+		{
+			writer.Write(record.m_Generation);
+		}
+
+		uint32 archetypeCount{ 0 };
+		ComponentMask skippedTypes{ 0 };
+		for (const auto& archetype : EntityManager::GetArchetypes())
+		{
+			if (archetype->GetEntityCount() == 0)
+			{
+				continue;
+			}
+
+			const auto& types = archetype->GetTypes();
+			std::vector<int32> savedColumns{};
+			for (size_t column = 0; column < types.size(); ++column)
+			{
+				if (IsSaved(*types[column]))
+				{
+					savedColumns.push_back(static_cast<int32>(column));
+				}
+				else if ((skippedTypes & (ComponentMask{ 1 } << types[column]->m_TypeId)) == 0)
+				{
+					BE_LOG(LogCategory::Warning, "[SCENE SNAPSHOT]: Component type %u is not trivially copyable and has no Save function, it is left out of the snapshot", types[column]->m_TypeId);
+					skippedTypes |= ComponentMask{ 1 } << types[column]->m_TypeId;
+				}
+			}
+
+			writer.Align(sizeof(uint32));
+			writer.Write(SnapshotArchetypeHeader{ archetype->GetEntityCount(), static_cast<uint32>(savedColumns.size()) });
+			for (uint32 chunk = 0; chunk < archetype->GetChunkCount(); ++chunk)
+			{
+				writer.WriteBytes(archetype->GetChunkEntities(chunk), sizeof(uint32) * archetype->GetChunkEntityCount(chunk));
+			}
+
+			for (const int32 column : savedColumns)
+			{
+				const ComponentTypeInfo& typeInfo = *types[column];
+				const size_t headerOffset = writer.GetSize();
+				writer.Write(SnapshotColumnHeader{ typeInfo.m_TypeId, typeInfo.m_Size, 0 });
+
+				const size_t dataOffset = writer.GetSize();
+				for (uint32 chunk = 0; chunk < archetype->GetChunkCount(); ++chunk)
+				{
+					const uint8* const components = static_cast<const uint8*>(archetype->GetChunkColumn(chunk, column));
+					const uint32 count = archetype->GetChunkEntityCount(chunk);
+
+					if (typeInfo.m_TriviallyCopyable)
+					{
+						writer.WriteBytes(components, static_cast<size_t>(count) * typeInfo.m_Size);
+						continue;
+					}
+
+					for (uint32 i = 0; i < count; ++i)
+					{
+						typeInfo.m_Save(components + static_cast<size_t>(i) * typeInfo.m_Size, writer);
+					}
+				}
+
+				writer.WriteAt(headerOffset + offsetof(SnapshotColumnHeader, m_ByteCount), static_cast<uint64>(writer.GetSize() - dataOffset));
+			}
+
+			++archetypeCount;
+		}
+
+		writer.WriteAt(offsetof(SnapshotHeader, m_ArchetypeCount), archetypeCount);
+
+		const std::string filePath = PathManager::GetGeneratedDirPath() + _fileName.data();
+		std::ofstream file(filePath, std::ios::binary | std::ios::trunc);
+		if (!file.is_open())
+		{
+			BE_LOG(LogCategory::Error, "[SCENE SNAPSHOT]: Failed to open snapshot for writing: %s", filePath.c_str());
+			return false;
+		}
+
+		file.write(reinterpret_cast<const char*>(writer.GetBuffer().data()), static_cast<std::streamsize>(writer.GetSize()));
+		BE_LOG(LogCategory::Info, "[SCENE SNAPSHOT]: Saved %u entities to %s", EntityManager::GetEntityCount(), filePath.c_str());
+		return file.good();
+	}
+
+	bool SceneSnapshot::Load(std::string_view _fileName)
+	{
+		RegisterEngineComponentTypes();
+
+		if (EntityManager::GetEntityCount() != 0)
+		{
+			BE_LOG(LogCategory::Warning, "[SCENE SNAPSHOT]: Snapshots can only be loaded into an empty world");
+			return false;
+		}
+
+		const std::string filePath = PathManager::GetGeneratedDirPath() + _fileName.data();
+		MappedFile file{};
+		if (!file.Open(filePath))
+		{
+			return false;
+		}
+
+		SnapshotReader reader(file.GetData(), static_cast<size_t>(file.GetSize()));
+		const SnapshotHeader header = reader.Read<SnapshotHeader>();
+		if (header.m_Magic != s_SnapshotMagic || header.m_Version != s_SnapshotVersion)
+		{
+			BE_LOG(LogCategory::Warning, "[SCENE SNAPSHOT]: %s is not a snapshot of version %u", filePath.c_str(), s_SnapshotVersion);
+			return false;
+		}
+
+		const uint8* const generations = reader.ReadBytes(header.m_EntityTableSize);
+		if (reader.HasFailed() || header.m_EntityTableSize > Entity::s_IndexMask + 1 || header.m_ArchetypeCount > reader.GetRemainingSize() / sizeof(SnapshotArchetypeHeader))
+		{
+			BE_LOG(LogCategory::Warning, "[SCENE SNAPSHOT]: %s is truncated or corrupt", filePath.c_str());
+			return false;
+		}
+
+		// Validate the whole file before touching the world, so a stale or truncated snapshot leaves it untouched
+		std::vector<SnapshotSection> sections(header.m_ArchetypeCount);
+		std::vector<bool> loadedEntities(header.m_EntityTableSize, false);
+		for (SnapshotSection& section : sections)
+		{
+			reader.Align(sizeof(uint32));
+			const SnapshotArchetypeHeader archetypeHeader = reader.Read<SnapshotArchetypeHeader>();
+			section.m_EntityCount = archetypeHeader.m_EntityCount;
+			section.m_EntityIds = reinterpret_cast<const uint32*>(reader.ReadBytes(sizeof(uint32) * static_cast<size_t>(archetypeHeader.m_EntityCount)));
+			if (reader.HasFailed())
+			{
+				break;
+			}
+
+			for (uint32 i = 0; i < section.m_EntityCount; ++i)
+			{
+				const Entity entity{ section.m_EntityIds[i] };
+				if (entity.GetIndex() >= header.m_EntityTableSize || loadedEntities[entity.GetIndex()] || generations[entity.GetIndex()] != entity.GetGeneration())
+				{
+					BE_LOG(LogCategory::Warning, "[SCENE SNAPSHOT]: %s contains an invalid entity id: %u", filePath.c_str(), entity.GetUniqueId());
+					return false;
+				}
+
+				loadedEntities[entity.GetIndex()] = true;
+			}
+
+			ComponentMask sectionMask{ 0 };
+			for (uint32 column = 0; column < archetypeHeader.m_ColumnCount; ++column)
+			{
+				const SnapshotColumnHeader columnHeader = reader.Read<SnapshotColumnHeader>();
+				const uint8* const data = reader.ReadBytes(static_cast<size_t>(columnHeader.m_ByteCount));
+				if (reader.HasFailed())
+				{
+					break;
+				}
+
+				const ComponentTypeInfo* const typeInfo = columnHeader.m_TypeId < g_MaxComponentTypes ? s_ComponentTypes[columnHeader.m_TypeId] : nullptr;
+				const ComponentMask typeBit = ComponentMask{ 1 } << (columnHeader.m_TypeId % g_MaxComponentTypes);
+				const bool validColumn = typeInfo && (sectionMask & typeBit) == 0 && (typeInfo->m_TriviallyCopyable
+					? typeInfo->m_Size == columnHeader.m_ComponentSize && columnHeader.m_ByteCount == static_cast<uint64>(typeInfo->m_Size) * section.m_EntityCount
+					: typeInfo->m_Load != nullptr);
+
+				if (!validColumn)
+				{
+					BE_LOG(LogCategory::Warning, "[SCENE SNAPSHOT]: %s has an unknown or outdated column for component type %u", filePath.c_str(), columnHeader.m_TypeId);
+					return false;
+				}
+
+				sectionMask |= typeBit;
+				section.m_Types.push_back(typeInfo);
+				section.m_Columns.push_back({ typeInfo, data, nullptr });
+
+				if (typeInfo->m_TriviallyCopyable)
+				{
+					continue;
+				}
+
+				uint8* const staged = static_cast<uint8*>(_aligned_malloc(static_cast<uint64>(typeInfo->m_Size) * section.m_EntityCount, typeInfo->m_Alignment));
+				SnapshotColumn& snapshotColumn = section.m_Columns.back();
+				snapshotColumn.m_Staged = std::unique_ptr<uint8, StagedComponentsDeleter>(staged, { typeInfo, 0 });
+
+				SnapshotReader columnReader(data, static_cast<size_t>(columnHeader.m_ByteCount));
+				for (uint32 i = 0; i < section.m_EntityCount; ++i)
+				{
+					typeInfo->m_Load(staged + static_cast<uint64>(i) * typeInfo->m_Size, columnReader, Entity{ section.m_EntityIds[i] });
+					++snapshotColumn.m_Staged.get_deleter().m_Count;
+				}
+
+				if (columnReader.HasFailed() || !columnReader.IsAtEnd())
+				{
+					BE_LOG(LogCategory::Warning, "[SCENE SNAPSHOT]: Component type %u in %s is truncated or corrupt", columnHeader.m_TypeId, filePath.c_str());
+					return false;
+				}
+			}
+		}
+
+		if (reader.HasFailed() || !reader.IsAtEnd())
+		{
+			BE_LOG(LogCategory::Warning, "[SCENE SNAPSHOT]: %s is truncated or corrupt", filePath.c_str());
+			return false;
+		}
+
+		// Restore the entity table. Slots without a loaded entity keep their generation so handles saved to them stay stale
+		EntityManager::m_EntityRecords.assign(header.m_EntityTableSize, { nullptr, 0, 0, 0 });
+		for (uint32 index = 0; index < header.m_EntityTableSize; ++index)
+		{
+			EntityManager::m_EntityRecords[index].m_Generation = generations[index];
+		}
+
+		for (const SnapshotSection& section : sections)
+		{
+			Archetype* const archetype = EntityManager::GetOrCreateArchetype(section.m_Types);
+			const uint32 firstRow = archetype->AddRows(section.m_EntityIds, section.m_EntityCount);
+
+			for (const SnapshotColumn& column : section.m_Columns)
+			{
+				const int32 columnIndex = archetype->GetColumnIndex(column.m_TypeInfo->m_TypeId);
+				if (column.m_TypeInfo->m_TriviallyCopyable)
+				{
+					CopyColumn(*archetype, columnIndex, firstRow, section.m_EntityCount, column.m_Data, column.m_TypeInfo->m_Size);
+					continue;
+				}
+
+				// The moved-from staged components are destroyed along with the sections
+				for (uint32 i = 0; i < section.m_EntityCount; ++i)
+				{
+					column.m_TypeInfo->m_MoveConstruct(archetype->GetComponent(columnIndex, firstRow + i), column.m_Staged.get() + static_cast<uint64>(i) * column.m_TypeInfo->m_Size);
+				}
+			}
+
+			for (uint32 i = 0; i < section.m_EntityCount; ++i)
+			{
+				const Entity entity{ section.m_EntityIds[i] };
+				EntityManager::EntityRecord& record = EntityManager::m_EntityRecords[entity.GetIndex()];
+				record.m_Archetype = archetype;
+				record.m_Row = firstRow + i;
+				record.m_Mask = archetype->GetMask();
+				EntityManager::EmitComponentEvents(entity, record.m_Mask, 0);
+			}
+
+			EntityManager::m_AliveEntities += section.m_EntityCount;
+		}
+
+		EntityManager::m_FreeIndices.clear();
+		for (uint32 index = 0; index < header.m_EntityTableSize; ++index)
+		{
+			if (!loadedEntities[index])
+			{
+				EntityManager::m_FreeIndices.push_back(index);
+			}
+		}
+
+		BE_LOG(LogCategory::Info, "[SCENE SNAPSHOT]: Loaded %u entities from %s", EntityManager::GetEntityCount(), filePath.c_str());
+		return true;
+	}
+
+	void SceneSnapshot::RegisterComponentTypeInfo(const ComponentTypeInfo& _typeInfo) noexcept
+	{
+		s_ComponentTypes[_typeInfo.m_TypeId] = &_typeInfo;
+	}
+
+	void SceneSnapshot::RegisterEngineComponentTypes() noexcept
+	{
+		RegisterComponentType<TransformComponent>();
+		RegisterComponentType<MeshComponent>();
+		RegisterComponentType<LightComponent>();
+	}
+} // End of Banshee namespace
\ No newline at end of file
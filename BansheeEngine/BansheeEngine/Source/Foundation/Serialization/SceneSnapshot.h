@@ -0,0 +1,40 @@
+#pragma once
+
+#include "Foundation/DLLConfig.h"
+#include "Foundation/Entity/ComponentTypeInfo.h"
+#include <array>
+#include <string_view>
+
+namespace Banshee
+{
+	// Saves the whole ECS world as a flat, versioned binary file and restores it without going through component constructors.
+	// The file holds the generation of every entity slot followed by one section per archetype with its entity ids and component columns.
+	// Loading maps the file and copies trivially copyable columns straight into archetype chunks. Entity indices and generations are
+	// restored exactly, so entity handles stored inside components (owners, transform parents) stay valid without remapping
+	class SceneSnapshot
+	{
+	public:
+		// Paths are relative to the generated directory
+		BANSHEE_ENGINE static bool Save(std::string_view _fileName);
+		// Fails if the world still has live entities, because the entity table is replaced. Added events are emitted for every loaded component
+		BANSHEE_ENGINE static bool Load(std::string_view _fileName);
+
+		// Engine component types are registered automatically. Client components have to be registered before loading a snapshot that contains them
+		template<typename T>
+		requires IsComponent<T>
+		static void RegisterComponentType() { RegisterComponentTypeInfo(GetComponentTypeInfo<T>()); }
+		BANSHEE_ENGINE static void RegisterComponentTypeInfo(const ComponentTypeInfo& _typeInfo) noexcept;
+
+		SceneSnapshot(const SceneSnapshot&) = delete;
+		SceneSnapshot& operator=(const SceneSnapshot&) = delete;
+		SceneSnapshot(SceneSnapshot&&) = delete;
+		SceneSnapshot& operator=(SceneSnapshot&&) = delete;
+
+	private:
+		static void RegisterEngineComponentTypes() noexcept;
+		static bool IsSaved(const ComponentTypeInfo& _typeInfo) noexcept { return _typeInfo.m_TriviallyCopyable || _typeInfo.m_Save; }
+
+	private:
+		static std::array<const ComponentTypeInfo*, g_MaxComponentTypes> s_ComponentTypes;
+	};
+} // End of Banshee namespace
\ No newline at end of file
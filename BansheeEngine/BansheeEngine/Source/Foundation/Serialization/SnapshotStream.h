@@ -0,0 +1,116 @@
+#pragma once
+
+#include "Foundation/Platform.h"
+#include <vector>
+#include <string_view>
+#include <type_traits>
+#include <cstring>
+
+namespace Banshee
+{
+	// Appends raw values to a growing byte buffer. Values are written in native layout, the snapshot is not meant to move between platforms
+	class SnapshotWriter
+	{
+	public:
+		SnapshotWriter() noexcept :
+			m_Buffer{}
+		{}
+
+		template<typename T>
+		requires std::is_trivially_copyable_v<T>
+		void Write(const T& _value) { WriteBytes(&_value, sizeof(T)); }
+
+		// Overwrites a value written earlier, used to fill in sizes once the data they describe has been written
+		template<typename T>
+		requires std::is_trivially_copyable_v<T>
+		void WriteAt(const size_t _offset, const T& _value) noexcept { std::memcpy(m_Buffer.data() + _offset, &_value, sizeof(T)); }
+
+		void WriteBytes(const void* const _data, const size_t _size)
+		{
+			const uint8* const bytes = static_cast<const uint8*>(_data);
+			m_Buffer.insert(m_Buffer.end(), bytes, bytes + _size);
+		}
+
+		void WriteString(std::string_view _string)
+		{
+			Write(static_cast<uint32>(_string.size()));
+			WriteBytes(_string.data(), _string.size());
+		}
+
+		// Pads the buffer with zeros up to the next multiple of _alignment
+		void Align(const size_t _alignment)
+		{
+			m_Buffer.resize((m_Buffer.size() + _alignment - 1) / _alignment * _alignment, 0);
+		}
+
+		size_t GetSize() const noexcept { return m_Buffer.size(); }
+		const std::vector<uint8>& GetBuffer() const noexcept { return m_Buffer; }
+
+	private:
+		std::vector<uint8> m_Buffer;
+	};
+
+	// Reads values back from a snapshot in place. Reading past the end marks the reader as failed and yields zeroed values,
+	// so a truncated file can be rejected after a block of reads instead of checking every value
+	class SnapshotReader
+	{
+	public:
+		SnapshotReader(const uint8* const _data, const size_t _size) noexcept :
+			m_Data{ _data },
+			m_Size{ _size },
+			m_Offset{ 0 },
+			m_Failed{ false }
+		{}
+
+		template<typename T>
+		requires std::is_trivially_copyable_v<T>
+		T Read() noexcept
+		{
+			T value{};
+			const uint8* const bytes = ReadBytes(sizeof(T));
+			if (bytes)
+			{
+				std::memcpy(&value, bytes, sizeof(T));
+			}
+
+			return value;
+		}
+
+		// Returns a pointer to the next _size bytes without copying them, or null if the data is truncated
+		const uint8* ReadBytes(const size_t _size) noexcept
+		{
+			if (m_Failed || _size > m_Size - m_Offset)
+			{
+				m_Failed = true;
+				return nullptr;
+			}
+
+			const uint8* const bytes = m_Data + m_Offset;
+			m_Offset += _size;
+			return bytes;
+		}
+
+		// Skips the padding written by SnapshotWriter::Align
+		void Align(const size_t _alignment) noexcept
+		{
+			ReadBytes((_alignment - m_Offset % _alignment) % _alignment);
+		}
+
+		std::string_view ReadString() noexcept
+		{
+			const uint32 length = Read<uint32>();
+			const uint8* const characters = ReadBytes(length);
+			return characters ? std::string_view(reinterpret_cast<const char*>(characters), length) : std::string_view{};
+		}
+
+		bool HasFailed() const noexcept { return m_Failed; }
+		bool IsAtEnd() const noexcept { return m_Offset == m_Size; }
+		size_t GetRemainingSize() const noexcept { return m_Size - m_Offset; }
+
+	private:
+		const uint8* m_Data;
+		size_t m_Size;
+		size_t m_Offset;
+		bool m_Failed;
+	};
+} // End of Banshee namespace
\ No newline at end of file
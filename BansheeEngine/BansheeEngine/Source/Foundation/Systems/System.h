@@ -0,0 +1,44 @@
+#pragma once
+
+#include "Foundation/Components/ComponentType.h"
+#include <string>
+
+namespace Banshee
+{
+	// Base class for per-frame ECS systems. Each system declares the component types it reads and writes so the
+	// SystemScheduler can run systems without conflicting access in parallel.
+	// Systems must not add or remove components or entities inside Update, as the entity storage is not synchronized
+	class System
+	{
+	public:
+		System(std::string_view _name, const ComponentMask _reads, const ComponentMask _writes) :
+			m_Name{ _name },
+			m_Reads{ _reads },
+			m_Writes{ _writes }
+		{}
+
+		virtual ~System() = default;
+
+		virtual void Update(const double _deltaTime) = 0;
+
+		const std::string& GetName() const noexcept { return m_Name; }
+		ComponentMask GetReads() const noexcept { return m_Reads; }
+		ComponentMask GetWrites() const noexcept { return m_Writes; }
+
+		// Two systems conflict when either one writes a component type the other one accesses
+		bool ConflictsWith(const System& _other) const noexcept
+		{
+			return (m_Writes & (_other.m_Reads | _other.m_Writes)) != 0 || (_other.m_Writes & (m_Reads | m_Writes)) != 0;
+		}
+
+		System(const System&) = delete;
+		System& operator=(const System&) = delete;
+		System(System&&) = delete;
+		System& operator=(System&&) = delete;
+
+	private:
+		std::string m_Name;
+		ComponentMask m_Reads;
+		ComponentMask m_Writes;
+	};
+} // End of Banshee namespace
\ No newline at end of file
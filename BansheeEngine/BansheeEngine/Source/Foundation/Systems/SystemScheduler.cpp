@@ -0,0 +1,100 @@
+#include "SystemScheduler.h"
+#include "Foundation/Jobs/JobSystem.h"
+#include "Foundation/Logging/Logger.h"
+
+namespace Banshee
+{
+	SystemScheduler::SystemScheduler(JobSystem& _jobSystem) noexcept :
+		m_JobSystem{ _jobSystem },
+		m_Nodes{},
+		m_GraphDirty{ false }
+	{}
+
+	SystemScheduler::~SystemScheduler() = default;
+
+	System* SystemScheduler::RegisterSystem(std::unique_ptr<System> _system)
+	{
+		auto node = std::make_unique<SystemNode>();
+		node->m_System = std::move(_system);
+		node->m_DependencyCount = 0;
+		node->m_PendingDependencies = 0;
+
+		System* const system = node->m_System.get();
+		m_Nodes.push_back(std::move(node));
+		m_GraphDirty = true;
+
+		BE_LOG(LogCategory::Trace, "[SCHEDULER]: Registered system %s", system->GetName().c_str());
+		return system;
+	}
+
+	void SystemScheduler::BuildDependencyGraph()
+	{
+		for (const auto& node : m_Nodes)
+		{
+			node->m_Dependents.clear();
+			node->m_DependencyCount = 0;
+		}
+
+		// A system depends on every earlier registered system it conflicts with
+		for (size_t i = 0; i < m_Nodes.size(); ++i)
+		{
+			for (size_t j = i + 1; j < m_Nodes.size(); ++j)
+			{
+				if (m_Nodes[i]->m_System->ConflictsWith(*m_Nodes[j]->m_System))
+				{
+					m_Nodes[i]->m_Dependents.push_back(static_cast<uint32>(j));
+					++m_Nodes[j]->m_DependencyCount;
+				}
+			}
+		}
+
+		m_GraphDirty = false;
+	}
+
+	void SystemScheduler::Run(const double _deltaTime)
+	{
+		if (m_Nodes.empty())
+		{
+			return;
+		}
+
+		if (m_GraphDirty)
+		{
+			BuildDependencyGraph();
+		}
+
+		for (const auto& node : m_Nodes)
+		{
+			node->m_PendingDependencies.store(node->m_DependencyCount, std::memory_order_relaxed);
+		}
+
+		std::atomic<uint32> counter{ 0 };
+		for (size_t i = 0; i < m_Nodes.size(); ++i)
+		{
+			if (m_Nodes[i]->m_DependencyCount == 0)
+			{
+				DispatchSystem(static_cast<uint32>(i), _deltaTime, counter);
+			}
+		}
+
+		m_JobSystem.Wait(counter);
+	}
+
+	void SystemScheduler::DispatchSystem(const uint32 _nodeIndex, const double _deltaTime, std::atomic<uint32>& _counter)
+	{
+		m_JobSystem.Submit([this, _nodeIndex, _deltaTime, &_counter]()
+			{
+				SystemNode& node = *m_Nodes[_nodeIndex];
+				node.m_System->Update(_deltaTime);
+
+				// Dependents are submitted before this job's counter decrement, so the frame never looks finished early
+				for (const uint32 dependent : node.m_Dependents)
+				{
+					if (m_Nodes[dependent]->m_PendingDependencies.fetch_sub(1, std::memory_order_acq_rel) == 1)
+					{
+						DispatchSystem(dependent, _deltaTime, _counter);
+					}
+				}
+			}, &_counter);
+	}
+} // End of Banshee namespace
\ No newline at end of file
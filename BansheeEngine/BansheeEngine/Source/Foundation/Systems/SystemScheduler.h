@@ -0,0 +1,58 @@
+#pragma once
+
+#include "System.h"
+#include "Foundation/DLLConfig.h"
+#include <atomic>
+#include <memory>
+#include <vector>
+
+namespace Banshee
+{
+	class JobSystem;
+
+	// Runs registered systems once per frame. Conflicting systems keep their registration order, while systems with
+	// disjoint component access are dispatched to the job system as soon as everything they depend on has finished
+	class SystemScheduler
+	{
+	public:
+		BANSHEE_ENGINE explicit SystemScheduler(JobSystem& _jobSystem) noexcept;
+		BANSHEE_ENGINE ~SystemScheduler();
+
+		template<typename T, typename... Args>
+		requires std::is_base_of<System, T>::value
+		T* RegisterSystem(Args&&... _args);
+
+		BANSHEE_ENGINE System* RegisterSystem(std::unique_ptr<System> _system);
+		BANSHEE_ENGINE void Run(const double _deltaTime);
+		JobSystem& GetJobSystem() const noexcept { return m_JobSystem; }
+
+		SystemScheduler(const SystemScheduler&) = delete;
+		SystemScheduler& operator=(const SystemScheduler&) = delete;
+		SystemScheduler(SystemScheduler&&) = delete;
+		SystemScheduler& operator=(SystemScheduler&&) = delete;
+
+	private:
+		struct SystemNode
+		{
+			std::unique_ptr<System> m_System;
+			std::vector<uint32> m_Dependents;
+			uint32 m_DependencyCount;
+			std::atomic<uint32> m_PendingDependencies;
+		};
+
+		void BuildDependencyGraph();
+		void DispatchSystem(const uint32 _nodeIndex, const double _deltaTime, std::atomic<uint32>& _counter);
+
+	private:
+		JobSystem& m_JobSystem;
+		std::vector<std::unique_ptr<SystemNode>> m_Nodes;
+		bool m_GraphDirty;
+	};
+
+	template<typename T, typename... Args>
+	requires std::is_base_of<System, T>::value
+	T* SystemScheduler::RegisterSystem(Args&&... _args)
+	{
+		return static_cast<T*>(RegisterSystem(std::make_unique<T>(std::forward<Args>(_args)...)));
+	}
+} // End of Banshee namespace
\ No newline at end of file
@@ -0,0 +1,86 @@
+#pragma once
+
+#include "Foundation/Platform.h"
+#include "Vertex.h"
+#include <glm/glm.hpp>
+#include <array>
+#include <algorithm>
+
+namespace Banshee
+{
+	// Sphere in the space of the vertices it was computed from
+	struct BoundingSphere
+	{
+		glm::vec3 m_Center{ 0.0f };
+		float m_Radius{ 0.0f };
+	};
+
+	// Axis-aligned box in the space of the vertices it was computed from
+	struct AxisAlignedBox
+	{
+		glm::vec3 GetCenter() const noexcept { return (m_Min + m_Max) * 0.5f; }
+		glm::vec3 GetExtents() const noexcept { return (m_Max - m_Min) * 0.5f; }
+
+		glm::vec3 m_Min{ 0.0f };
+		glm::vec3 m_Max{ 0.0f };
+	};
+
+	inline AxisAlignedBox ComputeAxisAlignedBox(const Vertex* const _vertices, const size_t _count) noexcept
+	{
+		if (_count == 0)
+		{
+			return {};
+		}
+
+		AxisAlignedBox box{ _vertices[0].m_Position, _vertices[0].m_Position };
+		for (size_t i = 1; i < _count; ++i)
+		{
+			box.m_Min = glm::min(box.m_Min, _vertices[i].m_Position);
+			box.m_Max = glm::max(box.m_Max, _vertices[i].m_Position);
+		}
+
+		return box;
+	}
+
+	// Centers the sphere on the AABB of the vertices. Not the tightest sphere, but stable and a single extra pass over the vertices
+	inline BoundingSphere ComputeBoundingSphere(const Vertex* const _vertices, const size_t _count, const AxisAlignedBox& _box) noexcept
+	{
+		BoundingSphere sphere{};
+		sphere.m_Center = _box.GetCenter();
+		for (size_t i = 0; i < _count; ++i)
+		{
+			const glm::vec3 offset = _vertices[i].m_Position - sphere.m_Center;
+			sphere.m_Radius = std::max(sphere.m_Radius, glm::dot(offset, offset));
+		}
+
+		sphere.m_Radius = glm::sqrt(sphere.m_Radius);
+		return sphere;
+	}
+
+	// Planes of a view frustum as (normal, distance) with normals pointing inwards, in left, right, bottom, top, near, far order
+	struct Frustum
+	{
+		// Extracts the planes from a view-projection matrix with a [0, 1] depth range (GLM_FORCE_DEPTH_ZERO_TO_ONE)
+		static Frustum FromViewProj(const glm::mat4& _viewProj) noexcept
+		{
+			const glm::mat4 m = glm::transpose(_viewProj);
+
+			Frustum frustum{};
+			frustum.m_Planes[0] = m[3] + m[0];
+			frustum.m_Planes[1] = m[3] - m[0];
+			frustum.m_Planes[2] = m[3] + m[1];
+			frustum.m_Planes[3] = m[3] - m[1];
+			frustum.m_Planes[4] = m[2];
+			frustum.m_Planes[5] = m[3] - m[2];
+
+			for (glm::vec4& plane : frustum.m_Planes)
+			{
+				plane /= glm::length(glm::vec3(plane));
+			}
+
+			return frustum;
+		}
+
+		std::array<glm::vec4, 6> m_Planes{};
+	};
+} // End of Banshee namespace
\ No newline at end of file
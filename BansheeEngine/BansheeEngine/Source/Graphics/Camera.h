@@ -17,6 +17,8 @@ namespace Banshee
 		const glm::mat4& GetViewMatrix() const noexcept { return m_ViewProjMatrix.m_View; }
 		const glm::mat4& GetProjectionMatrix() const noexcept { return m_ViewProjMatrix.m_Proj; }
 		const glm::vec3& GetPosition() const noexcept { return m_Position; }
+		float GetNear() const noexcept { return m_Near; }
+		float GetFar() const noexcept { return m_Far; }
 		void ProcessInput(const double _deltaTime);
 
 	private:
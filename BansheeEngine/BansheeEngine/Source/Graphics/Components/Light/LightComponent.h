@@ -1,28 +1,64 @@
 #pragma once
 
-#include "Foundation/Observer/Observer.h"
 #include "Foundation/DLLConfig.h"
 #include "Foundation/Components/Component.h"
-#include "LightData.h"
+#include <glm/glm.hpp>
 
 namespace Banshee
 {
-	class LightComponent : public Component, public Observer
+	enum class LightType : uint8
+	{
+		Point,
+		Spot,
+		// Lights the whole scene from its direction. Position and range are ignored
+		Directional
+	};
+
+	// Point and spot lights are placed by their entity's transform. Directions are in world space and point the way the light travels,
+	// cone angles are in degrees from the spot's axis. Every setter raises the update flag, which the renderer clears once it has
+	// brought the light's cached shadow maps up to date
+	class LightComponent : public Component
 	{
 	public:
-		BANSHEE_ENGINE LightComponent(const glm::vec3& _color = glm::vec3(1.0f)) noexcept :
-			m_LightData{ glm::vec3(0.0f), _color },
+		static constexpr ComponentType s_ComponentType{ ComponentType::Light };
+
+		BANSHEE_ENGINE LightComponent(const glm::vec3& _color = glm::vec3(1.0f), const float _range = 10.0f) noexcept :
+			m_Color{ _color },
+			m_Direction{ 0.0f, -1.0f, 0.0f },
+			m_Range{ _range },
+			m_InnerConeAngle{ 20.0f },
+			m_OuterConeAngle{ 30.0f },
+			m_Type{ LightType::Point },
+			m_CastsShadows{ false },
 			m_NeedsUpdate{ true }
 		{}
 
-		void SetColor(const glm::vec3& _color) noexcept { m_LightData.m_Color = _color; }
-		const glm::vec3& GetColor() const noexcept { return m_LightData.m_Color; }
+		void SetType(const LightType _type) noexcept { m_Type = _type; m_NeedsUpdate = true; }
+		void SetColor(const glm::vec3& _color) noexcept { m_Color = _color; m_NeedsUpdate = true; }
+		void SetRange(const float _range) noexcept { m_Range = _range; m_NeedsUpdate = true; }
+		void SetDirection(const glm::vec3& _direction) noexcept { m_Direction = glm::normalize(_direction); m_NeedsUpdate = true; }
+		void SetConeAngles(const float _inner, const float _outer) noexcept { m_InnerConeAngle = _inner; m_OuterConeAngle = _outer; m_NeedsUpdate = true; }
+		// Only directional and spot lights render shadow maps
+		void SetCastsShadows(const bool _castsShadows) noexcept { m_CastsShadows = _castsShadows; m_NeedsUpdate = true; }
+		LightType GetType() const noexcept { return m_Type; }
+		const glm::vec3& GetColor() const noexcept { return m_Color; }
+		float GetRange() const noexcept { return m_Range; }
+		const glm::vec3& GetDirection() const noexcept { return m_Direction; }
+		float GetInnerConeAngle() const noexcept { return m_InnerConeAngle; }
+		float GetOuterConeAngle() const noexcept { return m_OuterConeAngle; }
+		bool CastsShadows() const noexcept { return m_CastsShadows; }
+
 		bool NeedsUpdate() const noexcept { return m_NeedsUpdate; }
-		void ResetNeedsUpdate() noexcept { m_NeedsUpdate = false; }
-		virtual void OnNotify() noexcept override;
+		void ClearNeedsUpdate() noexcept { m_NeedsUpdate = false; }
 
 	private:
-		LightData m_LightData;
+		glm::vec3 m_Color;
+		glm::vec3 m_Direction;
+		float m_Range;
+		float m_InnerConeAngle;
+		float m_OuterConeAngle;
+		LightType m_Type;
+		bool m_CastsShadows;
 		bool m_NeedsUpdate;
 	};
-} // End of Banshee namespace
+} // End of Banshee namespace
\ No newline at end of file
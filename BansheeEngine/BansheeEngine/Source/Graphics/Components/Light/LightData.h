@@ -1,17 +1,32 @@
 #pragma once
 
+#include "Foundation/Platform.h"
 #include <glm/glm.hpp>
 
 namespace Banshee
 {
+	// Point or spot light as read by the shaders (std430). Lights affect nothing beyond m_Range, which is what lets them be binned into clusters.
+	// The spot cone falls off as dot(direction to fragment, m_Direction) * m_SpotScale + m_SpotOffset, which is 1 everywhere for point lights
 	struct LightData
 	{
-		LightData(const glm::vec3& _position = glm::vec3(0.0f), const glm::vec3& _color = glm::vec3(1.0f)) noexcept :
+		LightData(const glm::vec3& _position = glm::vec3(0.0f), const glm::vec3& _color = glm::vec3(1.0f), const float _range = 10.0f) noexcept :
 			m_Position{ _position },
-			m_Color{ _color }
+			m_Range{ _range },
+			m_Color{ _color },
+			m_ShadowTile{ -1 },
+			m_Direction{ 0.0f, -1.0f, 0.0f },
+			m_SpotScale{ 0.0f },
+			m_SpotOffset{ 1.0f },
+			m_Padding{ 0.0f }
 		{}
 
 		alignas(16) glm::vec3 m_Position;
-		alignas(16) glm::vec3 m_Color;
+		float m_Range;
+		glm::vec3 m_Color;
+		int32 m_ShadowTile;  // Shadow atlas tile, -1 for lights without a shadow map
+		glm::vec3 m_Direction;
+		float m_SpotScale;
+		float m_SpotOffset;
+		glm::vec3 m_Padding;
 	};
 } // End of Banshee namespace
\ No newline at end of file
@@ -1,6 +1,7 @@
 #include "MeshComponent.h"
 #include "Foundation/Paths/PathManager.h"
 #include "Foundation/ResourceManager/ResourceManager.h"
+#include "Foundation/Events/ComponentEvents.h"
 
 namespace Banshee
 {
@@ -10,6 +11,7 @@ namespace Banshee
 		m_ShaderType{ _shaderType },
 		m_Meshes{},
 		m_ModelName{ g_ResourceManager.GetAssetName(_modelPath) },
+		m_TexturePath{},
 		m_Color{ glm::vec3{1.0f} },
 		m_HasModel{ true },
 		m_HasTexture{ false }
@@ -21,6 +23,7 @@ namespace Banshee
 		m_ShaderType{ _shaderType },
 		m_Meshes{},
 		m_ModelName{ "" },
+		m_TexturePath{},
 		m_Color{ _color },
 		m_HasModel{ false },
 		m_HasTexture{ false }
@@ -28,12 +31,61 @@ namespace Banshee
 		SetMeshId(static_cast<uint32>(_basicShape));
 	}
 
+	MeshComponent::MeshComponent(SnapshotReader& _reader) :
+		m_MeshId{ 0 },
+		m_TexId{ 0 },
+		m_ShaderType{},
+		m_Meshes{},
+		m_ModelName{},
+		m_TexturePath{},
+		m_Color{ glm::vec3{1.0f} },
+		m_HasTexture{ false },
+		m_HasModel{ false }
+	{
+		// Read in the same order as Save, member initialisation order differs from it
+		m_MeshId = _reader.Read<uint32>();
+		m_ShaderType = _reader.Read<ShaderType>();
+		m_ModelName = _reader.ReadString();
+		m_Color = _reader.Read<glm::vec3>();
+		m_HasModel = _reader.Read<bool>();
+
+		const std::string_view texturePath = _reader.ReadString();
+		if (!texturePath.empty())
+		{
+			SetTexture(std::string(texturePath));
+		}
+	}
+
+	void MeshComponent::Save(SnapshotWriter& _writer) const
+	{
+		// Keep in sync with the read order of the snapshot constructor
+		_writer.Write(m_MeshId);
+		_writer.Write(m_ShaderType);
+		_writer.WriteString(m_ModelName);
+		_writer.Write(m_Color);
+		_writer.Write(m_HasModel);
+		_writer.WriteString(m_TexturePath);
+	}
+
 	void MeshComponent::SetTexture(std::string_view _pathToTexture)
 	{
 		m_TexId = g_ResourceManager.LoadImageResource(_pathToTexture.data());
+		m_TexturePath = _pathToTexture;
 		m_HasTexture = true;
 	}
 
+	void MeshComponent::SetColor(const glm::vec3& _color)
+	{
+		m_Color = _color;
+
+		for (auto& subMesh : m_Meshes)
+		{
+			subMesh.material.SetDiffuseColor(_color);
+		}
+
+		ComponentEvents::Emit<MeshComponent>(ComponentEvent::Changed, m_Owner);
+	}
+
 	const std::string MeshComponent::GetModelPath() const
 	{
 		const std::string_view modelsFolder{ "Models/" };
@@ -1,28 +1,38 @@
 #pragma once
 
 #include "Foundation/Components/Component.h"
+#include "Foundation/Serialization/SnapshotStream.h"
 #include "Foundation/DLLConfig.h"
 #include "Graphics/Mesh.h"
 #include "Graphics/PrimitiveShape.h"
 #include "Graphics/ShaderType.h"
 #include <string>
+#include <vector>
 
 namespace Banshee
 {
 	class MeshComponent : public Component
 	{
 	public:
+		static constexpr ComponentType s_ComponentType{ ComponentType::Mesh };
+
 		BANSHEE_ENGINE MeshComponent(std::string_view _modelPath, const ShaderType _shaderType = ShaderType::Standard);
 		BANSHEE_ENGINE MeshComponent(const PrimitiveShape _basicShape, const ShaderType _shaderType = ShaderType::Standard, const glm::vec3& _color = glm::vec3(1.0f));
+		// Snapshots only store what the mesh references (shape or model, texture and color). Sub-meshes are rebuilt by the renderer when it registers the component
+		BANSHEE_ENGINE explicit MeshComponent(SnapshotReader& _reader);
+		BANSHEE_ENGINE void Save(SnapshotWriter& _writer) const;
 
 		BANSHEE_ENGINE void SetTexture(std::string_view _pathToTexture);
+		// Recolors every sub-mesh and emits ComponentEvent::Changed so the renderer refreshes its material data
+		BANSHEE_ENGINE void SetColor(const glm::vec3& _color);
 		void SetMeshId(const uint32 _meshId) noexcept { m_MeshId = _meshId; }
 		void SetSubMesh(const Mesh& _subMesh) { m_Meshes.push_back(_subMesh); }
 		void SetSubMeshes(const std::vector<Mesh>& subMeshes) { m_Meshes = subMeshes; }
 		uint32 GetMeshId() const noexcept { return m_MeshId; }
 		uint16 GetTexId() const noexcept { return m_TexId; }
 		ShaderType GetShaderType() const noexcept { return m_ShaderType; }
-		const std::vector<Mesh>& GetSubMeshes() noexcept { return m_Meshes; }
+		const std::vector<Mesh>& GetSubMeshes() const noexcept { return m_Meshes; }
+		std::vector<Mesh>& GetSubMeshes() noexcept { return m_Meshes; }
 		const std::string_view GetModelName() const noexcept { return m_ModelName; }
 		const std::string GetModelPath() const;
 		const glm::vec3& GetColor() const noexcept { return m_Color; }
@@ -35,6 +45,7 @@ namespace Banshee
 		ShaderType m_ShaderType;
 		std::vector<Mesh> m_Meshes;
 		std::string m_ModelName;
+		std::string m_TexturePath;
 		glm::vec3 m_Color;
 		bool m_HasTexture;
 		bool m_HasModel;
@@ -1,43 +1,80 @@
 #include "TransformComponent.h"
-#include <glm/gtc/matrix_transform.hpp>
+#include "Foundation/Entity/EntityManager.h"
+#include "Foundation/Logging/Logger.h"
 
 namespace Banshee
 {
+	uint32 TransformComponent::s_HierarchyVersion{ 0 };
+	uint32 TransformComponent::s_ModelVersion{ 0 };
+
 	void TransformComponent::SetPosition(const glm::vec3& _position) noexcept
 	{
 		m_Position = _position;
+		m_LocalDirty = true;
 	}
 
 	void TransformComponent::SetRotation(const glm::quat& _rotation) noexcept
 	{
 		m_Rotation = _rotation;
+		m_LocalDirty = true;
 	}
 
 	void TransformComponent::SetScale(const glm::vec3& _scale) noexcept
 	{
 		m_Scale = _scale;
+		m_LocalDirty = true;
 	}
 
 	void TransformComponent::Translate(const glm::vec3& _translation) noexcept
 	{
 		m_Position += _translation;
+		m_LocalDirty = true;
 	}
 
 	void TransformComponent::Rotate(const glm::quat& _rotation) noexcept
 	{
 		m_Rotation *= _rotation;
+		m_LocalDirty = true;
 	}
 
 	void TransformComponent::Scale(const glm::vec3& _scale) noexcept
 	{
 		m_Scale *= _scale;
+		m_LocalDirty = true;
+	}
+
+	void TransformComponent::SetParent(const Entity _parent)
+	{
+		if (_parent == m_Parent)
+		{
+			return;
+		}
+
+		// Walk up from the new parent to make sure this transform is not one of its ancestors
+		for (Entity ancestor = _parent; ancestor.IsValid();)
+		{
+			if (ancestor == m_Owner)
+			{
+				BE_LOG(LogCategory::Warning, "[TRANSFORM]: Ignoring SetParent on entity %u as it would create a cycle", m_Owner.GetUniqueId());
+				return;
+			}
+
+			const TransformComponent* const ancestorTransform = ancestor.IsAlive() ? ancestor.GetComponent<TransformComponent>() : nullptr;
+			ancestor = ancestorTransform ? ancestorTransform->m_Parent : Entity{};
+		}
+
+		m_Parent = _parent;
+		m_LocalDirty = true;
+		++s_HierarchyVersion;
+	}
+
+	uint32 TransformComponent::GetHierarchyVersion() noexcept
+	{
+		return s_HierarchyVersion;
 	}
 
-	glm::mat4 TransformComponent::GetModel() const
+	uint32 TransformComponent::GetLatestModelVersion() noexcept
 	{
-		const glm::mat4 translationMatrix = glm::translate(glm::mat4(1.0f), m_Position);
-		const glm::mat4 rotationMatrix = glm::mat4_cast(m_Rotation);
-		const glm::mat4 scaleMatrix = glm::scale(glm::mat4(1.0f), m_Scale);
-		return translationMatrix * rotationMatrix * scaleMatrix;
+		return s_ModelVersion;
 	}
 } // End of Banshee namespace
\ No newline at end of file
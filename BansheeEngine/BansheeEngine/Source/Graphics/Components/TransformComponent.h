@@ -7,13 +7,23 @@
 
 namespace Banshee
 {
+	// Position, rotation and scale are relative to the parent transform, or to the world for root transforms.
+	// Local and world matrices are cached and only rebuilt by the TransformSystem after the transform or one of its ancestors changed.
+	// The TransformSystem builds local matrices in batches with the TransformKernel
 	class TransformComponent : public Component
 	{
 	public:
+		static constexpr ComponentType s_ComponentType{ ComponentType::Transform };
+
 		BANSHEE_ENGINE TransformComponent() noexcept :
 			m_Position{ glm::vec3(0.0f, 0.0f, 0.0f) },
 			m_Scale{ glm::vec3(1.0f) },
-			m_Rotation{ glm::quat(1.0f, 0.0f, 0.0f, 0.0f) }
+			m_Rotation{ glm::quat(1.0f, 0.0f, 0.0f, 0.0f) },
+			m_Parent{},
+			m_LocalMatrix{ glm::mat4(1.0f) },
+			m_WorldMatrix{ glm::mat4(1.0f) },
+			m_ModelVersion{ 0 },
+			m_LocalDirty{ true }
 		{}
 
 		BANSHEE_ENGINE void SetPosition(const glm::vec3& _position) noexcept;
@@ -22,13 +32,38 @@ namespace Banshee
 		BANSHEE_ENGINE void Translate(const glm::vec3& _translation) noexcept;
 		BANSHEE_ENGINE void Rotate(const glm::quat& _rotation) noexcept;
 		BANSHEE_ENGINE void Scale(const glm::vec3& _scale) noexcept;
-		BANSHEE_ENGINE glm::mat4 GetModel() const;
+		// Attaches this transform to the transform of _parent. Pass an invalid entity to detach it
+		BANSHEE_ENGINE void SetParent(const Entity _parent);
+		BANSHEE_ENGINE Entity GetParent() const noexcept { return m_Parent; }
 		BANSHEE_ENGINE const glm::vec3& GetPosition() const noexcept { return m_Position; }
 		BANSHEE_ENGINE const glm::vec3& GetScale() const noexcept { return m_Scale; }
+		BANSHEE_ENGINE const glm::quat& GetRotation() const noexcept { return m_Rotation; }
+		BANSHEE_ENGINE const glm::mat4& GetLocalMatrix() const noexcept { return m_LocalMatrix; }
+		// World matrix as of the last TransformSystem update
+		BANSHEE_ENGINE const glm::mat4& GetModel() const noexcept { return m_WorldMatrix; }
+		// Model version of the TransformSystem update that last changed the world matrix. Caches built from world matrices
+		// (such as shadow maps) compare it with the latest model version they've seen to find what moved since
+		BANSHEE_ENGINE uint32 GetModelVersion() const noexcept { return m_ModelVersion; }
+
+		// Incremented whenever any transform changes parent, so the TransformSystem knows to rebuild its hierarchy order
+		BANSHEE_ENGINE static uint32 GetHierarchyVersion() noexcept;
+		// Incremented by every TransformSystem update that changes at least one world matrix
+		BANSHEE_ENGINE static uint32 GetLatestModelVersion() noexcept;
+
+	private:
+		friend class TransformSystem;
 
 	private:
 		glm::vec3 m_Position;
 		glm::vec3 m_Scale;
 		glm::quat m_Rotation;
+		Entity m_Parent;
+		glm::mat4 m_LocalMatrix;
+		glm::mat4 m_WorldMatrix;
+		uint32 m_ModelVersion;
+		bool m_LocalDirty;
+
+		static uint32 s_HierarchyVersion;
+		static uint32 s_ModelVersion;
 	};
 } // End of Banshee namespace
\ No newline at end of file
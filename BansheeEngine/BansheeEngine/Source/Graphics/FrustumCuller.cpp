@@ -0,0 +1,109 @@
+#include "FrustumCuller.h"
+#include <immintrin.h>
+#include <cmath>
+
+namespace Banshee
+{
+	namespace
+	{
+		bool IsVisibleScalar(const Frustum& _frustum, const CullingBoundsSoA& _bounds, const size_t _index) noexcept
+		{
+			for (const glm::vec4& plane : _frustum.m_Planes)
+			{
+				const float sphereDistance = plane.x * _bounds.m_SphereX[_index] + plane.y * _bounds.m_SphereY[_index] + plane.z * _bounds.m_SphereZ[_index] + plane.w;
+				if (sphereDistance < -_bounds.m_SphereRadius[_index])
+				{
+					return false;
+				}
+
+				const float boxDistance = plane.x * _bounds.m_BoxCenterX[_index] + plane.y * _bounds.m_BoxCenterY[_index] + plane.z * _bounds.m_BoxCenterZ[_index] + plane.w;
+				const float boxRadius = std::abs(plane.x) * _bounds.m_BoxExtentX[_index] + std::abs(plane.y) * _bounds.m_BoxExtentY[_index] + std::abs(plane.z) * _bounds.m_BoxExtentZ[_index];
+				if (boxDistance < -boxRadius)
+				{
+					return false;
+				}
+			}
+
+			return true;
+		}
+
+		__m128 Dot3SSE(const __m128 _nx, const __m128 _ny, const __m128 _nz, const __m128 _x, const __m128 _y, const __m128 _z) noexcept
+		{
+			return _mm_add_ps(_mm_add_ps(_mm_mul_ps(_nx, _x), _mm_mul_ps(_ny, _y)), _mm_mul_ps(_nz, _z));
+		}
+	}
+
+	uint32 FrustumCuller::Cull(const Frustum& _frustum, const CullingBoundsSoA& _bounds, uint8* const _outVisibility) noexcept
+	{
+		return CullSSE(_frustum, _bounds, _outVisibility);
+	}
+
+	uint32 FrustumCuller::CullScalar(const Frustum& _frustum, const CullingBoundsSoA& _bounds, uint8* const _outVisibility) noexcept
+	{
+		uint32 visibleCount{ 0 };
+		for (size_t i = 0; i < _bounds.Size(); ++i)
+		{
+			_outVisibility[i] = IsVisibleScalar(_frustum, _bounds, i) ? 1 : 0;
+			visibleCount += _outVisibility[i];
+		}
+
+		return visibleCount;
+	}
+
+	uint32 FrustumCuller::CullSSE(const Frustum& _frustum, const CullingBoundsSoA& _bounds, uint8* const _outVisibility) noexcept
+	{
+		// Plane components are splatted once, every iteration then tests four objects against all six planes
+		std::array<std::array<__m128, 4>, 6> planes{};
+		std::array<std::array<__m128, 3>, 6> absNormals{};
+		for (size_t p = 0; p < planes.size(); ++p)
+		{
+			const glm::vec4& plane = _frustum.m_Planes[p];
+			planes[p] = { _mm_set1_ps(plane.x), _mm_set1_ps(plane.y), _mm_set1_ps(plane.z), _mm_set1_ps(plane.w) };
+			absNormals[p] = { _mm_set1_ps(std::abs(plane.x)), _mm_set1_ps(std::abs(plane.y)), _mm_set1_ps(std::abs(plane.z)) };
+		}
+
+		const size_t count = _bounds.Size();
+		uint32 visibleCount{ 0 };
+		size_t i = 0;
+
+		for (; i + 4 <= count; i += 4)
+		{
+			const __m128 sphereX = _mm_loadu_ps(&_bounds.m_SphereX[i]);
+			const __m128 sphereY = _mm_loadu_ps(&_bounds.m_SphereY[i]);
+			const __m128 sphereZ = _mm_loadu_ps(&_bounds.m_SphereZ[i]);
+			const __m128 negSphereRadius = _mm_sub_ps(_mm_setzero_ps(), _mm_loadu_ps(&_bounds.m_SphereRadius[i]));
+			const __m128 boxX = _mm_loadu_ps(&_bounds.m_BoxCenterX[i]);
+			const __m128 boxY = _mm_loadu_ps(&_bounds.m_BoxCenterY[i]);
+			const __m128 boxZ = _mm_loadu_ps(&_bounds.m_BoxCenterZ[i]);
+			const __m128 extentX = _mm_loadu_ps(&_bounds.m_BoxExtentX[i]);
+			const __m128 extentY = _mm_loadu_ps(&_bounds.m_BoxExtentY[i]);
+			const __m128 extentZ = _mm_loadu_ps(&_bounds.m_BoxExtentZ[i]);
+
+			__m128 outside = _mm_setzero_ps();
+			for (size_t p = 0; p < planes.size(); ++p)
+			{
+				const __m128 sphereDistance = _mm_add_ps(Dot3SSE(planes[p][0], planes[p][1], planes[p][2], sphereX, sphereY, sphereZ), planes[p][3]);
+				const __m128 boxDistance = _mm_add_ps(Dot3SSE(planes[p][0], planes[p][1], planes[p][2], boxX, boxY, boxZ), planes[p][3]);
+				const __m128 negBoxRadius = _mm_sub_ps(_mm_setzero_ps(), Dot3SSE(absNormals[p][0], absNormals[p][1], absNormals[p][2], extentX, extentY, extentZ));
+
+				outside = _mm_or_ps(outside, _mm_cmplt_ps(sphereDistance, negSphereRadius));
+				outside = _mm_or_ps(outside, _mm_cmplt_ps(boxDistance, negBoxRadius));
+			}
+
+			const int32 outsideMask = _mm_movemask_ps(outside);
+			for (uint32 k = 0; k < 4; ++k)
+			{
+				_outVisibility[i + k] = ((outsideMask >> k) & 1) ? 0 : 1;
+				visibleCount += _outVisibility[i + k];
+			}
+		}
+
+		for (; i < count; ++i)
+		{
+			_outVisibility[i] = IsVisibleScalar(_frustum, _bounds, i) ? 1 : 0;
+			visibleCount += _outVisibility[i];
+		}
+
+		return visibleCount;
+	}
+} // End of Banshee namespace
\ No newline at end of file
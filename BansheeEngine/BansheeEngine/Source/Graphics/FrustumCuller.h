@@ -0,0 +1,83 @@
+#pragma once
+
+#include "Foundation/DLLConfig.h"
+#include "Foundation/Platform.h"
+#include "Bounds.h"
+#include <glm/glm.hpp>
+#include <vector>
+#include <array>
+
+namespace Banshee
+{
+	// World-space bounding sphere and box of every render object, one stream per component so the SIMD path can test four objects per instruction.
+	// Boxes are stored as center and half extents, which makes the plane test a single dot product per side
+	struct CullingBoundsSoA
+	{
+		void Clear() noexcept
+		{
+			for (std::vector<float>* const stream : GetStreams())
+			{
+				stream->clear();
+			}
+		}
+
+		void Reserve(const size_t _count)
+		{
+			for (std::vector<float>* const stream : GetStreams())
+			{
+				stream->reserve(_count);
+			}
+		}
+
+		// Transforms local bounds to world space. The sphere radius grows with the largest axis scale, the box is re-fitted around the rotated box
+		void Add(const glm::mat4& _model, const BoundingSphere& _sphere, const AxisAlignedBox& _box)
+		{
+			const glm::vec3 sphereCenter = glm::vec3(_model * glm::vec4(_sphere.m_Center, 1.0f));
+			const float scale = glm::max(glm::length(glm::vec3(_model[0])), glm::max(glm::length(glm::vec3(_model[1])), glm::length(glm::vec3(_model[2]))));
+			const glm::vec3 boxCenter = glm::vec3(_model * glm::vec4(_box.GetCenter(), 1.0f));
+			const glm::vec3 localExtents = _box.GetExtents();
+			const glm::vec3 boxExtents = glm::abs(glm::vec3(_model[0])) * localExtents.x + glm::abs(glm::vec3(_model[1])) * localExtents.y + glm::abs(glm::vec3(_model[2])) * localExtents.z;
+
+			m_SphereX.push_back(sphereCenter.x);
+			m_SphereY.push_back(sphereCenter.y);
+			m_SphereZ.push_back(sphereCenter.z);
+			m_SphereRadius.push_back(_sphere.m_Radius * scale);
+			m_BoxCenterX.push_back(boxCenter.x);
+			m_BoxCenterY.push_back(boxCenter.y);
+			m_BoxCenterZ.push_back(boxCenter.z);
+			m_BoxExtentX.push_back(boxExtents.x);
+			m_BoxExtentY.push_back(boxExtents.y);
+			m_BoxExtentZ.push_back(boxExtents.z);
+		}
+
+		size_t Size() const noexcept { return m_SphereX.size(); }
+
+		std::vector<float> m_SphereX, m_SphereY, m_SphereZ, m_SphereRadius;
+		std::vector<float> m_BoxCenterX, m_BoxCenterY, m_BoxCenterZ;
+		std::vector<float> m_BoxExtentX, m_BoxExtentY, m_BoxExtentZ;
+
+	private:
+		std::array<std::vector<float>*, 10> GetStreams() noexcept
+		{
+			return { &m_SphereX, &m_SphereY, &m_SphereZ, &m_SphereRadius, &m_BoxCenterX, &m_BoxCenterY, &m_BoxCenterZ, &m_BoxExtentX, &m_BoxExtentY, &m_BoxExtentZ };
+		}
+	};
+
+	struct CullingStats
+	{
+		uint32 m_Visible{ 0 };
+		uint32 m_Culled{ 0 };
+	};
+
+	// Tests render objects against the six frustum planes. An object is culled when its sphere or its box lies entirely behind any plane.
+	// The sphere rejects most objects cheaply, the box keeps long thin objects whose sphere pokes into the frustum from being drawn.
+	// Cull uses the SSE path, which every x64 CPU supports. The scalar path is exposed for benchmarking
+	class FrustumCuller
+	{
+	public:
+		// Writes 1 for every visible and 0 for every culled object to _outVisibility and returns the number of visible objects
+		BANSHEE_ENGINE static uint32 Cull(const Frustum& _frustum, const CullingBoundsSoA& _bounds, uint8* const _outVisibility) noexcept;
+		BANSHEE_ENGINE static uint32 CullScalar(const Frustum& _frustum, const CullingBoundsSoA& _bounds, uint8* const _outVisibility) noexcept;
+		BANSHEE_ENGINE static uint32 CullSSE(const Frustum& _frustum, const CullingBoundsSoA& _bounds, uint8* const _outVisibility) noexcept;
+	};
+} // End of Banshee namespace
\ No newline at end of file
@@ -17,16 +17,21 @@ namespace Banshee
 		glm::mat4 m_Proj{ glm::mat4(1.0f) };
 	};
 
-	struct PushConstant
+	// Matches the std430 InstanceData struct of the vertex shaders, which index it with gl_InstanceIndex
+	struct InstanceData
 	{
-		PushConstant(const glm::mat4& _model, const uint16 _texId, const uint16 _hasCustomTexture) noexcept :
+		InstanceData() noexcept = default;
+		InstanceData(const glm::mat4& _model, const uint16 _texId, const uint16 _hasCustomTexture, const uint32 _materialIndex) noexcept :
 			m_Model{ _model },
 			m_TextureIndex{ _texId },
-			m_HasCustomTexture{ _hasCustomTexture }
+			m_HasCustomTexture{ _hasCustomTexture },
+			m_MaterialIndex{ _materialIndex }
 		{}
 
-		const glm::mat4 m_Model{ glm::mat4(1.0f) };
-		const uint32 m_TextureIndex{ 0 };
-		const uint32 m_HasCustomTexture{ 0 };
+		glm::mat4 m_Model{ glm::mat4(1.0f) };
+		uint32 m_TextureIndex{ 0 };
+		uint32 m_HasCustomTexture{ 0 };
+		uint32 m_MaterialIndex{ 0 };
+		uint32 m_Padding{ 0 };
 	};
 } // End of Banshee namespace
\ No newline at end of file
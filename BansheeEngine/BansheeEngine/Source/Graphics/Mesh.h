@@ -1,22 +1,36 @@
 #pragma once
 
 #include "Foundation/Platform.h"
-#include "Graphics/Vertex.h"
 #include "Material.h"
-#include <vector>
+#include "Bounds.h"
+#include <array>
 
 namespace Banshee
 {
+	// LOD 0 is the full sub-mesh, every further LOD has roughly half the triangles of the one before
+	constexpr uint32 g_MaxMeshLods{ 5 };
+
+	// Simplified LODs index the sub-mesh's vertices from their own range of the shared index buffer
+	struct MeshLod
+	{
+		uint32 indexOffset;
+		uint32 indexCount;
+	};
+
 	struct Mesh
 	{
 		Mesh() noexcept :
 			indexOffset{ 0 },
-			vertices{},
-			indices{},
+			indexCount{ 0 },
 			material{},
 			localTransform{ 1.0f },
-			m_MaterialIndex{ SetNextMaterialIndex() },
+			boundingBox{},
+			boundingSphere{},
+			lods{},
+			lodCount{ 1 },
+			m_MaterialIndex{ 0 },
 			m_TexId{ 0 },
+			m_SelectedLod{ 0 },
 			m_HasTexture{ false }
 		{}
 
@@ -30,23 +44,26 @@ namespace Banshee
 
 		bool HasTexture() const noexcept { return m_HasTexture; }
 		uint16 GetTexId() const noexcept { return m_TexId; }
+		// Material slots in the renderer's material buffer are assigned when the mesh is registered with the renderer
+		void SetMaterialIndex(const uint32 _materialIndex) noexcept { m_MaterialIndex = _materialIndex; }
 		uint32 GetMaterialIndex() const noexcept { return m_MaterialIndex; }
+		MeshLod GetLod(const uint32 _lod) const noexcept { return _lod == 0 ? MeshLod{ indexOffset, indexCount } : lods[_lod - 1]; }
+		// LOD the renderer drew this sub-mesh with last, which its LOD selection keeps unless the screen size moves clearly past a threshold
+		void SetSelectedLod(const uint32 _lod) noexcept { m_SelectedLod = static_cast<uint8>(_lod); }
+		uint32 GetSelectedLod() const noexcept { return m_SelectedLod; }
 		uint32 indexOffset;   // Offset into the index buffer
-		std::vector<Vertex> vertices{};
-		std::vector<uint32> indices{};
+		uint32 indexCount;    // Geometry lives only in the shared vertex/index buffers, so copying a sub-mesh does not allocate
 		Material material;
 		glm::mat4 localTransform;
-
-	private:
-		static uint32 SetNextMaterialIndex() noexcept
-		{
-			static uint32 nextIndex{ 0 };
-			return ++nextIndex;
-		}
+		AxisAlignedBox boundingBox;      // Both bounds are in the sub-mesh's vertex space, before localTransform
+		BoundingSphere boundingSphere;
+		std::array<MeshLod, g_MaxMeshLods - 1> lods;   // LODs 1 and up, see GetLod
+		uint32 lodCount;
 
 	private:
 		uint32 m_MaterialIndex;
 		uint16 m_TexId;
+		uint8 m_SelectedLod;
 		bool m_HasTexture;
 	};
 } // End of Banshee namespace
\ No newline at end of file
@@ -0,0 +1,353 @@
+#include "MeshSimplifier.h"
+#include <algorithm>
+#include <array>
+#include <numeric>
+#include <queue>
+
+namespace Banshee
+{
+	// A collapse is rejected when it turns the normal of a remaining triangle further than this (cosine of the angle)
+	constexpr static float g_MinNormalCosine{ 0.2f };
+
+	namespace
+	{
+		// Sum of squared distances to a set of planes, as the upper triangle of a symmetric 4x4 matrix
+		struct Quadric
+		{
+			void AddPlane(const glm::dvec3& _normal, const double _distance, const double _weight) noexcept
+			{
+				const double a = _normal.x;
+				const double b = _normal.y;
+				const double c = _normal.z;
+				const double d = _distance;
+				m[0] += _weight * a * a; m[1] += _weight * a * b; m[2] += _weight * a * c; m[3] += _weight * a * d;
+				m[4] += _weight * b * b; m[5] += _weight * b * c; m[6] += _weight * b * d;
+				m[7] += _weight * c * c; m[8] += _weight * c * d;
+				m[9] += _weight * d * d;
+			}
+
+			void Add(const Quadric& _other) noexcept
+			{
+				for (size_t i = 0; i < m.size(); ++i)
+				{
+					m[i] += _other.m[i];
+				}
+			}
+
+			double Evaluate(const glm::vec3& _position) const noexcept
+			{
+				const double x = _position.x;
+				const double y = _position.y;
+				const double z = _position.z;
+				return m[0] * x * x + 2.0 * m[1] * x * y + 2.0 * m[2] * x * z + 2.0 * m[3] * x +
+					m[4] * y * y + 2.0 * m[5] * y * z + 2.0 * m[6] * y +
+					m[7] * z * z + 2.0 * m[8] * z +
+					m[9];
+			}
+
+			std::array<double, 10> m{};
+		};
+
+		struct Collapse
+		{
+			float m_Cost;
+			uint32 m_From;          // Position group that moves
+			uint32 m_To;            // Vertex it moves onto
+			uint32 m_FromVersion;
+			uint32 m_ToVersion;
+
+			bool operator>(const Collapse& _other) const noexcept { return m_Cost > _other.m_Cost; }
+		};
+	}
+
+	void MeshSimplifier::Simplify(std::span<const Vertex> _vertices, std::span<const uint32> _indices, const uint32 _targetIndexCount, std::vector<uint32>& _outIndices)
+	{
+		_outIndices.clear();
+		const uint32 vertexCount = static_cast<uint32>(_vertices.size());
+
+		// Vertices at the same position (split by texture coordinates or normals) form one position group. Topology and error are tracked per group
+		std::vector<uint32> sortedVertices(vertexCount);
+		std::iota(sortedVertices.begin(), sortedVertices.end(), 0);
+		const auto positionLess = [&_vertices](const uint32 _lhs, const uint32 _rhs) noexcept
+			{
+				const glm::vec3& lhs = _vertices[_lhs].m_Position;
+				const glm::vec3& rhs = _vertices[_rhs].m_Position;
+				return lhs.x != rhs.x ? lhs.x < rhs.x : lhs.y != rhs.y ? lhs.y < rhs.y : lhs.z < rhs.z;
+			};
+		std::sort(sortedVertices.begin(), sortedVertices.end(), positionLess);
+
+		std::vector<uint32> groups(vertexCount);
+		std::vector<bool> locked{};
+		for (uint32 i = 0; i < vertexCount; ++i)
+		{
+			const bool newGroup = i == 0 || _vertices[sortedVertices[i - 1]].m_Position != _vertices[sortedVertices[i]].m_Position;
+			if (newGroup)
+			{
+				locked.push_back(false);
+			}
+			else
+			{
+				locked.back() = true;
+			}
+
+			groups[sortedVertices[i]] = static_cast<uint32>(locked.size() - 1);
+		}
+
+		const uint32 groupCount = static_cast<uint32>(locked.size());
+		const auto groupOf = [&groups](const uint32 _vertex) noexcept { return groups[_vertex]; };
+
+		// Triangles collapsed to a line or point are invisible and are dropped right away
+		std::vector<uint32> triangles{};
+		triangles.reserve(_indices.size());
+		for (size_t i = 0; i + 2 < _indices.size(); i += 3)
+		{
+			const uint32 a = groupOf(_indices[i]);
+			const uint32 b = groupOf(_indices[i + 1]);
+			const uint32 c = groupOf(_indices[i + 2]);
+			if (a != b && b != c && a != c)
+			{
+				triangles.insert(triangles.end(), { _indices[i], _indices[i + 1], _indices[i + 2] });
+			}
+		}
+
+		const uint32 triangleCount = static_cast<uint32>(triangles.size() / 3);
+
+		// Edges used by one triangle lie on an open border, edges used by more than two are non-manifold. Either way their ends stay put
+		std::vector<uint64> edges{};
+		edges.reserve(triangles.size());
+		for (uint32 triangle = 0; triangle < triangleCount; ++triangle)
+		{
+			for (uint32 corner = 0; corner < 3; ++corner)
+			{
+				const uint32 a = groupOf(triangles[triangle * 3 + corner]);
+				const uint32 b = groupOf(triangles[triangle * 3 + (corner + 1) % 3]);
+				edges.push_back((static_cast<uint64>(std::min(a, b)) << 32) | std::max(a, b));
+			}
+		}
+
+		std::sort(edges.begin(), edges.end());
+		for (size_t first = 0; first < edges.size();)
+		{
+			size_t last = first + 1;
+			while (last < edges.size() && edges[last] == edges[first])
+			{
+				++last;
+			}
+
+			if (last - first != 2)
+			{
+				locked[static_cast<uint32>(edges[first] >> 32)] = true;
+				locked[static_cast<uint32>(edges[first])] = true;
+			}
+
+			first = last;
+		}
+
+		// Every group starts with the area weighted planes of its triangles
+		std::vector<Quadric> quadrics(groupCount);
+		std::vector<std::vector<uint32>> groupTriangles(groupCount);
+		for (uint32 triangle = 0; triangle < triangleCount; ++triangle)
+		{
+			const glm::dvec3 p0 = _vertices[triangles[triangle * 3]].m_Position;
+			const glm::dvec3 p1 = _vertices[triangles[triangle * 3 + 1]].m_Position;
+			const glm::dvec3 p2 = _vertices[triangles[triangle * 3 + 2]].m_Position;
+			const glm::dvec3 normal = glm::cross(p1 - p0, p2 - p0);
+			const double doubleArea = glm::length(normal);
+			if (doubleArea > 0.0)
+			{
+				const glm::dvec3 unitNormal = normal / doubleArea;
+				Quadric plane{};
+				plane.AddPlane(unitNormal, -glm::dot(unitNormal, p0), 0.5 * doubleArea);
+				for (uint32 corner = 0; corner < 3; ++corner)
+				{
+					quadrics[groupOf(triangles[triangle * 3 + corner])].Add(plane);
+				}
+			}
+
+			for (uint32 corner = 0; corner < 3; ++corner)
+			{
+				groupTriangles[groupOf(triangles[triangle * 3 + corner])].push_back(triangle);
+			}
+		}
+
+		std::vector<bool> aliveTriangles(triangleCount, true);
+		std::vector<bool> removedGroups(groupCount, false);
+		std::vector<uint32> versions(groupCount, 0);
+		std::priority_queue<Collapse, std::vector<Collapse>, std::greater<Collapse>> collapses{};
+
+		const auto pushCollapse = [&](const uint32 _from, const uint32 _to)
+			{
+				Quadric quadric = quadrics[_from];
+				quadric.Add(quadrics[groupOf(_to)]);
+				collapses.push({ static_cast<float>(quadric.Evaluate(_vertices[_to].m_Position)), _from, _to, versions[_from], versions[groupOf(_to)] });
+			};
+
+		const auto pushGroupCollapses = [&](const uint32 _group)
+			{
+				for (const uint32 triangle : groupTriangles[_group])
+				{
+					for (uint32 corner = 0; corner < 3 && aliveTriangles[triangle]; ++corner)
+					{
+						const uint32 vertex = triangles[triangle * 3 + corner];
+						if (groupOf(vertex) != _group)
+						{
+							pushCollapse(_group, vertex);
+						}
+					}
+				}
+			};
+
+		const auto gatherNeighbours = [&](const uint32 _group, std::vector<uint32>& _outNeighbours)
+			{
+				_outNeighbours.clear();
+				for (const uint32 triangle : groupTriangles[_group])
+				{
+					for (uint32 corner = 0; corner < 3 && aliveTriangles[triangle]; ++corner)
+					{
+						const uint32 neighbour = groupOf(triangles[triangle * 3 + corner]);
+						if (neighbour != _group)
+						{
+							_outNeighbours.push_back(neighbour);
+						}
+					}
+				}
+
+				std::sort(_outNeighbours.begin(), _outNeighbours.end());
+				_outNeighbours.erase(std::unique(_outNeighbours.begin(), _outNeighbours.end()), _outNeighbours.end());
+			};
+
+		for (uint32 group = 0; group < groupCount; ++group)
+		{
+			if (!locked[group])
+			{
+				pushGroupCollapses(group);
+			}
+		}
+
+		uint32 aliveTriangleCount = triangleCount;
+		std::vector<uint32> fromNeighbours{};
+		std::vector<uint32> toNeighbours{};
+		std::vector<uint32> sharedNeighbours{};
+
+		while (aliveTriangleCount * 3 > _targetIndexCount && !collapses.empty())
+		{
+			const Collapse collapse = collapses.top();
+			collapses.pop();
+
+			const uint32 from = collapse.m_From;
+			const uint32 to = groupOf(collapse.m_To);
+			if (removedGroups[from] || removedGroups[to] || versions[from] != collapse.m_FromVersion || versions[to] != collapse.m_ToVersion)
+			{
+				continue;
+			}
+
+			// Link condition: the two ends may only share the neighbours opposite the edge, anything else would pinch the surface
+			gatherNeighbours(from, fromNeighbours);
+			gatherNeighbours(to, toNeighbours);
+			sharedNeighbours.clear();
+			std::set_intersection(fromNeighbours.begin(), fromNeighbours.end(), toNeighbours.begin(), toNeighbours.end(), std::back_inserter(sharedNeighbours));
+
+			uint32 edgeTriangles{ 0 };
+			bool flips{ false };
+			const glm::vec3& target = _vertices[collapse.m_To].m_Position;
+			for (const uint32 triangle : groupTriangles[from])
+			{
+				if (!aliveTriangles[triangle])
+				{
+					continue;
+				}
+
+				const uint32* const corners = &triangles[triangle * 3];
+				if (groupOf(corners[0]) == to || groupOf(corners[1]) == to || groupOf(corners[2]) == to)
+				{
+					++edgeTriangles;
+					continue;
+				}
+
+				// Triangles that stay must keep facing the same way once the vertex moves
+				std::array<glm::vec3, 3> positions{ _vertices[corners[0]].m_Position, _vertices[corners[1]].m_Position, _vertices[corners[2]].m_Position };
+				const glm::vec3 normalBefore = glm::cross(positions[1] - positions[0], positions[2] - positions[0]);
+				for (uint32 corner = 0; corner < 3; ++corner)
+				{
+					if (groupOf(corners[corner]) == from)
+					{
+						positions[corner] = target;
+					}
+				}
+
+				const glm::vec3 normalAfter = glm::cross(positions[1] - positions[0], positions[2] - positions[0]);
+				flips = flips || glm::dot(normalBefore, normalAfter) <= g_MinNormalCosine * glm::length(normalBefore) * glm::length(normalAfter);
+			}
+
+			if (flips || sharedNeighbours.size() != edgeTriangles)
+			{
+				continue;
+			}
+
+			// Triangles on the edge disappear, the others are handed to the target group with the moved vertex replaced
+			for (const uint32 triangle : groupTriangles[from])
+			{
+				if (!aliveTriangles[triangle])
+				{
+					continue;
+				}
+
+				uint32* const corners = &triangles[triangle * 3];
+				if (groupOf(corners[0]) == to || groupOf(corners[1]) == to || groupOf(corners[2]) == to)
+				{
+					aliveTriangles[triangle] = false;
+					--aliveTriangleCount;
+					continue;
+				}
+
+				for (uint32 corner = 0; corner < 3; ++corner)
+				{
+					if (groupOf(corners[corner]) == from)
+					{
+						corners[corner] = collapse.m_To;
+					}
+				}
+
+				groupTriangles[to].push_back(triangle);
+			}
+
+			quadrics[to].Add(quadrics[from]);
+			removedGroups[from] = true;
+			groupTriangles[from].clear();
+			++versions[to];
+
+			// The target's error grew, so every collapse onto or from it is queued again with its new cost
+			if (!locked[to])
+			{
+				pushGroupCollapses(to);
+			}
+
+			for (const uint32 triangle : groupTriangles[to])
+			{
+				for (uint32 corner = 0; corner < 3 && aliveTriangles[triangle]; ++corner)
+				{
+					const uint32 neighbour = groupOf(triangles[triangle * 3 + corner]);
+					if (neighbour != to && !locked[neighbour])
+					{
+						for (uint32 targetCorner = 0; targetCorner < 3; ++targetCorner)
+						{
+							if (groupOf(triangles[triangle * 3 + targetCorner]) == to)
+							{
+								pushCollapse(neighbour, triangles[triangle * 3 + targetCorner]);
+							}
+						}
+					}
+				}
+			}
+		}
+
+		_outIndices.reserve(static_cast<size_t>(aliveTriangleCount) * 3);
+		for (uint32 triangle = 0; triangle < triangleCount; ++triangle)
+		{
+			if (aliveTriangles[triangle])
+			{
+				_outIndices.insert(_outIndices.end(), { triangles[triangle * 3], triangles[triangle * 3 + 1], triangles[triangle * 3 + 2] });
+			}
+		}
+	}
+} // End of Banshee namespace
\ No newline at end of file
@@ -0,0 +1,20 @@
+#pragma once
+
+#include "Foundation/Platform.h"
+#include "Vertex.h"
+#include <span>
+#include <vector>
+
+namespace Banshee
+{
+	// Quadric error metric edge collapse (Garland & Heckbert). A vertex only ever collapses onto one of its neighbours, so simplified triangles
+	// index the original vertices and every LOD shares the sub-mesh's vertex buffer. Vertices on open borders, on non-manifold edges and on
+	// seams (positions shared by several vertices with different texture coordinates or normals) never move, which keeps silhouettes and seams intact
+	class MeshSimplifier
+	{
+	public:
+		// Collapses the cheapest edges until at most _targetIndexCount indices remain or no collapse is allowed anymore.
+		// _indices index _vertices, as do the indices written to _outIndices
+		static void Simplify(std::span<const Vertex> _vertices, std::span<const uint32> _indices, const uint32 _targetIndexCount, std::vector<uint32>& _outIndices);
+	};
+} // End of Banshee namespace
\ No newline at end of file
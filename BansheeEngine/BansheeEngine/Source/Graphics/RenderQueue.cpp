@@ -0,0 +1,71 @@
+#include "RenderQueue.h"
+#include <array>
+#include <algorithm>
+#include <bit>
+
+namespace Banshee
+{
+	namespace
+	{
+		constexpr uint32 g_RadixBits{ 8 };
+		constexpr uint32 g_RadixBuckets{ 1 << g_RadixBits };
+		constexpr uint32 g_RadixPasses{ 64 / g_RadixBits };
+
+		uint32 DepthBits(const float _depth) noexcept
+		{
+			return std::bit_cast<uint32>(std::max(_depth, 0.0f));
+		}
+	}
+
+	uint64 RenderQueue::MakeOpaqueKey(const ShaderType _shaderType, const uint32 _meshId, const uint32 _subMesh, const float _depth) noexcept
+	{
+		return (static_cast<uint64>(static_cast<uint8>(_shaderType) & 0x7) << 60) | (static_cast<uint64>(_meshId & 0xFFFF) << 44) |
+			(static_cast<uint64>(_subMesh & 0xFFF) << 32) | DepthBits(_depth);
+	}
+
+	uint64 RenderQueue::MakeTranslucentKey(const ShaderType _shaderType, const uint32 _meshId, const uint32 _subMesh, const float _depth) noexcept
+	{
+		return (uint64{ 1 } << 63) | (static_cast<uint64>(~DepthBits(_depth)) << 31) | (static_cast<uint64>(static_cast<uint8>(_shaderType) & 0x7) << 28) |
+			(static_cast<uint64>(_meshId & 0xFFFF) << 12) | (_subMesh & 0xFFF);
+	}
+
+	void RenderQueue::Sort()
+	{
+		// All byte histograms are built in a single pass over the keys
+		std::array<std::array<uint32, g_RadixBuckets>, g_RadixPasses> histograms{};
+		for (const Entry& entry : m_Entries)
+		{
+			for (uint32 pass = 0; pass < g_RadixPasses; ++pass)
+			{
+				++histograms[pass][(entry.m_Key >> (pass * g_RadixBits)) & (g_RadixBuckets - 1)];
+			}
+		}
+
+		m_Scratch.resize(m_Entries.size());
+		for (uint32 pass = 0; pass < g_RadixPasses; ++pass)
+		{
+			std::array<uint32, g_RadixBuckets>& histogram = histograms[pass];
+			const uint32 shift = pass * g_RadixBits;
+			if (std::find(histogram.begin(), histogram.end(), static_cast<uint32>(m_Entries.size())) != histogram.end())
+			{
+				continue;
+			}
+
+			// Turn the counts into each bucket's first output position
+			uint32 offset{ 0 };
+			for (uint32& count : histogram)
+			{
+				const uint32 bucketSize = count;
+				count = offset;
+				offset += bucketSize;
+			}
+
+			for (const Entry& entry : m_Entries)
+			{
+				m_Scratch[histogram[(entry.m_Key >> shift) & (g_RadixBuckets - 1)]++] = entry;
+			}
+
+			m_Entries.swap(m_Scratch);
+		}
+	}
+} // End of Banshee namespace
\ No newline at end of file
@@ -0,0 +1,39 @@
+#pragma once
+
+#include "Foundation/DLLConfig.h"
+#include "Foundation/Platform.h"
+#include "ShaderType.h"
+#include <vector>
+
+namespace Banshee
+{
+	// Per-frame list of draws ordered by a 64-bit sort key.
+	// Opaque keys:      [63] 0 | [62..60] pipeline | [59..44] mesh | [43..32] sub-mesh | [31..0] depth
+	// Translucent keys: [63] 1 | [62..31] inverted depth | [30..28] pipeline | [27..12] mesh | [11..0] sub-mesh
+	// Opaque draws come first, grouped by state so pipeline and vertex buffer changes are minimal, then front-to-back within a sub-mesh.
+	// Translucent draws follow back-to-front, which takes priority over state for them.
+	// Depth is a non-negative float, whose bit pattern sorts like an unsigned integer. Keys don't need to be unique, only their order matters
+	class RenderQueue
+	{
+	public:
+		struct Entry
+		{
+			uint64 m_Key;
+			uint32 m_Item;   // Caller defined, usually an index into the caller's draw list
+		};
+
+		BANSHEE_ENGINE static uint64 MakeOpaqueKey(const ShaderType _shaderType, const uint32 _meshId, const uint32 _subMesh, const float _depth) noexcept;
+		BANSHEE_ENGINE static uint64 MakeTranslucentKey(const ShaderType _shaderType, const uint32 _meshId, const uint32 _subMesh, const float _depth) noexcept;
+		static bool IsTranslucentKey(const uint64 _key) noexcept { return (_key >> 63) != 0; }
+
+		void Clear() noexcept { m_Entries.clear(); }
+		void Push(const uint64 _key, const uint32 _item) { m_Entries.push_back({ _key, _item }); }
+		// Stable LSD radix sort over the key bytes. Passes where every key has the same byte are skipped, which is most of the high bytes in practice
+		BANSHEE_ENGINE void Sort();
+		const std::vector<Entry>& GetEntries() const noexcept { return m_Entries; }
+
+	private:
+		std::vector<Entry> m_Entries;
+		std::vector<Entry> m_Scratch;
+	};
+} // End of Banshee namespace
\ No newline at end of file
@@ -1,22 +1,35 @@
 #include "MeshSystem.h"
+#include "Foundation/Entity/EntityManager.h"
 #include "Graphics/Components/MeshComponent.h"
+#include <algorithm>
 
 namespace Banshee
 {
-	void MeshSystem::SetMeshComponents(const std::vector<std::shared_ptr<MeshComponent>>& _meshComponents)
+	void MeshSystem::AddMeshEntity(const Entity _entity)
 	{
-		m_MeshRenderers = _meshComponents;
+		const MeshComponent* const meshComponent = _entity.GetComponent<MeshComponent>();
+		if (!meshComponent)
+		{
+			return;
+		}
+
+		// Insert after the last entity sharing the same shader type to keep the list sorted
+		const ShaderType shaderType = meshComponent->GetShaderType();
+		auto it = std::upper_bound(m_MeshEntities.begin(), m_MeshEntities.end(), shaderType, [](const ShaderType _shaderType, const Entity _other) noexcept
+			{
+				const MeshComponent* const otherMesh = _other.GetComponent<MeshComponent>();
+				return otherMesh && _shaderType < otherMesh->GetShaderType();
+			});
+
+		m_MeshEntities.insert(it, _entity);
 	}
 
-	std::shared_ptr<MeshComponent> MeshSystem::GetMeshComponentById(const uint32 _meshId) const noexcept
+	void MeshSystem::RemoveMeshEntity(const Entity _entity)
 	{
-		for (const auto& meshComponent : m_MeshRenderers)
+		auto it = std::find(m_MeshEntities.begin(), m_MeshEntities.end(), _entity);
+		if (it != m_MeshEntities.end())
 		{
-			if (meshComponent->GetMeshId() == _meshId)
-			{
-				return meshComponent;
-			}
+			m_MeshEntities.erase(it);
 		}
-		return nullptr;
 	}
 } // End of Banshee namespace
\ No newline at end of file
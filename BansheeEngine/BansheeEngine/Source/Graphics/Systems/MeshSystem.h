@@ -1,22 +1,24 @@
 #pragma once
 
 #include "Foundation/Platform.h"
-#include <memory>
+#include "Foundation/Entity/Entity.h"
 #include <vector>
 
 namespace Banshee
 {
 	class MeshComponent;
 
+	// Keeps the entities whose meshes are registered with the renderer, ordered by shader type so pipeline binds are minimized.
+	// Entities are stored instead of component pointers because components move in memory whenever an archetype changes
 	class MeshSystem
 	{
 	public:
 		MeshSystem() noexcept = default;
 		~MeshSystem() noexcept = default;
 
-		void SetMeshComponents(const std::vector<std::shared_ptr<MeshComponent>>& _meshComponents);
-		const std::vector<std::shared_ptr<MeshComponent>>& GetMeshComponents() const noexcept { return m_MeshRenderers; }
-		std::shared_ptr<MeshComponent> GetMeshComponentById(const uint32 _meshId) const noexcept;
+		void AddMeshEntity(const Entity _entity);
+		void RemoveMeshEntity(const Entity _entity);
+		const std::vector<Entity>& GetMeshEntities() const noexcept { return m_MeshEntities; }
 
 		MeshSystem(const MeshSystem&) = delete;
 		MeshSystem(MeshSystem&&) = delete;
@@ -24,6 +26,6 @@ namespace Banshee
 		void operator=(MeshSystem&&) = delete;
 
 	private:
-		std::vector<std::shared_ptr<MeshComponent>> m_MeshRenderers;
+		std::vector<Entity> m_MeshEntities;
 	};
 } // End of Banshee namespace
\ No newline at end of file
@@ -2,6 +2,7 @@
 #include "Foundation/Logging/Logger.h"
 #include "Foundation/ResourceManager/ResourceManager.h"
 #include "Graphics/Components/MeshComponent.h"
+#include "Graphics/MeshSimplifier.h"
 #include "glm/gtc/matrix_transform.hpp"
 #include "glm/gtc/type_ptr.hpp"
 
@@ -12,6 +13,11 @@
 
 namespace Banshee
 {
+	// Sub-meshes this small aren't worth simplifying further
+	constexpr static uint32 g_MinLodIndexCount{ 64 * 3 };
+	// A LOD that keeps more than this share of the previous LOD's indices isn't kept, simplification has run out of allowed collapses
+	constexpr static float g_MaxLodIndexRatio{ 0.8f };
+
 	static bool LoadImageDataCallback(tinygltf::Image* _image, const int _image_idx, std::string* _err, std::string* _warn, int _req_width, int _req_height, const unsigned char* _bytes, int _size, void* _user_data)
 	{
 		auto* data = static_cast<std::pair<std::vector<uint16>*, std::unordered_map<uint16, uint16>*>*>(_user_data);
@@ -81,7 +87,9 @@ namespace Banshee
 				const float* texCoords = reinterpret_cast<const float*>(&(texCoordsBuffer.data[texCoordsBufferView.byteOffset + textureAccessor.byteOffset]));
 				const float* normals = reinterpret_cast<const float*>(&(normalsBuffer.data[normalsBufferView.byteOffset + normalAccessor.byteOffset]));
 
-				std::vector<Vertex> subMeshVertices(positionsAccessor.count);
+				const size_t firstVertex = _vertices.size();
+				_vertices.resize(firstVertex + positionsAccessor.count);
+				Vertex* const subMeshVertices = _vertices.data() + firstVertex;
 				for (size_t j = 0; j < positionsAccessor.count; ++j) 
 				{
 					subMeshVertices[j].m_Position = glm::vec3(
@@ -100,26 +108,24 @@ namespace Banshee
 					);
 				}
 
-				_vertices.insert(_vertices.end(), subMeshVertices.begin(), subMeshVertices.end());
-
 				// Load index data
 				const auto& indicesAccessor = _model.accessors[primitive.indices];
 				const auto& indicesBufferView = _model.bufferViews[indicesAccessor.bufferView];
 				const auto& indicesBuffer = _model.buffers[indicesBufferView.buffer];
 				const uint16* indices = reinterpret_cast<const uint16*>(&(indicesBuffer.data[indicesBufferView.byteOffset + indicesAccessor.byteOffset]));
-				std::vector<uint32> subMeshIndices(indicesAccessor.count);
+				_indices.reserve(_indices.size() + indicesAccessor.count);
 				for (size_t j = 0; j < indicesAccessor.count; ++j) 
 				{
-					subMeshIndices[j] = indices[j] + vertexOffset;
+					_indices.push_back(indices[j] + vertexOffset);
 				}
 
-				_indices.insert(_indices.end(), subMeshIndices.begin(), subMeshIndices.end());
-
-				subMesh.vertices = subMeshVertices;
-				subMesh.indices = subMeshIndices;
+				subMesh.indexCount = static_cast<uint32>(indicesAccessor.count);
 				subMesh.localTransform = nodeTransform;
+				subMesh.boundingBox = ComputeAxisAlignedBox(subMeshVertices, positionsAccessor.count);
+				subMesh.boundingSphere = ComputeBoundingSphere(subMeshVertices, positionsAccessor.count, subMesh.boundingBox);
 
 				LoadMaterial(_model, primitive, &subMesh);
+				GenerateLods(subMeshVertices, positionsAccessor.count, vertexOffset, &subMesh, _indices);
 
 				_meshComponent->SetSubMesh(subMesh);
 			}
@@ -159,6 +165,40 @@ namespace Banshee
         }
 	}
 
+	void ModelLoadingSystem::GenerateLods(const Vertex* const _vertices, const size_t _vertexCount, const uint32 _vertexOffset, Mesh* const _subMesh, std::vector<uint32>& _indices) const
+	{
+		assert(_subMesh != nullptr);
+
+		// Every LOD is simplified from the previous one, with indices relative to the sub-mesh's first vertex
+		std::vector<uint32> sourceIndices(_indices.begin() + _subMesh->indexOffset, _indices.begin() + _subMesh->indexOffset + _subMesh->indexCount);
+		for (uint32& index : sourceIndices)
+		{
+			index -= _vertexOffset;
+		}
+
+		std::vector<uint32> lodIndices{};
+		while (_subMesh->lodCount < g_MaxMeshLods && sourceIndices.size() >= g_MinLodIndexCount)
+		{
+			const uint32 targetIndexCount = static_cast<uint32>(sourceIndices.size() / 6) * 3;
+			MeshSimplifier::Simplify({ _vertices, _vertexCount }, sourceIndices, targetIndexCount, lodIndices);
+			if (lodIndices.empty() || lodIndices.size() > sourceIndices.size() * g_MaxLodIndexRatio)
+			{
+				break;
+			}
+
+			_subMesh->lods[_subMesh->lodCount - 1] = { static_cast<uint32>(_indices.size()), static_cast<uint32>(lodIndices.size()) };
+			++_subMesh->lodCount;
+
+			_indices.reserve(_indices.size() + lodIndices.size());
+			for (const uint32 index : lodIndices)
+			{
+				_indices.push_back(index + _vertexOffset);
+			}
+
+			sourceIndices.swap(lodIndices);
+		}
+	}
+
 	void ModelLoadingSystem::LoadMaterial(const tinygltf::Model& _model, const tinygltf::Primitive& _primitive, Mesh* const _subMesh)
 	{
 		assert(_subMesh != nullptr);
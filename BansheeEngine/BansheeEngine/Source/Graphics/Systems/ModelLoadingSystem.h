@@ -33,6 +33,8 @@ namespace Banshee
 		void LoadModel(const tinygltf::Model& _model, MeshComponent* const _meshComponent, std::vector<Vertex>& _vertices, std::vector<uint32>& _indices);
 		void GetNodeTransform(const tinygltf::Node& _node, glm::mat4& _outTransform) const noexcept;
 		void LoadMaterial(const tinygltf::Model& _model, const tinygltf::Primitive& _primitive, Mesh* const _subMesh);
+		// Appends the simplified LODs of the sub-mesh's index range to _indices
+		void GenerateLods(const Vertex* const _vertices, const size_t _vertexCount, const uint32 _vertexOffset, Mesh* const _subMesh, std::vector<uint32>& _indices) const;
 
 	private:
 		std::vector<uint16> m_TextureIds;
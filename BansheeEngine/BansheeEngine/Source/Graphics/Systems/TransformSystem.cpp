@@ -0,0 +1,305 @@
+#include "TransformSystem.h"
+#include "Foundation/Events/ComponentEvents.h"
+#include <algorithm>
+#include <numeric>
+
+namespace Banshee
+{
+	TransformSystem::TransformSystem() :
+		m_TransformView{},
+		m_OrderedEntities{},
+		m_ParentIndices{},
+		m_Transforms{},
+		m_OrderIndices{},
+		m_ArchetypeRowVersions{},
+		m_AddedEntities{},
+		m_RemovedEntities{},
+		m_WorldChanged{},
+		m_DirtyIndices{},
+		m_DirtyLocals{},
+		m_LocalMatrices{},
+		m_EventSubscriptions{},
+		m_HierarchyVersion{ TransformComponent::GetHierarchyVersion() }
+	{
+		m_EventSubscriptions[0] = ComponentEvents::Subscribe<TransformComponent>(ComponentEvent::Added, [this](std::span<const Entity> _entities)
+			{
+				m_AddedEntities.insert(m_AddedEntities.end(), _entities.begin(), _entities.end());
+			});
+		m_EventSubscriptions[1] = ComponentEvents::Subscribe<TransformComponent>(ComponentEvent::Removed, [this](std::span<const Entity> _entities)
+			{
+				m_RemovedEntities.insert(m_RemovedEntities.end(), _entities.begin(), _entities.end());
+			});
+		RebuildHierarchyOrder();
+	}
+
+	TransformSystem::~TransformSystem()
+	{
+		for (const uint32 subscription : m_EventSubscriptions)
+		{
+			ComponentEvents::Unsubscribe(subscription);
+		}
+	}
+
+	void TransformSystem::Update()
+	{
+		// A transform removed and added again on the same entity may come back with a different parent, which only a rebuild can place
+		bool rebuild = m_HierarchyVersion != TransformComponent::GetHierarchyVersion();
+		for (size_t i = 0; i < m_RemovedEntities.size() && !rebuild; ++i)
+		{
+			rebuild = m_OrderIndices.contains(m_RemovedEntities[i].GetUniqueId()) && m_RemovedEntities[i].HasComponent<TransformComponent>();
+		}
+
+		if (rebuild)
+		{
+			// Added transforms may come with world matrices and model versions of their own (e.g. from a snapshot)
+			for (const Entity entity : m_AddedEntities)
+			{
+				if (TransformComponent* const transform = entity.GetComponent<TransformComponent>())
+				{
+					transform->m_LocalDirty = true;
+				}
+			}
+
+			m_HierarchyVersion = TransformComponent::GetHierarchyVersion();
+			RebuildHierarchyOrder();
+		}
+		else
+		{
+			RefreshTransformPointers();
+			RemoveTransforms();
+
+			for (const Entity entity : m_AddedEntities)
+			{
+				AppendTransform(entity);
+			}
+		}
+
+		m_AddedEntities.clear();
+		m_RemovedEntities.clear();
+
+		const size_t transformCount = m_OrderedEntities.size();
+		m_WorldChanged.assign(transformCount, 0);
+		m_DirtyIndices.clear();
+		m_DirtyLocals.Clear();
+
+		for (size_t i = 0; i < transformCount; ++i)
+		{
+			const TransformComponent* const transform = m_Transforms[i];
+			if (transform->m_LocalDirty)
+			{
+				m_DirtyIndices.push_back(static_cast<uint32>(i));
+				m_DirtyLocals.Add(transform->m_Position, transform->m_Rotation, transform->m_Scale);
+			}
+		}
+
+		m_LocalMatrices.resize(m_DirtyIndices.size());
+		TransformKernel::ComputeMatrices(m_DirtyLocals, m_LocalMatrices.data());
+
+		for (size_t i = 0; i < m_DirtyIndices.size(); ++i)
+		{
+			TransformComponent* const transform = m_Transforms[m_DirtyIndices[i]];
+			transform->m_LocalMatrix = m_LocalMatrices[i];
+			transform->m_LocalDirty = false;
+			m_WorldChanged[m_DirtyIndices[i]] = 1;
+		}
+
+		// Every world matrix rebuilt by this update is stamped with the same new model version
+		const uint32 modelVersion = TransformComponent::s_ModelVersion + 1;
+		bool modelsChanged{ false };
+
+		for (size_t i = 0; i < transformCount; ++i)
+		{
+			TransformComponent* const transform = m_Transforms[i];
+			const int32 parentIndex = m_ParentIndices[i];
+			const bool parentChanged = parentIndex >= 0 && m_WorldChanged[parentIndex];
+
+			if (m_WorldChanged[i] || parentChanged)
+			{
+				transform->m_WorldMatrix = parentIndex >= 0 ? m_Transforms[parentIndex]->m_WorldMatrix * transform->m_LocalMatrix : transform->m_LocalMatrix;
+				transform->m_ModelVersion = modelVersion;
+				m_WorldChanged[i] = 1;
+				modelsChanged = true;
+			}
+		}
+
+		if (modelsChanged)
+		{
+			TransformComponent::s_ModelVersion = modelVersion;
+		}
+	}
+
+	void TransformSystem::RebuildHierarchyOrder()
+	{
+		std::vector<Entity> entities{};
+		std::vector<TransformComponent*> transforms{};
+		entities.reserve(m_TransformView.GetEntityCount());
+		transforms.reserve(entities.capacity());
+		m_TransformView.ForEach([&entities, &transforms](const Entity _entity, TransformComponent& _transform)
+			{
+				// Parents that were destroyed or lost their transform turn their children into roots
+				const Entity parent = _transform.GetParent();
+				if (parent.IsValid() && (!parent.IsAlive() || !parent.HasComponent<TransformComponent>()))
+				{
+					_transform.m_Parent = Entity{};
+					_transform.m_LocalDirty = true;
+				}
+
+				entities.push_back(_entity);
+				transforms.push_back(&_transform);
+			});
+
+		// Sorting by depth puts every parent ahead of its children
+		std::vector<uint32> depths(entities.size(), 0);
+		for (size_t i = 0; i < entities.size(); ++i)
+		{
+			for (Entity parent = transforms[i]->GetParent(); parent.IsValid();)
+			{
+				++depths[i];
+				parent = parent.GetComponent<TransformComponent>()->GetParent();
+			}
+		}
+
+		std::vector<uint32> order(entities.size());
+		std::iota(order.begin(), order.end(), 0);
+		std::stable_sort(order.begin(), order.end(), [&depths](const uint32 _a, const uint32 _b) noexcept
+			{
+				return depths[_a] < depths[_b];
+			});
+
+		m_OrderIndices.clear();
+		m_OrderIndices.reserve(entities.size());
+		m_OrderedEntities.resize(entities.size());
+		m_Transforms.resize(entities.size());
+		for (size_t i = 0; i < order.size(); ++i)
+		{
+			m_OrderedEntities[i] = entities[order[i]];
+			m_Transforms[i] = transforms[order[i]];
+			m_OrderIndices[m_OrderedEntities[i].GetUniqueId()] = static_cast<uint32>(i);
+		}
+
+		m_ParentIndices.resize(m_OrderedEntities.size());
+		for (size_t i = 0; i < m_OrderedEntities.size(); ++i)
+		{
+			const Entity parent = m_Transforms[i]->GetParent();
+			m_ParentIndices[i] = parent.IsValid() ? static_cast<int32>(m_OrderIndices[parent.GetUniqueId()]) : -1;
+		}
+
+		// Every cached address was just fetched
+		const std::vector<Archetype*>& archetypes = m_TransformView.GetArchetypes();
+		m_ArchetypeRowVersions.resize(archetypes.size());
+		for (size_t i = 0; i < archetypes.size(); ++i)
+		{
+			m_ArchetypeRowVersions[i] = archetypes[i]->GetRowVersion();
+		}
+	}
+
+	void TransformSystem::RefreshTransformPointers()
+	{
+		// Rows only move when their archetype adds or removes rows, including entities gaining or losing unrelated components
+		const std::vector<Archetype*>& archetypes = m_TransformView.GetArchetypes();
+		m_ArchetypeRowVersions.resize(archetypes.size(), 0);
+		for (size_t i = 0; i < archetypes.size(); ++i)
+		{
+			const Archetype& archetype = *archetypes[i];
+			if (archetype.GetRowVersion() == m_ArchetypeRowVersions[i])
+			{
+				continue;
+			}
+
+			m_ArchetypeRowVersions[i] = archetype.GetRowVersion();
+			EntityManager::ForEachInArchetype<TransformComponent>(archetype, [this](const Entity _entity, TransformComponent& _transform)
+				{
+					const auto orderIndex = m_OrderIndices.find(_entity.GetUniqueId());
+					if (orderIndex != m_OrderIndices.end())
+					{
+						m_Transforms[orderIndex->second] = &_transform;
+					}
+				});
+		}
+	}
+
+	void TransformSystem::RemoveTransforms()
+	{
+		if (m_RemovedEntities.empty())
+		{
+			return;
+		}
+
+		// Removed transforms are compacted out without reordering the rest, children left without a parent become roots
+		std::vector<int32> newIndices(m_OrderedEntities.size(), 0);
+		for (const Entity entity : m_RemovedEntities)
+		{
+			const auto orderIndex = m_OrderIndices.find(entity.GetUniqueId());
+			if (orderIndex != m_OrderIndices.end())
+			{
+				newIndices[orderIndex->second] = -1;
+				m_OrderIndices.erase(orderIndex);
+			}
+		}
+
+		uint32 keptCount{ 0 };
+		for (size_t i = 0; i < m_OrderedEntities.size(); ++i)
+		{
+			if (newIndices[i] < 0)
+			{
+				continue;
+			}
+
+			TransformComponent* const transform = m_Transforms[i];
+			int32 parentIndex = m_ParentIndices[i] >= 0 ? newIndices[m_ParentIndices[i]] : -1;
+			if (m_ParentIndices[i] >= 0 && parentIndex < 0)
+			{
+				transform->m_Parent = Entity{};
+				transform->m_LocalDirty = true;
+			}
+
+			newIndices[i] = static_cast<int32>(keptCount);
+			if (keptCount != i)
+			{
+				m_OrderedEntities[keptCount] = m_OrderedEntities[i];
+				m_Transforms[keptCount] = transform;
+				m_OrderIndices[m_OrderedEntities[keptCount].GetUniqueId()] = keptCount;
+			}
+
+			m_ParentIndices[keptCount] = parentIndex;
+			++keptCount;
+		}
+
+		m_OrderedEntities.resize(keptCount);
+		m_ParentIndices.resize(keptCount);
+		m_Transforms.resize(keptCount);
+	}
+
+	void TransformSystem::AppendTransform(const Entity _entity)
+	{
+		TransformComponent* const transform = _entity.GetComponent<TransformComponent>();
+		if (!transform || m_OrderIndices.contains(_entity.GetUniqueId()))
+		{
+			return;
+		}
+
+		// Appending the parent first keeps it ahead of its children. A parent without a transform turns the child into a root
+		int32 parentIndex{ -1 };
+		const Entity parent = transform->GetParent();
+		if (parent.IsValid())
+		{
+			AppendTransform(parent);
+			const auto orderIndex = m_OrderIndices.find(parent.GetUniqueId());
+			if (orderIndex != m_OrderIndices.end())
+			{
+				parentIndex = static_cast<int32>(orderIndex->second);
+			}
+			else
+			{
+				transform->m_Parent = Entity{};
+			}
+		}
+
+		// New transforms may come with world matrices and model versions of their own (e.g. from a snapshot)
+		transform->m_LocalDirty = true;
+		m_OrderIndices.emplace(_entity.GetUniqueId(), static_cast<uint32>(m_OrderedEntities.size()));
+		m_OrderedEntities.push_back(_entity);
+		m_ParentIndices.push_back(parentIndex);
+		m_Transforms.push_back(transform);
+	}
+} // End of Banshee namespace
\ No newline at end of file
@@ -0,0 +1,54 @@
+#pragma once
+
+#include "Foundation/Platform.h"
+#include "Foundation/Entity/View.h"
+#include "Graphics/Components/TransformComponent.h"
+#include "Foundation/Math/TransformKernel.h"
+#include <vector>
+#include <array>
+#include <unordered_map>
+
+namespace Banshee
+{
+	// Updates cached world matrices once per frame. Transforms are kept in hierarchy order (every parent before its children)
+	// so a single linear pass can propagate changes down the hierarchy. Only transforms whose local values changed, or whose
+	// parent's world matrix changed during the pass, are recomputed. Added transforms are appended after their parents and
+	// removed ones are compacted out, the order is only rebuilt when the hierarchy version says a transform was re-parented.
+	// Component addresses are cached with the order and re-fetched for an archetype only once its rows changed.
+	// Dirty local values are gathered into a TransformSoA and converted to matrices in one kernel call
+	class TransformSystem
+	{
+	public:
+		TransformSystem();
+		~TransformSystem();
+
+		void Update();
+
+		TransformSystem(const TransformSystem&) = delete;
+		TransformSystem(TransformSystem&&) = delete;
+		void operator=(const TransformSystem&) = delete;
+		void operator=(TransformSystem&&) = delete;
+
+	private:
+		void RebuildHierarchyOrder();
+		void RefreshTransformPointers();
+		void RemoveTransforms();
+		void AppendTransform(const Entity _entity);
+
+	private:
+		View<TransformComponent> m_TransformView;
+		std::vector<Entity> m_OrderedEntities;
+		std::vector<int32> m_ParentIndices;
+		std::vector<TransformComponent*> m_Transforms;
+		std::unordered_map<uint32, uint32> m_OrderIndices;
+		std::vector<uint32> m_ArchetypeRowVersions;
+		std::vector<Entity> m_AddedEntities;
+		std::vector<Entity> m_RemovedEntities;
+		std::vector<uint8> m_WorldChanged;
+		std::vector<uint32> m_DirtyIndices;
+		TransformSoA m_DirtyLocals;
+		std::vector<glm::mat4> m_LocalMatrices;
+		std::array<uint32, 2> m_EventSubscriptions;
+		uint32 m_HierarchyVersion;
+	};
+} // End of Banshee namespace
\ No newline at end of file
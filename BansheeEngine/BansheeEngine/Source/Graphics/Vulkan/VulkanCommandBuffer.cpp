@@ -5,7 +5,7 @@
 
 namespace Banshee
 {
-	VulkanCommandBuffer::VulkanCommandBuffer(const VkDevice& _logicalDevice, const VkCommandPool& _pool, const uint16 _count) :
+	VulkanCommandBuffer::VulkanCommandBuffer(const VkDevice& _logicalDevice, const VkCommandPool& _pool, const uint16 _count, const bool _secondary) :
 		m_LogicalDevice{ _logicalDevice },
 		m_CommandPool{ _pool },
 		m_CommandBuffers{ _count, VK_NULL_HANDLE }
@@ -15,7 +15,7 @@ namespace Banshee
 		VkCommandBufferAllocateInfo commandBufferAllocInfo{};
 		commandBufferAllocInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
 		commandBufferAllocInfo.commandPool = _pool;
-		commandBufferAllocInfo.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+		commandBufferAllocInfo.level = _secondary ? VK_COMMAND_BUFFER_LEVEL_SECONDARY : VK_COMMAND_BUFFER_LEVEL_PRIMARY;
 		commandBufferAllocInfo.commandBufferCount = _count;
 
 		if (vkAllocateCommandBuffers(_logicalDevice, &commandBufferAllocInfo, m_CommandBuffers.data()) != VK_SUCCESS)
@@ -40,6 +40,30 @@ namespace Banshee
 		vkBeginCommandBuffer(m_CommandBuffers[_bufferIndex], &beginInfo);
 	}
 
+	void VulkanCommandBuffer::BeginSecondary(const uint16 _bufferIndex, const uint32 _colorFormat, const uint32 _depthFormat) const noexcept
+	{
+		// Secondaries continue a dynamic rendering scope, so they inherit the attachment formats rather than a render pass
+		const VkFormat colorFormat{ static_cast<VkFormat>(_colorFormat) };
+
+		VkCommandBufferInheritanceRenderingInfo renderingInfo{};
+		renderingInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_INHERITANCE_RENDERING_INFO;
+		renderingInfo.colorAttachmentCount = 1;
+		renderingInfo.pColorAttachmentFormats = &colorFormat;
+		renderingInfo.depthAttachmentFormat = static_cast<VkFormat>(_depthFormat);
+		renderingInfo.rasterizationSamples = VK_SAMPLE_COUNT_1_BIT;
+
+		VkCommandBufferInheritanceInfo inheritanceInfo{};
+		inheritanceInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_INHERITANCE_INFO;
+		inheritanceInfo.pNext = &renderingInfo;
+
+		VkCommandBufferBeginInfo beginInfo{};
+		beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+		beginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT | VK_COMMAND_BUFFER_USAGE_RENDER_PASS_CONTINUE_BIT;
+		beginInfo.pInheritanceInfo = &inheritanceInfo;
+
+		vkBeginCommandBuffer(m_CommandBuffers[_bufferIndex], &beginInfo);
+	}
+
 	void VulkanCommandBuffer::End(const uint16 _bufferIndex) const noexcept
 	{
 		vkEndCommandBuffer(m_CommandBuffers[_bufferIndex]);
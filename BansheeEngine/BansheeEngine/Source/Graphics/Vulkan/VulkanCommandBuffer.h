@@ -15,10 +15,13 @@ namespace Banshee
 	class VulkanCommandBuffer
 	{
 	public:
-		VulkanCommandBuffer(const VkDevice& _logicalDevice, const VkCommandPool& _pool, const uint16 _count = 1);
+		// Secondary buffers can't be submitted on their own. They are recorded inside a render pass and executed from a primary buffer
+		VulkanCommandBuffer(const VkDevice& _logicalDevice, const VkCommandPool& _pool, const uint16 _count = 1, const bool _secondary = false);
 		~VulkanCommandBuffer();
 
 		void Begin(const uint16 _bufferIndex = 0) const noexcept;
+		// Begins a secondary buffer that continues the given render pass. Viewport, scissor and bound state are not inherited from the primary buffer
+		void BeginSecondary(const uint16 _bufferIndex, const uint32 _colorFormat, const uint32 _depthFormat) const noexcept;
 		void End(const uint16 _bufferIndex = 0) const noexcept;
 		void Submit(const uint16 _bufferIndex, const VkQueue& _queue, const VkSemaphore& _waitSem = nullptr, const VkSemaphore& _signalSem = nullptr, const VkFence& _fence = nullptr, const uint32 _waitStage = 0);
 		const std::vector<VkCommandBuffer>& Get() const noexcept { return m_CommandBuffers; }
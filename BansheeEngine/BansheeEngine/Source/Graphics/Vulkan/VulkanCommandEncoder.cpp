@@ -0,0 +1,148 @@
+#include "VulkanCommandEncoder.h"
+#include <vulkan/vulkan.h>
+#include <algorithm>
+#include <cstring>
+
+namespace Banshee
+{
+	VulkanCommandEncoder::VulkanCommandEncoder(const VkCommandBuffer& _commandBuffer) noexcept :
+		m_CommandBuffer{ _commandBuffer },
+		m_Pipeline{ VK_NULL_HANDLE },
+		m_VertexBuffer{ VK_NULL_HANDLE, 0 },
+		m_IndexBuffer{ VK_NULL_HANDLE, 0 },
+		m_DescriptorSets{},
+		m_PushConstantLayout{ VK_NULL_HANDLE },
+		m_PushConstantStages{ 0 },
+		m_PushConstants{},
+		m_PushConstantBegin{ 0 },
+		m_PushConstantEnd{ 0 },
+		m_Stats{}
+	{}
+
+	void VulkanCommandEncoder::BindPipeline(const VkPipeline& _pipeline) noexcept
+	{
+		if (m_Pipeline == _pipeline)
+		{
+			++m_Stats.m_ElidedBinds;
+			return;
+		}
+
+		vkCmdBindPipeline(m_CommandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, _pipeline);
+		m_Pipeline = _pipeline;
+		++m_Stats.m_PipelineBinds;
+	}
+
+	void VulkanCommandEncoder::BindVertexBuffer(const VkBuffer& _buffer, const uint64 _offset) noexcept
+	{
+		if (m_VertexBuffer.m_Buffer == _buffer && m_VertexBuffer.m_Offset == _offset)
+		{
+			++m_Stats.m_ElidedBinds;
+			return;
+		}
+
+		const VkDeviceSize offset = _offset;
+		vkCmdBindVertexBuffers(m_CommandBuffer, 0, 1, &_buffer, &offset);
+		m_VertexBuffer = { _buffer, _offset };
+		++m_Stats.m_VertexBufferBinds;
+	}
+
+	void VulkanCommandEncoder::BindIndexBuffer(const VkBuffer& _buffer, const uint64 _offset) noexcept
+	{
+		if (m_IndexBuffer.m_Buffer == _buffer && m_IndexBuffer.m_Offset == _offset)
+		{
+			++m_Stats.m_ElidedBinds;
+			return;
+		}
+
+		vkCmdBindIndexBuffer(m_CommandBuffer, _buffer, _offset, VK_INDEX_TYPE_UINT32);
+		m_IndexBuffer = { _buffer, _offset };
+		++m_Stats.m_IndexBufferBinds;
+	}
+
+	void VulkanCommandEncoder::BindDescriptorSet(const VkPipelineLayout& _layout, const uint32 _set, const VkDescriptorSet& _descriptorSet, std::span<const uint32> _dynamicOffsets) noexcept
+	{
+		// Sets beyond what is tracked, or with more dynamic offsets than fit, are always bound
+		const bool tracked = _set < s_MaxTrackedSets && _dynamicOffsets.size() <= s_MaxTrackedDynamicOffsets;
+		if (tracked)
+		{
+			const BoundDescriptorSet& bound = m_DescriptorSets[_set];
+			if (bound.m_Layout == _layout && bound.m_Set == _descriptorSet && bound.m_DynamicOffsetCount == _dynamicOffsets.size() &&
+				std::equal(_dynamicOffsets.begin(), _dynamicOffsets.end(), bound.m_DynamicOffsets.begin()))
+			{
+				++m_Stats.m_ElidedBinds;
+				return;
+			}
+		}
+
+		vkCmdBindDescriptorSets(m_CommandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, _layout, _set, 1, &_descriptorSet, static_cast<uint32>(_dynamicOffsets.size()), _dynamicOffsets.data());
+		++m_Stats.m_DescriptorSetBinds;
+
+		// Binding a set disturbs the sets after it when their layouts aren't compatible, so those are forgotten
+		for (uint32 set = _set + 1; set < s_MaxTrackedSets; ++set)
+		{
+			m_DescriptorSets[set] = {};
+		}
+
+		if (tracked)
+		{
+			BoundDescriptorSet& bound = m_DescriptorSets[_set];
+			bound.m_Layout = _layout;
+			bound.m_Set = _descriptorSet;
+			bound.m_DynamicOffsetCount = static_cast<uint32>(_dynamicOffsets.size());
+			std::copy(_dynamicOffsets.begin(), _dynamicOffsets.end(), bound.m_DynamicOffsets.begin());
+		}
+	}
+
+	void VulkanCommandEncoder::PushConstants(const VkPipelineLayout& _layout, const uint32 _stageFlags, const uint32 _offset, const uint32 _size, const void* const _data) noexcept
+	{
+		const bool tracked = _offset + _size <= s_MaxTrackedPushConstantBytes;
+		if (tracked && m_PushConstantLayout == _layout && m_PushConstantStages == _stageFlags && _offset >= m_PushConstantBegin && _offset + _size <= m_PushConstantEnd &&
+			std::memcmp(m_PushConstants.data() + _offset, _data, _size) == 0)
+		{
+			++m_Stats.m_ElidedBinds;
+			return;
+		}
+
+		vkCmdPushConstants(m_CommandBuffer, _layout, _stageFlags, _offset, _size, _data);
+		++m_Stats.m_PushConstantUpdates;
+
+		if (!tracked)
+		{
+			m_PushConstantLayout = VK_NULL_HANDLE;
+			return;
+		}
+
+		// Values pushed with another layout or stage mask are not known to still apply, so tracking restarts from this range
+		if (m_PushConstantLayout != _layout || m_PushConstantStages != _stageFlags || m_PushConstantBegin == m_PushConstantEnd)
+		{
+			m_PushConstantLayout = _layout;
+			m_PushConstantStages = _stageFlags;
+			m_PushConstantBegin = _offset;
+			m_PushConstantEnd = _offset + _size;
+		}
+		else if (_offset <= m_PushConstantEnd && _offset + _size >= m_PushConstantBegin)
+		{
+			m_PushConstantBegin = std::min(m_PushConstantBegin, _offset);
+			m_PushConstantEnd = std::max(m_PushConstantEnd, _offset + _size);
+		}
+		else
+		{
+			m_PushConstantBegin = _offset;
+			m_PushConstantEnd = _offset + _size;
+		}
+
+		std::memcpy(m_PushConstants.data() + _offset, _data, _size);
+	}
+
+	void VulkanCommandEncoder::DrawIndexed(const uint32 _indexCount, const uint32 _instanceCount, const uint32 _firstIndex, const int32 _vertexOffset, const uint32 _firstInstance) noexcept
+	{
+		vkCmdDrawIndexed(m_CommandBuffer, _indexCount, _instanceCount, _firstIndex, _vertexOffset, _firstInstance);
+		++m_Stats.m_Draws;
+	}
+
+	void VulkanCommandEncoder::DrawIndexedIndirectCount(const VkBuffer& _buffer, const uint64 _offset, const VkBuffer& _countBuffer, const uint64 _countOffset, const uint32 _maxDrawCount, const uint32 _stride) noexcept
+	{
+		vkCmdDrawIndexedIndirectCount(m_CommandBuffer, _buffer, _offset, _countBuffer, _countOffset, _maxDrawCount, _stride);
+		++m_Stats.m_Draws;
+	}
+} // End of Banshee namespace
\ No newline at end of file
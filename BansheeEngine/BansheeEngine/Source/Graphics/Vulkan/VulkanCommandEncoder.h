@@ -0,0 +1,98 @@
+#pragma once
+
+#include "Foundation/Platform.h"
+#include <array>
+#include <span>
+
+typedef struct VkCommandBuffer_T* VkCommandBuffer;
+typedef struct VkPipeline_T* VkPipeline;
+typedef struct VkPipelineLayout_T* VkPipelineLayout;
+typedef struct VkBuffer_T* VkBuffer;
+typedef struct VkDescriptorSet_T* VkDescriptorSet;
+
+namespace Banshee
+{
+	// State changes issued and binds dropped as redundant, summed over every encoder of a frame
+	struct CommandEncoderStats
+	{
+		CommandEncoderStats& operator+=(const CommandEncoderStats& _other) noexcept
+		{
+			m_PipelineBinds += _other.m_PipelineBinds;
+			m_VertexBufferBinds += _other.m_VertexBufferBinds;
+			m_IndexBufferBinds += _other.m_IndexBufferBinds;
+			m_DescriptorSetBinds += _other.m_DescriptorSetBinds;
+			m_PushConstantUpdates += _other.m_PushConstantUpdates;
+			m_Draws += _other.m_Draws;
+			m_ElidedBinds += _other.m_ElidedBinds;
+			return *this;
+		}
+
+		uint32 m_PipelineBinds{ 0 };
+		uint32 m_VertexBufferBinds{ 0 };
+		uint32 m_IndexBufferBinds{ 0 };
+		uint32 m_DescriptorSetBinds{ 0 };
+		uint32 m_PushConstantUpdates{ 0 };
+		uint32 m_Draws{ 0 };
+		uint32 m_ElidedBinds{ 0 };
+	};
+
+	// Records graphics commands into a command buffer while remembering what is bound, so binds of state that is already current are dropped.
+	// The encoder assumes it sees every bind of the buffer, so one encoder is used per command buffer and recording thread
+	class VulkanCommandEncoder
+	{
+	public:
+		explicit VulkanCommandEncoder(const VkCommandBuffer& _commandBuffer) noexcept;
+		~VulkanCommandEncoder() = default;
+
+		void BindPipeline(const VkPipeline& _pipeline) noexcept;
+		void BindVertexBuffer(const VkBuffer& _buffer, const uint64 _offset) noexcept;
+		void BindIndexBuffer(const VkBuffer& _buffer, const uint64 _offset) noexcept;
+		// Sets bound with a different layout are always rebound, as the encoder doesn't check layout compatibility
+		void BindDescriptorSet(const VkPipelineLayout& _layout, const uint32 _set, const VkDescriptorSet& _descriptorSet, std::span<const uint32> _dynamicOffsets) noexcept;
+		void PushConstants(const VkPipelineLayout& _layout, const uint32 _stageFlags, const uint32 _offset, const uint32 _size, const void* const _data) noexcept;
+
+		void DrawIndexed(const uint32 _indexCount, const uint32 _instanceCount, const uint32 _firstIndex, const int32 _vertexOffset, const uint32 _firstInstance) noexcept;
+		void DrawIndexedIndirectCount(const VkBuffer& _buffer, const uint64 _offset, const VkBuffer& _countBuffer, const uint64 _countOffset, const uint32 _maxDrawCount, const uint32 _stride) noexcept;
+
+		VkCommandBuffer Get() const noexcept { return m_CommandBuffer; }
+		const CommandEncoderStats& GetStats() const noexcept { return m_Stats; }
+
+		VulkanCommandEncoder(const VulkanCommandEncoder&) = delete;
+		VulkanCommandEncoder& operator=(const VulkanCommandEncoder&) = delete;
+		VulkanCommandEncoder(VulkanCommandEncoder&&) = delete;
+		VulkanCommandEncoder& operator=(VulkanCommandEncoder&&) = delete;
+
+	private:
+		static constexpr uint32 s_MaxTrackedSets{ 4 };
+		static constexpr uint32 s_MaxTrackedDynamicOffsets{ 8 };
+		static constexpr uint32 s_MaxTrackedPushConstantBytes{ 128 };
+
+		struct BoundDescriptorSet
+		{
+			VkPipelineLayout m_Layout;
+			VkDescriptorSet m_Set;
+			std::array<uint32, s_MaxTrackedDynamicOffsets> m_DynamicOffsets;
+			uint32 m_DynamicOffsetCount;
+		};
+
+		struct BoundBuffer
+		{
+			VkBuffer m_Buffer;
+			uint64 m_Offset;
+		};
+
+	private:
+		VkCommandBuffer m_CommandBuffer;
+		VkPipeline m_Pipeline;
+		BoundBuffer m_VertexBuffer;
+		BoundBuffer m_IndexBuffer;
+		std::array<BoundDescriptorSet, s_MaxTrackedSets> m_DescriptorSets;
+		VkPipelineLayout m_PushConstantLayout;
+		uint32 m_PushConstantStages;
+		std::array<uint8, s_MaxTrackedPushConstantBytes> m_PushConstants;
+		// Bytes of m_PushConstants holding the last pushed values, [m_PushConstantBegin, m_PushConstantEnd)
+		uint32 m_PushConstantBegin;
+		uint32 m_PushConstantEnd;
+		CommandEncoderStats m_Stats;
+	};
+} // End of Banshee namespace
\ No newline at end of file
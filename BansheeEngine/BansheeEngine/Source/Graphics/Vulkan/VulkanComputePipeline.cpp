@@ -0,0 +1,65 @@
+#include "VulkanComputePipeline.h"
+#include "VulkanUtils.h"
+#include "Foundation/ResourceManager/ResourceManager.h"
+#include "Foundation/Logging/Logger.h"
+#include <vulkan/vulkan.h>
+#include <stdexcept>
+
+namespace Banshee
+{
+	VulkanComputePipeline::VulkanComputePipeline(const VkDevice& _logicalDevice, const VkDescriptorSetLayout& _descriptorSetLayout, const uint32 _pushConstantSize, const char* _shaderPath) :
+		m_LogicalDevice{ _logicalDevice },
+		m_PipelineLayout{ VK_NULL_HANDLE },
+		m_ComputePipeline{ VK_NULL_HANDLE }
+	{
+		BE_LOG(LogCategory::Trace, "[COMPUTE PIPELINE]: Creating compute pipeline using shader %s", _shaderPath);
+
+		auto shaderBinary = g_ResourceManager.ReadBinaryFile(_shaderPath);
+		VkShaderModule shaderModule = VulkanUtils::CreateShaderModule(_logicalDevice, shaderBinary);
+
+		VkPushConstantRange pushConstantRange{};
+		pushConstantRange.offset = 0;
+		pushConstantRange.size = _pushConstantSize;
+		pushConstantRange.stageFlags = VK_SHADER_STAGE_COMPUTE_BIT;
+
+		VkPipelineLayoutCreateInfo pipelineLayoutCreateInfo{};
+		pipelineLayoutCreateInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
+		pipelineLayoutCreateInfo.pushConstantRangeCount = _pushConstantSize > 0 ? 1 : 0;
+		pipelineLayoutCreateInfo.pPushConstantRanges = _pushConstantSize > 0 ? &pushConstantRange : nullptr;
+		pipelineLayoutCreateInfo.setLayoutCount = 1;
+		pipelineLayoutCreateInfo.pSetLayouts = &_descriptorSetLayout;
+
+		if (vkCreatePipelineLayout(_logicalDevice, &pipelineLayoutCreateInfo, nullptr, &m_PipelineLayout) != VK_SUCCESS)
+		{
+			throw std::runtime_error("ERROR: Failed to create a compute pipeline layout");
+		}
+
+		VkComputePipelineCreateInfo computePipelineCreateInfo{};
+		computePipelineCreateInfo.sType = VK_STRUCTURE_TYPE_COMPUTE_PIPELINE_CREATE_INFO;
+		computePipelineCreateInfo.stage.sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
+		computePipelineCreateInfo.stage.stage = VK_SHADER_STAGE_COMPUTE_BIT;
+		computePipelineCreateInfo.stage.module = shaderModule;
+		computePipelineCreateInfo.stage.pName = "main";
+		computePipelineCreateInfo.layout = m_PipelineLayout;
+		computePipelineCreateInfo.basePipelineHandle = VK_NULL_HANDLE;
+		computePipelineCreateInfo.basePipelineIndex = -1;
+
+		if (vkCreateComputePipelines(_logicalDevice, VK_NULL_HANDLE, 1, &computePipelineCreateInfo, nullptr, &m_ComputePipeline) != VK_SUCCESS)
+		{
+			throw std::runtime_error("ERROR: Failed to create a compute pipeline");
+		}
+
+		vkDestroyShaderModule(_logicalDevice, shaderModule, nullptr);
+
+		BE_LOG(LogCategory::Info, "[COMPUTE PIPELINE]: Created compute pipeline");
+	}
+
+	VulkanComputePipeline::~VulkanComputePipeline()
+	{
+		vkDestroyPipeline(m_LogicalDevice, m_ComputePipeline, nullptr);
+		m_ComputePipeline = VK_NULL_HANDLE;
+
+		vkDestroyPipelineLayout(m_LogicalDevice, m_PipelineLayout, nullptr);
+		m_PipelineLayout = VK_NULL_HANDLE;
+	}
+} // End of Banshee namespace
\ No newline at end of file
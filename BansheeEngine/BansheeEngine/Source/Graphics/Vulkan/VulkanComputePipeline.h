@@ -0,0 +1,32 @@
+#pragma once
+
+#include "Foundation/Platform.h"
+
+typedef struct VkDevice_T* VkDevice;
+typedef struct VkPipelineLayout_T* VkPipelineLayout;
+typedef struct VkPipeline_T* VkPipeline;
+typedef struct VkDescriptorSetLayout_T* VkDescriptorSetLayout;
+
+namespace Banshee
+{
+	class VulkanComputePipeline
+	{
+	public:
+		// _pushConstantSize may be 0. Push constants are visible to the compute stage only
+		VulkanComputePipeline(const VkDevice& _logicalDevice, const VkDescriptorSetLayout& _descriptorSetLayout, const uint32 _pushConstantSize, const char* _shaderPath);
+		~VulkanComputePipeline();
+
+		VkPipeline Get() const noexcept { return m_ComputePipeline; }
+		VkPipelineLayout GetLayout() const noexcept { return m_PipelineLayout; }
+
+		VulkanComputePipeline(const VulkanComputePipeline&) = delete;
+		VulkanComputePipeline& operator=(const VulkanComputePipeline&) = delete;
+		VulkanComputePipeline(VulkanComputePipeline&&) = delete;
+		VulkanComputePipeline& operator=(VulkanComputePipeline&&) = delete;
+
+	private:
+		VkDevice m_LogicalDevice;
+		VkPipelineLayout m_PipelineLayout;
+		VkPipeline m_ComputePipeline;
+	};
+} // End of Banshee namespace
\ No newline at end of file
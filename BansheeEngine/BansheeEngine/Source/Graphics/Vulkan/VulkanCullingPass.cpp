@@ -0,0 +1,247 @@
+#include "VulkanCullingPass.h"
+#include "VulkanDepthPyramid.h"
+#include "VulkanUtils.h"
+#include "Foundation/Logging/Logger.h"
+#include <vulkan/vulkan.h>
+#include <stdexcept>
+
+namespace Banshee
+{
+	constexpr static uint32 g_CullingGroupSize{ 64 };
+	constexpr static uint32 g_CullingBindingCount{ 5 };
+	constexpr static uint32 g_OcclusionBindingCount{ 8 };
+
+	VulkanCullingPass::VulkanCullingPass(const VkDevice& _logicalDevice, const VkPhysicalDevice& _gpu, const VkBuffer& _buffer, const uint64 _alignment, const uint64 _maxObjects,
+		const VulkanDepthPyramid* _depthPyramid) :
+		m_LogicalDevice{ _logicalDevice },
+		m_UploadBuffer{ _buffer },
+		m_SceneBuffer{ VK_NULL_HANDLE },
+		m_SceneBufferMemory{ VK_NULL_HANDLE },
+		m_BatchesOffset{ 0 },
+		m_LateBatchesOffset{ 0 },
+		m_CopyRegions{},
+		m_DescriptorSetLayout{ VK_NULL_HANDLE },
+		m_DescriptorPool{ VK_NULL_HANDLE },
+		m_DescriptorSet{ VK_NULL_HANDLE },
+		m_OcclusionCulling{ _depthPyramid != nullptr },
+		m_CullPipeline{ nullptr },
+		m_CompactPipeline{ nullptr }
+	{
+		BE_LOG(LogCategory::Trace, "[CULLING PASS]: Creating culling pass");
+
+		// Batch regions start at offsets that can be bound as dynamic storage buffer offsets
+		const uint64 objectsSize = sizeof(CullObject) * _maxObjects;
+		const uint64 batchesSize = sizeof(DrawBatch) * _maxObjects;
+		const uint64 alignedObjectsSize = (objectsSize + _alignment - 1) & ~(_alignment - 1);
+		const uint64 alignedBatchesSize = (batchesSize + _alignment - 1) & ~(_alignment - 1);
+		m_BatchesOffset = static_cast<uint32>(alignedObjectsSize);
+		m_LateBatchesOffset = m_OcclusionCulling ? static_cast<uint32>(alignedObjectsSize + alignedBatchesSize) : m_BatchesOffset;
+
+		VulkanUtils::CreateBuffer
+		(
+			_logicalDevice,
+			_gpu,
+			m_LateBatchesOffset + batchesSize,
+			VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+			VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
+			m_SceneBuffer,
+			m_SceneBufferMemory
+		);
+
+		// Objects, batches, instances, draw commands and draw counts. Occlusion culling adds the occlusion data, the depth pyramid and the visibility flags
+		const uint32 bindingCount = m_OcclusionCulling ? g_OcclusionBindingCount : g_CullingBindingCount;
+		std::array<VkDescriptorSetLayoutBinding, g_OcclusionBindingCount> layoutBindings{};
+		for (uint32 binding = 0; binding < g_OcclusionBindingCount; ++binding)
+		{
+			layoutBindings[binding].binding = binding;
+			layoutBindings[binding].descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER_DYNAMIC;
+			layoutBindings[binding].descriptorCount = 1;
+			layoutBindings[binding].stageFlags = VK_SHADER_STAGE_COMPUTE_BIT;
+			layoutBindings[binding].pImmutableSamplers = nullptr;
+		}
+		layoutBindings[5].descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC;
+		layoutBindings[6].descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+
+		VkDescriptorSetLayoutCreateInfo layoutCreateInfo{};
+		layoutCreateInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
+		layoutCreateInfo.bindingCount = bindingCount;
+		layoutCreateInfo.pBindings = layoutBindings.data();
+
+		if (vkCreateDescriptorSetLayout(_logicalDevice, &layoutCreateInfo, nullptr, &m_DescriptorSetLayout) != VK_SUCCESS)
+		{
+			throw std::runtime_error("ERROR: Failed to create the culling descriptor set layout");
+		}
+
+		std::array<VkDescriptorPoolSize, 3> poolSizes{};
+		poolSizes[0].type = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER_DYNAMIC;
+		poolSizes[0].descriptorCount = m_OcclusionCulling ? g_CullingBindingCount + 1 : g_CullingBindingCount;
+		poolSizes[1].type = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC;
+		poolSizes[1].descriptorCount = 1;
+		poolSizes[2].type = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+		poolSizes[2].descriptorCount = 1;
+
+		VkDescriptorPoolCreateInfo poolCreateInfo{};
+		poolCreateInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
+		poolCreateInfo.maxSets = 1;
+		poolCreateInfo.poolSizeCount = m_OcclusionCulling ? static_cast<uint32>(poolSizes.size()) : 1;
+		poolCreateInfo.pPoolSizes = poolSizes.data();
+
+		if (vkCreateDescriptorPool(_logicalDevice, &poolCreateInfo, nullptr, &m_DescriptorPool) != VK_SUCCESS)
+		{
+			throw std::runtime_error("ERROR: Failed to create the culling descriptor pool");
+		}
+
+		VkDescriptorSetAllocateInfo allocInfo{};
+		allocInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+		allocInfo.descriptorPool = m_DescriptorPool;
+		allocInfo.descriptorSetCount = 1;
+		allocInfo.pSetLayouts = &m_DescriptorSetLayout;
+
+		if (vkAllocateDescriptorSets(_logicalDevice, &allocInfo, &m_DescriptorSet) != VK_SUCCESS)
+		{
+			throw std::runtime_error("ERROR: Failed to allocate the culling descriptor set");
+		}
+
+		// Every binding covers the largest range a frame can use. The frame's allocations and the phase's batches are selected with dynamic offsets
+		const std::array<uint64, g_OcclusionBindingCount> ranges =
+		{
+			objectsSize,
+			batchesSize,
+			sizeof(InstanceData) * _maxObjects,
+			sizeof(DrawBatch) * _maxObjects,
+			sizeof(uint32) * _maxObjects,
+			sizeof(OcclusionData),
+			0,
+			sizeof(uint32) * _maxObjects
+		};
+
+		std::array<VkDescriptorBufferInfo, g_OcclusionBindingCount> bufferInfos{};
+		std::array<VkWriteDescriptorSet, g_OcclusionBindingCount> descriptorWrites{};
+		for (uint32 binding = 0; binding < bindingCount; ++binding)
+		{
+			bufferInfos[binding].buffer = binding < 2 ? m_SceneBuffer : _buffer;
+			bufferInfos[binding].offset = 0;
+			bufferInfos[binding].range = ranges[binding];
+
+			descriptorWrites[binding].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+			descriptorWrites[binding].dstSet = m_DescriptorSet;
+			descriptorWrites[binding].dstBinding = binding;
+			descriptorWrites[binding].descriptorCount = 1;
+			descriptorWrites[binding].descriptorType = layoutBindings[binding].descriptorType;
+			descriptorWrites[binding].pBufferInfo = &bufferInfos[binding];
+		}
+
+		// The culling shader reads the pyramid in the layout it's kept in between frames
+		VkDescriptorImageInfo pyramidInfo{};
+		if (m_OcclusionCulling)
+		{
+			pyramidInfo.sampler = _depthPyramid->GetSampler();
+			pyramidInfo.imageView = _depthPyramid->GetImageView();
+			pyramidInfo.imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+			descriptorWrites[6].pBufferInfo = nullptr;
+			descriptorWrites[6].pImageInfo = &pyramidInfo;
+		}
+
+		vkUpdateDescriptorSets(_logicalDevice, bindingCount, descriptorWrites.data(), 0, nullptr);
+
+		m_CullPipeline = std::make_unique<VulkanComputePipeline>(_logicalDevice, m_DescriptorSetLayout, static_cast<uint32>(sizeof(CullingConstants)),
+			m_OcclusionCulling ? "Shaders/Culling/cull_occlusion_comp.spv" : "Shaders/Culling/cull_comp.spv");
+		m_CompactPipeline = std::make_unique<VulkanComputePipeline>(_logicalDevice, m_DescriptorSetLayout, static_cast<uint32>(sizeof(CullingConstants)), "Shaders/Culling/compact_draws_comp.spv");
+
+		BE_LOG(LogCategory::Info, "[CULLING PASS]: Created culling pass");
+	}
+
+	VulkanCullingPass::~VulkanCullingPass()
+	{
+		m_CompactPipeline.reset();
+		m_CullPipeline.reset();
+
+		vkDestroyDescriptorPool(m_LogicalDevice, m_DescriptorPool, nullptr);
+		m_DescriptorPool = VK_NULL_HANDLE;
+
+		vkDestroyDescriptorSetLayout(m_LogicalDevice, m_DescriptorSetLayout, nullptr);
+		m_DescriptorSetLayout = VK_NULL_HANDLE;
+
+		vkDestroyBuffer(m_LogicalDevice, m_SceneBuffer, nullptr);
+		m_SceneBuffer = VK_NULL_HANDLE;
+
+		vkFreeMemory(m_LogicalDevice, m_SceneBufferMemory, nullptr);
+		m_SceneBufferMemory = VK_NULL_HANDLE;
+	}
+
+	void VulkanCullingPass::RecordUploads(const VkCommandBuffer& _cmdBuffer, const std::vector<CullingUpload>& _objects, const std::vector<CullingUpload>& _batches)
+	{
+		if (_objects.empty() && _batches.empty())
+		{
+			return;
+		}
+
+		m_CopyRegions.clear();
+		for (const CullingUpload& upload : _objects)
+		{
+			m_CopyRegions.push_back({ upload.m_SrcOffset, static_cast<uint64>(upload.m_First) * sizeof(CullObject), static_cast<uint64>(upload.m_Count) * sizeof(CullObject) });
+		}
+
+		for (const CullingUpload& upload : _batches)
+		{
+			m_CopyRegions.push_back({ upload.m_SrcOffset, m_BatchesOffset + static_cast<uint64>(upload.m_First) * sizeof(DrawBatch), static_cast<uint64>(upload.m_Count) * sizeof(DrawBatch) });
+			if (m_OcclusionCulling)
+			{
+				m_CopyRegions.push_back({ upload.m_SrcOffset, m_LateBatchesOffset + static_cast<uint64>(upload.m_First) * sizeof(DrawBatch), static_cast<uint64>(upload.m_Count) * sizeof(DrawBatch) });
+			}
+		}
+
+		// Earlier frames' culling still reads the objects and clears the batches' instance counts
+		VkMemoryBarrier barrier{};
+		barrier.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+		barrier.srcAccessMask = VK_ACCESS_SHADER_WRITE_BIT;
+		barrier.dstAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+		vkCmdPipelineBarrier(_cmdBuffer, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT, 0, 1, &barrier, 0, nullptr, 0, nullptr);
+
+		vkCmdCopyBuffer(_cmdBuffer, m_UploadBuffer, m_SceneBuffer, static_cast<uint32>(m_CopyRegions.size()), m_CopyRegions.data());
+
+		barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+		barrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT;
+		vkCmdPipelineBarrier(_cmdBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, 0, 1, &barrier, 0, nullptr, 0, nullptr);
+	}
+
+	void VulkanCullingPass::Record(const VkCommandBuffer& _cmdBuffer, const std::array<uint32, 5>& _dynamicOffsets, const CullingConstants& _constants) const noexcept
+	{
+		const std::array<uint32, g_OcclusionBindingCount - 1> dynamicOffsets =
+		{
+			0,
+			_constants.m_Phase == 0 ? m_BatchesOffset : m_LateBatchesOffset,
+			_dynamicOffsets[0],
+			_dynamicOffsets[1],
+			_dynamicOffsets[2],
+			_dynamicOffsets[3],
+			_dynamicOffsets[4]
+		};
+
+		// Both pipelines share the descriptor set layout and push constant range, so the set and constants are bound once.
+		// Only the storage and uniform buffer bindings take dynamic offsets
+		vkCmdBindPipeline(_cmdBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, m_CullPipeline->Get());
+		vkCmdBindDescriptorSets(_cmdBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, m_CullPipeline->GetLayout(), 0, 1, &m_DescriptorSet,
+			m_OcclusionCulling ? static_cast<uint32>(dynamicOffsets.size()) : g_CullingBindingCount, dynamicOffsets.data());
+		vkCmdPushConstants(_cmdBuffer, m_CullPipeline->GetLayout(), VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof(CullingConstants), &_constants);
+		vkCmdDispatch(_cmdBuffer, (_constants.m_ObjectCount + g_CullingGroupSize - 1) / g_CullingGroupSize, 1, 1);
+
+		// The instance counts written by the cull dispatch are read and cleared by the compaction
+		VkMemoryBarrier barrier{};
+		barrier.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+		barrier.srcAccessMask = VK_ACCESS_SHADER_WRITE_BIT;
+		barrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT;
+		vkCmdPipelineBarrier(_cmdBuffer, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, 0, 1, &barrier, 0, nullptr, 0, nullptr);
+
+		vkCmdBindPipeline(_cmdBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, m_CompactPipeline->Get());
+		vkCmdDispatch(_cmdBuffer, (_constants.m_BatchCount + g_CullingGroupSize - 1) / g_CullingGroupSize, 1, 1);
+
+		// Draw commands and counts are consumed as indirect arguments, compacted instances by the vertex shaders.
+		// The visibility flags of the first phase are read by the second. The host reads the commands and counts back for the culling stats
+		const VkPipelineStageFlags dstStages = VK_PIPELINE_STAGE_DRAW_INDIRECT_BIT | VK_PIPELINE_STAGE_VERTEX_SHADER_BIT | VK_PIPELINE_STAGE_HOST_BIT |
+			(m_OcclusionCulling ? VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT : 0);
+		barrier.srcAccessMask = VK_ACCESS_SHADER_WRITE_BIT;
+		barrier.dstAccessMask = VK_ACCESS_INDIRECT_COMMAND_READ_BIT | VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_HOST_READ_BIT;
+		vkCmdPipelineBarrier(_cmdBuffer, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, dstStages, 0, 1, &barrier, 0, nullptr, 0, nullptr);
+	}
+} // End of Banshee namespace
\ No newline at end of file
@@ -0,0 +1,125 @@
+#pragma once
+
+#include "VulkanComputePipeline.h"
+#include "Foundation/Platform.h"
+#include "Graphics/MVP.h"
+#include <glm/glm.hpp>
+#include <array>
+#include <memory>
+#include <vector>
+
+typedef struct VkDevice_T* VkDevice;
+typedef struct VkPhysicalDevice_T* VkPhysicalDevice;
+typedef struct VkBuffer_T* VkBuffer;
+typedef struct VkDeviceMemory_T* VkDeviceMemory;
+typedef struct VkCommandBuffer_T* VkCommandBuffer;
+typedef struct VkDescriptorSetLayout_T* VkDescriptorSetLayout;
+typedef struct VkDescriptorPool_T* VkDescriptorPool;
+typedef struct VkDescriptorSet_T* VkDescriptorSet;
+struct VkBufferCopy;
+
+namespace Banshee
+{
+	class VulkanDepthPyramid;
+
+	// The structs below mirror the std430 declarations in Res/Shaders/Culling
+
+	// Every drawn sub-mesh instance with its local bounding sphere (center, radius) and the batch it belongs to
+	struct CullObject
+	{
+		InstanceData m_Instance;
+		glm::vec4 m_BoundingSphere;
+		uint32 m_Batch;
+		uint32 m_Padding[3];
+	};
+
+	// All instances of one sub-mesh of one mesh. The first five members form a VkDrawIndexedIndirectCommand, so a batch is used as is
+	// for indirect draws with a stride of sizeof(DrawBatch). Batches sharing pipeline and mesh form a group drawn by one indirect count call
+	struct DrawBatch
+	{
+		uint32 m_IndexCount;
+		uint32 m_InstanceCount;   // Uploaded as zero, incremented by the culling shader for every visible instance and cleared again by the compaction
+		uint32 m_FirstIndex;
+		int32 m_VertexOffset;
+		uint32 m_FirstInstance;
+		uint32 m_Group;
+		uint32 m_GroupFirstBatch;
+		uint32 m_Padding;
+
+		bool operator==(const DrawBatch&) const noexcept = default;
+	};
+
+	struct CullingConstants
+	{
+		std::array<glm::vec4, 6> m_FrustumPlanes;
+		uint32 m_ObjectCount;
+		uint32 m_BatchCount;
+		uint32 m_Phase;                   // The remaining members are only read with occlusion culling
+		uint32 m_OcclusionTest;
+		uint32 m_FirstTranslucentBatch;
+	};
+
+	// Camera and depth pyramid the occlusion test projects bounding spheres with (std140)
+	struct OcclusionData
+	{
+		glm::mat4 m_View;
+		glm::vec4 m_Projection;      // P00, P11, P22 and P32 of the projection before the y flip
+		glm::vec4 m_PyramidParams;   // Width, height, mip count, camera near plane
+	};
+
+	// Run of consecutive objects or batches staged in the frame allocator's buffer at m_SrcOffset, copied to the scene buffer starting at entry m_First
+	struct CullingUpload
+	{
+		uint32 m_SrcOffset;
+		uint32 m_First;
+		uint32 m_Count;
+	};
+
+	// GPU-driven culling. The first dispatch tests every CullObject against the frustum and compacts the visible instances into their batch's
+	// range of the instance buffer. The second writes each non-empty batch into its group's range of the draw command buffer and counts
+	// the draws per group, ready for vkCmdDrawIndexedIndirectCount.
+	// Objects and batches persist across frames in a device-local scene buffer owned by the pass, and only the entries that changed are copied into it.
+	// Instances, draw commands and counts are sub-allocated from the frame allocator's buffer and bound with dynamic offsets, so one descriptor set serves every frame.
+	// With a depth pyramid, culling runs in two phases. The first tests the opaque objects against the pyramid of the previous frame and
+	// flags what it kept. Once that's drawn and the pyramid rebuilt from its depth, the second tests every unflagged object against it, so
+	// objects rejected because the previous frame was out of date still get drawn in the same frame
+	class VulkanCullingPass
+	{
+	public:
+		// _buffer is the frame allocator's buffer and _alignment its allocation alignment.
+		// A non-null _depthPyramid enables the occlusion test and has to outlive the pass
+		VulkanCullingPass(const VkDevice& _logicalDevice, const VkPhysicalDevice& _gpu, const VkBuffer& _buffer, const uint64 _alignment, const uint64 _maxObjects,
+			const VulkanDepthPyramid* _depthPyramid = nullptr);
+		~VulkanCullingPass();
+
+		// Copies objects and batches staged in the frame allocator's buffer into the scene buffer, batches into those of both phases.
+		// Has to be recorded before this frame's culling, and orders the copies after the culling of earlier frames
+		void RecordUploads(const VkCommandBuffer& _cmdBuffer, const std::vector<CullingUpload>& _objects, const std::vector<CullingUpload>& _batches);
+		// _dynamicOffsets are the frame's instance, draw command, draw count, occlusion data and visibility flag allocations, in that order.
+		// The last two are ignored without a depth pyramid. The constants' phase selects which batches are filled
+		void Record(const VkCommandBuffer& _cmdBuffer, const std::array<uint32, 5>& _dynamicOffsets, const CullingConstants& _constants) const noexcept;
+		bool HasOcclusionCulling() const noexcept { return m_OcclusionCulling; }
+
+		VulkanCullingPass(const VulkanCullingPass&) = delete;
+		VulkanCullingPass& operator=(const VulkanCullingPass&) = delete;
+		VulkanCullingPass(VulkanCullingPass&&) = delete;
+		VulkanCullingPass& operator=(VulkanCullingPass&&) = delete;
+
+	private:
+		VkDevice m_LogicalDevice;
+		VkBuffer m_UploadBuffer;
+		// Objects, then the batches of the first phase, then those of the second with occlusion culling
+		VkBuffer m_SceneBuffer;
+		VkDeviceMemory m_SceneBufferMemory;
+		uint32 m_BatchesOffset;
+		uint32 m_LateBatchesOffset;
+		// Scratch, kept as a member so its capacity is reused
+		std::vector<VkBufferCopy> m_CopyRegions;
+		VkDescriptorSetLayout m_DescriptorSetLayout;
+		VkDescriptorPool m_DescriptorPool;
+		VkDescriptorSet m_DescriptorSet;
+		bool m_OcclusionCulling;
+		std::unique_ptr<VulkanComputePipeline> m_CullPipeline;
+		std::unique_ptr<VulkanComputePipeline> m_CompactPipeline;
+	};
+} // End of Banshee namespace
\ No newline at end of file
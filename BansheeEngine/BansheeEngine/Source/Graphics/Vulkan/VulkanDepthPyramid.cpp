@@ -0,0 +1,225 @@
+#include "VulkanDepthPyramid.h"
+#include "VulkanUtils.h"
+#include "Foundation/Logging/Logger.h"
+#include <vulkan/vulkan.h>
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <stdexcept>
+
+namespace Banshee
+{
+	constexpr static uint32 g_DepthPyramidGroupSize{ 8 };
+
+	VulkanDepthPyramid::VulkanDepthPyramid(const VkDevice& _logicalDevice, const VkPhysicalDevice& _gpu, const VkCommandPool& _commandPool, const VkQueue& _queue,
+		const uint32 _depthWidth, const uint32 _depthHeight) :
+		m_LogicalDevice{ _logicalDevice },
+		m_Format{ static_cast<uint32>(VK_FORMAT_R32_SFLOAT) },
+		m_Width{ std::bit_floor(std::max(_depthWidth, 1u)) },
+		m_Height{ std::bit_floor(std::max(_depthHeight, 1u)) },
+		m_MipCount{ static_cast<uint32>(std::bit_width(std::max(m_Width, m_Height))) },
+		m_DepthWidth{ _depthWidth },
+		m_DepthHeight{ _depthHeight },
+		m_Image{ VK_NULL_HANDLE },
+		m_ImageMemory{ VK_NULL_HANDLE },
+		m_ImageView{ VK_NULL_HANDLE },
+		m_MipViews{},
+		m_Sampler{ VK_NULL_HANDLE },
+		m_DescriptorSetLayout{ VK_NULL_HANDLE },
+		m_DescriptorPool{ VK_NULL_HANDLE },
+		m_DescriptorSets{},
+		m_Pipeline{ nullptr }
+	{
+		BE_LOG(LogCategory::Trace, "[DEPTH PYRAMID]: Creating %ux%u depth pyramid", m_Width, m_Height);
+
+		VulkanUtils::CreateImage
+		(
+			_logicalDevice,
+			_gpu,
+			m_Width,
+			m_Height,
+			VK_FORMAT_R32_SFLOAT,
+			VK_IMAGE_TILING_OPTIMAL,
+			static_cast<VkImageUsageFlagBits>(VK_IMAGE_USAGE_STORAGE_BIT | VK_IMAGE_USAGE_SAMPLED_BIT),
+			VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
+			m_Image,
+			m_ImageMemory,
+			m_MipCount
+		);
+
+		VulkanUtils::CreateImageView(_logicalDevice, m_Image, m_Format, VK_IMAGE_ASPECT_COLOR_BIT, m_ImageView, 0, m_MipCount);
+
+		m_MipViews.resize(m_MipCount, VK_NULL_HANDLE);
+		for (uint32 mip = 0; mip < m_MipCount; ++mip)
+		{
+			VulkanUtils::CreateImageView(_logicalDevice, m_Image, m_Format, VK_IMAGE_ASPECT_COLOR_BIT, m_MipViews[mip], mip, 1);
+		}
+
+		// The render graph expects the pyramid in its final layout at the start of every frame, including the first
+		VulkanUtils::TransitionImageLayout(_logicalDevice, _commandPool, _queue, m_Image, VK_FORMAT_R32_SFLOAT, VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL, m_MipCount);
+
+		// Depth is fetched texel by texel, the nearest filter only matters for the culling shader's explicit mip selection
+		VkSamplerCreateInfo samplerCreateInfo{};
+		samplerCreateInfo.sType = VK_STRUCTURE_TYPE_SAMPLER_CREATE_INFO;
+		samplerCreateInfo.magFilter = VK_FILTER_NEAREST;
+		samplerCreateInfo.minFilter = VK_FILTER_NEAREST;
+		samplerCreateInfo.addressModeU = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE;
+		samplerCreateInfo.addressModeV = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE;
+		samplerCreateInfo.addressModeW = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE;
+		samplerCreateInfo.unnormalizedCoordinates = VK_FALSE;
+		samplerCreateInfo.compareEnable = VK_FALSE;
+		samplerCreateInfo.mipmapMode = VK_SAMPLER_MIPMAP_MODE_NEAREST;
+		samplerCreateInfo.mipLodBias = 0.0f;
+		samplerCreateInfo.minLod = 0.0f;
+		samplerCreateInfo.maxLod = static_cast<float>(m_MipCount);
+		samplerCreateInfo.anisotropyEnable = VK_FALSE;
+		samplerCreateInfo.maxAnisotropy = 1.0f;
+
+		if (vkCreateSampler(_logicalDevice, &samplerCreateInfo, nullptr, &m_Sampler) != VK_SUCCESS)
+		{
+			throw std::runtime_error("ERROR: Failed to create depth pyramid sampler");
+		}
+
+		// Source (depth buffer or the mip below) and destination mip
+		std::array<VkDescriptorSetLayoutBinding, 2> layoutBindings{};
+		layoutBindings[0].binding = 0;
+		layoutBindings[0].descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+		layoutBindings[0].descriptorCount = 1;
+		layoutBindings[0].stageFlags = VK_SHADER_STAGE_COMPUTE_BIT;
+		layoutBindings[1].binding = 1;
+		layoutBindings[1].descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_IMAGE;
+		layoutBindings[1].descriptorCount = 1;
+		layoutBindings[1].stageFlags = VK_SHADER_STAGE_COMPUTE_BIT;
+
+		VkDescriptorSetLayoutCreateInfo layoutCreateInfo{};
+		layoutCreateInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
+		layoutCreateInfo.bindingCount = static_cast<uint32>(layoutBindings.size());
+		layoutCreateInfo.pBindings = layoutBindings.data();
+
+		if (vkCreateDescriptorSetLayout(_logicalDevice, &layoutCreateInfo, nullptr, &m_DescriptorSetLayout) != VK_SUCCESS)
+		{
+			throw std::runtime_error("ERROR: Failed to create the depth pyramid descriptor set layout");
+		}
+
+		std::array<VkDescriptorPoolSize, 2> poolSizes{};
+		poolSizes[0].type = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+		poolSizes[0].descriptorCount = m_MipCount;
+		poolSizes[1].type = VK_DESCRIPTOR_TYPE_STORAGE_IMAGE;
+		poolSizes[1].descriptorCount = m_MipCount;
+
+		VkDescriptorPoolCreateInfo poolCreateInfo{};
+		poolCreateInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
+		poolCreateInfo.maxSets = m_MipCount;
+		poolCreateInfo.poolSizeCount = static_cast<uint32>(poolSizes.size());
+		poolCreateInfo.pPoolSizes = poolSizes.data();
+
+		if (vkCreateDescriptorPool(_logicalDevice, &poolCreateInfo, nullptr, &m_DescriptorPool) != VK_SUCCESS)
+		{
+			throw std::runtime_error("ERROR: Failed to create the depth pyramid descriptor pool");
+		}
+
+		const std::vector<VkDescriptorSetLayout> setLayouts(m_MipCount, m_DescriptorSetLayout);
+		VkDescriptorSetAllocateInfo allocInfo{};
+		allocInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+		allocInfo.descriptorPool = m_DescriptorPool;
+		allocInfo.descriptorSetCount = m_MipCount;
+		allocInfo.pSetLayouts = setLayouts.data();
+
+		m_DescriptorSets.resize(m_MipCount, VK_NULL_HANDLE);
+		if (vkAllocateDescriptorSets(_logicalDevice, &allocInfo, m_DescriptorSets.data()) != VK_SUCCESS)
+		{
+			throw std::runtime_error("ERROR: Failed to allocate the depth pyramid descriptor sets");
+		}
+
+		// Every mip but the first reads the one below it, which stays in the general layout while the pyramid is built.
+		// The first mip's source is the depth buffer, written once the render graph created it
+		for (uint32 mip = 0; mip < m_MipCount; ++mip)
+		{
+			const VkDescriptorImageInfo sourceInfo{ m_Sampler, mip > 0 ? m_MipViews[mip - 1] : VK_NULL_HANDLE, VK_IMAGE_LAYOUT_GENERAL };
+			const VkDescriptorImageInfo destinationInfo{ VK_NULL_HANDLE, m_MipViews[mip], VK_IMAGE_LAYOUT_GENERAL };
+
+			std::array<VkWriteDescriptorSet, 2> descriptorWrites{};
+			descriptorWrites[0].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+			descriptorWrites[0].dstSet = m_DescriptorSets[mip];
+			descriptorWrites[0].dstBinding = 0;
+			descriptorWrites[0].descriptorCount = 1;
+			descriptorWrites[0].descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+			descriptorWrites[0].pImageInfo = &sourceInfo;
+			descriptorWrites[1].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+			descriptorWrites[1].dstSet = m_DescriptorSets[mip];
+			descriptorWrites[1].dstBinding = 1;
+			descriptorWrites[1].descriptorCount = 1;
+			descriptorWrites[1].descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_IMAGE;
+			descriptorWrites[1].pImageInfo = &destinationInfo;
+
+			const uint32 firstWrite = mip > 0 ? 0 : 1;
+			vkUpdateDescriptorSets(_logicalDevice, static_cast<uint32>(descriptorWrites.size()) - firstWrite, descriptorWrites.data() + firstWrite, 0, nullptr);
+		}
+
+		m_Pipeline = std::make_unique<VulkanComputePipeline>(_logicalDevice, m_DescriptorSetLayout, static_cast<uint32>(sizeof(DepthPyramidConstants)), "Shaders/Culling/depth_pyramid_comp.spv");
+
+		BE_LOG(LogCategory::Info, "[DEPTH PYRAMID]: Created depth pyramid with %u mips", m_MipCount);
+	}
+
+	VulkanDepthPyramid::~VulkanDepthPyramid()
+	{
+		m_Pipeline.reset();
+
+		vkDestroyDescriptorPool(m_LogicalDevice, m_DescriptorPool, nullptr);
+		vkDestroyDescriptorSetLayout(m_LogicalDevice, m_DescriptorSetLayout, nullptr);
+		vkDestroySampler(m_LogicalDevice, m_Sampler, nullptr);
+
+		for (const VkImageView mipView : m_MipViews)
+		{
+			vkDestroyImageView(m_LogicalDevice, mipView, nullptr);
+		}
+
+		vkDestroyImageView(m_LogicalDevice, m_ImageView, nullptr);
+		vkDestroyImage(m_LogicalDevice, m_Image, nullptr);
+		vkFreeMemory(m_LogicalDevice, m_ImageMemory, nullptr);
+	}
+
+	void VulkanDepthPyramid::SetDepthSource(const VkImageView& _depthView) noexcept
+	{
+		const VkDescriptorImageInfo sourceInfo{ m_Sampler, _depthView, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL };
+
+		VkWriteDescriptorSet descriptorWrite{};
+		descriptorWrite.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+		descriptorWrite.dstSet = m_DescriptorSets[0];
+		descriptorWrite.dstBinding = 0;
+		descriptorWrite.descriptorCount = 1;
+		descriptorWrite.descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+		descriptorWrite.pImageInfo = &sourceInfo;
+
+		vkUpdateDescriptorSets(m_LogicalDevice, 1, &descriptorWrite, 0, nullptr);
+	}
+
+	void VulkanDepthPyramid::Record(const VkCommandBuffer& _cmdBuffer) const noexcept
+	{
+		vkCmdBindPipeline(_cmdBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, m_Pipeline->Get());
+
+		DepthPyramidConstants constants{ m_DepthWidth, m_DepthHeight, m_Width, m_Height };
+		for (uint32 mip = 0; mip < m_MipCount; ++mip)
+		{
+			// Every mip reads the one the previous dispatch wrote
+			if (mip > 0)
+			{
+				VkMemoryBarrier barrier{};
+				barrier.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+				barrier.srcAccessMask = VK_ACCESS_SHADER_WRITE_BIT;
+				barrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
+				vkCmdPipelineBarrier(_cmdBuffer, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, 0, 1, &barrier, 0, nullptr, 0, nullptr);
+			}
+
+			vkCmdBindDescriptorSets(_cmdBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, m_Pipeline->GetLayout(), 0, 1, &m_DescriptorSets[mip], 0, nullptr);
+			vkCmdPushConstants(_cmdBuffer, m_Pipeline->GetLayout(), VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof(DepthPyramidConstants), &constants);
+			vkCmdDispatch(_cmdBuffer, (constants.m_DestinationWidth + g_DepthPyramidGroupSize - 1) / g_DepthPyramidGroupSize,
+				(constants.m_DestinationHeight + g_DepthPyramidGroupSize - 1) / g_DepthPyramidGroupSize, 1);
+
+			constants.m_SourceWidth = constants.m_DestinationWidth;
+			constants.m_SourceHeight = constants.m_DestinationHeight;
+			constants.m_DestinationWidth = std::max(constants.m_DestinationWidth / 2, 1u);
+			constants.m_DestinationHeight = std::max(constants.m_DestinationHeight / 2, 1u);
+		}
+	}
+} // End of Banshee namespace
\ No newline at end of file
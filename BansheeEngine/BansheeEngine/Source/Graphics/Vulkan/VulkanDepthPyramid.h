@@ -0,0 +1,81 @@
+#pragma once
+
+#include "VulkanComputePipeline.h"
+#include "Foundation/Platform.h"
+#include <memory>
+#include <vector>
+
+typedef struct VkDevice_T* VkDevice;
+typedef struct VkPhysicalDevice_T* VkPhysicalDevice;
+typedef struct VkCommandPool_T* VkCommandPool;
+typedef struct VkQueue_T* VkQueue;
+typedef struct VkCommandBuffer_T* VkCommandBuffer;
+typedef struct VkImage_T* VkImage;
+typedef struct VkImageView_T* VkImageView;
+typedef struct VkDeviceMemory_T* VkDeviceMemory;
+typedef struct VkSampler_T* VkSampler;
+typedef struct VkDescriptorSetLayout_T* VkDescriptorSetLayout;
+typedef struct VkDescriptorPool_T* VkDescriptorPool;
+typedef struct VkDescriptorSet_T* VkDescriptorSet;
+
+namespace Banshee
+{
+	// Mirrors the push constants of Res/Shaders/Culling/depth_pyramid.comp
+	struct DepthPyramidConstants
+	{
+		uint32 m_SourceWidth;
+		uint32 m_SourceHeight;
+		uint32 m_DestinationWidth;
+		uint32 m_DestinationHeight;
+	};
+
+	// Hierarchical depth buffer (Hi-Z). Every texel of a mip holds the farthest depth of the texels it covers in the mip below, mip 0 reducing
+	// the depth buffer itself, so a single fetch at the right mip tells whether anything behind a screen rectangle could be visible.
+	// The largest power of two that fits in the depth buffer is used, so each mip is exactly half of the previous one.
+	// The pyramid outlives frames, as the culling of the next frame tests against it before any depth is rendered, and it's kept in the shader read layout between frames
+	class VulkanDepthPyramid
+	{
+	public:
+		VulkanDepthPyramid(const VkDevice& _logicalDevice, const VkPhysicalDevice& _gpu, const VkCommandPool& _commandPool, const VkQueue& _queue,
+			const uint32 _depthWidth, const uint32 _depthHeight);
+		~VulkanDepthPyramid();
+
+		// Points the first reduction at the depth buffer, which has to be in the shader read layout when the pyramid is recorded
+		void SetDepthSource(const VkImageView& _depthView) noexcept;
+		// Reduces the depth buffer into every mip, one dispatch per mip. Expects the pyramid in the general layout
+		void Record(const VkCommandBuffer& _cmdBuffer) const noexcept;
+
+		VkImage GetImage() const noexcept { return m_Image; }
+		// View over every mip, sampled with the nearest filter
+		VkImageView GetImageView() const noexcept { return m_ImageView; }
+		VkSampler GetSampler() const noexcept { return m_Sampler; }
+		uint32 GetFormat() const noexcept { return m_Format; }
+		uint32 GetWidth() const noexcept { return m_Width; }
+		uint32 GetHeight() const noexcept { return m_Height; }
+		uint32 GetMipCount() const noexcept { return m_MipCount; }
+
+		VulkanDepthPyramid(const VulkanDepthPyramid&) = delete;
+		VulkanDepthPyramid& operator=(const VulkanDepthPyramid&) = delete;
+		VulkanDepthPyramid(VulkanDepthPyramid&&) = delete;
+		VulkanDepthPyramid& operator=(VulkanDepthPyramid&&) = delete;
+
+	private:
+		VkDevice m_LogicalDevice;
+		uint32 m_Format;
+		uint32 m_Width;
+		uint32 m_Height;
+		uint32 m_MipCount;
+		uint32 m_DepthWidth;
+		uint32 m_DepthHeight;
+		VkImage m_Image;
+		VkDeviceMemory m_ImageMemory;
+		VkImageView m_ImageView;
+		std::vector<VkImageView> m_MipViews;
+		VkSampler m_Sampler;
+		VkDescriptorSetLayout m_DescriptorSetLayout;
+		VkDescriptorPool m_DescriptorPool;
+		// One set per mip, reading the depth buffer or the mip below and writing the mip
+		std::vector<VkDescriptorSet> m_DescriptorSets;
+		std::unique_ptr<VulkanComputePipeline> m_Pipeline;
+	};
+} // End of Banshee namespace
\ No newline at end of file
@@ -12,23 +12,25 @@ namespace Banshee
 	{
 		BE_LOG(LogCategory::Trace, "[DESCRIPTOR POOL]: Creating descriptor pool");
 
+		// Counts are per set: view-projection, cluster and shadow buffers, material, instance, light and cluster light list buffers,
+		// the texture array with the shadow atlas, and the texture and shadow samplers
 		std::array<VkDescriptorPoolSize, 4> poolSizes{};
-		poolSizes[0].type = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
-		poolSizes[0].descriptorCount = 1;
-		BE_LOG(LogCategory::Trace, "[DESCRIPTOR POOL]: Added descriptor pool size of type VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER");
-
-		poolSizes[1].type = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC;
-		poolSizes[1].descriptorCount = 1;
+		poolSizes[0].type = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC;
+		poolSizes[0].descriptorCount = 3 * _maxSets;
 		BE_LOG(LogCategory::Trace, "[DESCRIPTOR POOL]: Added descriptor pool size of type VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC");
 
-		poolSizes[2].type = VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE;
-		poolSizes[2].descriptorCount = 1;
+		poolSizes[1].type = VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE;
+		poolSizes[1].descriptorCount = 17 * _maxSets;
 		BE_LOG(LogCategory::Trace, "[DESCRIPTOR POOL]: Added descriptor pool size of type VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE");
 
-		poolSizes[3].type = VK_DESCRIPTOR_TYPE_SAMPLER;
-		poolSizes[3].descriptorCount = 1;
+		poolSizes[2].type = VK_DESCRIPTOR_TYPE_SAMPLER;
+		poolSizes[2].descriptorCount = 2 * _maxSets;
 		BE_LOG(LogCategory::Trace, "[DESCRIPTOR POOL]: Added descriptor pool size of type VK_DESCRIPTOR_TYPE_SAMPLER");
 
+		poolSizes[3].type = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER_DYNAMIC;
+		poolSizes[3].descriptorCount = 4 * _maxSets;
+		BE_LOG(LogCategory::Trace, "[DESCRIPTOR POOL]: Added descriptor pool size of type VK_DESCRIPTOR_TYPE_STORAGE_BUFFER_DYNAMIC");
+
 		VkDescriptorPoolCreateInfo descriptorPoolCreateInfo{};
 		descriptorPoolCreateInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
 		descriptorPoolCreateInfo.flags = VK_DESCRIPTOR_POOL_CREATE_FREE_DESCRIPTOR_SET_BIT;
@@ -15,21 +15,21 @@ namespace Banshee
 		BE_LOG(LogCategory::Trace, "[DESCRIPTOR SET LAYOUT]: Creating descriptor set layout");
 
 		// View-projection binding
-		std::array<VkDescriptorSetLayoutBinding, 5> layoutBindings{};
+		std::array<VkDescriptorSetLayoutBinding, 11> layoutBindings{};
 		layoutBindings[0].binding = 0;
-		layoutBindings[0].descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
+		layoutBindings[0].descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC;
 		layoutBindings[0].descriptorCount = 1;
 		layoutBindings[0].stageFlags = VK_SHADER_STAGE_VERTEX_BIT;
 		layoutBindings[0].pImmutableSamplers = nullptr;
-		BE_LOG(LogCategory::Trace, "[DESCRIPTOR SET LAYOUT]: Added descriptor of type VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER at binding 0");
+		BE_LOG(LogCategory::Trace, "[DESCRIPTOR SET LAYOUT]: Added descriptor of type VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC at binding 0");
 
-		// Color dynamic buffer
+		// Material storage buffer, indexed with each instance's material index
 		layoutBindings[1].binding = 1;
-		layoutBindings[1].descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC;
+		layoutBindings[1].descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER_DYNAMIC;
 		layoutBindings[1].descriptorCount = 1;
 		layoutBindings[1].stageFlags = VK_SHADER_STAGE_FRAGMENT_BIT;
 		layoutBindings[1].pImmutableSamplers = nullptr;
-		BE_LOG(LogCategory::Trace, "[DESCRIPTOR SET LAYOUT]: Added descriptor of type VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC at binding 1");
+		BE_LOG(LogCategory::Trace, "[DESCRIPTOR SET LAYOUT]: Added descriptor of type VK_DESCRIPTOR_TYPE_STORAGE_BUFFER_DYNAMIC at binding 1");
 
 		// Textures
 		constexpr uint32 MAX_TEXTURES{ 16 };
@@ -48,13 +48,56 @@ namespace Banshee
 		layoutBindings[3].pImmutableSamplers = nullptr;
 		BE_LOG(LogCategory::Trace, "[DESCRIPTOR SET LAYOUT]: Added descriptor of type VK_DESCRIPTOR_TYPE_SAMPLER at binding 3");
 
-		// Light uniform buffer binding
+		// Light cluster grid parameters
 		layoutBindings[4].binding = 4;
-		layoutBindings[4].descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
+		layoutBindings[4].descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC;
 		layoutBindings[4].descriptorCount = 1;
 		layoutBindings[4].stageFlags = VK_SHADER_STAGE_FRAGMENT_BIT;
 		layoutBindings[4].pImmutableSamplers = nullptr;
-		BE_LOG(LogCategory::Trace, "[DESCRIPTOR SET LAYOUT]: Added descriptor of type VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER at binding 4");
+		BE_LOG(LogCategory::Trace, "[DESCRIPTOR SET LAYOUT]: Added descriptor of type VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC at binding 4");
+
+		// Per-instance data storage buffer
+		layoutBindings[5].binding = 5;
+		layoutBindings[5].descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER_DYNAMIC;
+		layoutBindings[5].descriptorCount = 1;
+		layoutBindings[5].stageFlags = VK_SHADER_STAGE_VERTEX_BIT;
+		layoutBindings[5].pImmutableSamplers = nullptr;
+		BE_LOG(LogCategory::Trace, "[DESCRIPTOR SET LAYOUT]: Added descriptor of type VK_DESCRIPTOR_TYPE_STORAGE_BUFFER_DYNAMIC at binding 5");
+
+		// Lights and per-cluster light lists, written by the light clustering pass and read while shading
+		for (uint32 binding = 6; binding < 8; ++binding)
+		{
+			layoutBindings[binding].binding = binding;
+			layoutBindings[binding].descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER_DYNAMIC;
+			layoutBindings[binding].descriptorCount = 1;
+			layoutBindings[binding].stageFlags = VK_SHADER_STAGE_FRAGMENT_BIT;
+			layoutBindings[binding].pImmutableSamplers = nullptr;
+			BE_LOG(LogCategory::Trace, "[DESCRIPTOR SET LAYOUT]: Added descriptor of type VK_DESCRIPTOR_TYPE_STORAGE_BUFFER_DYNAMIC at binding %u", binding);
+		}
+
+		// Shadow tile matrices, cascade splits and the directional light
+		layoutBindings[8].binding = 8;
+		layoutBindings[8].descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC;
+		layoutBindings[8].descriptorCount = 1;
+		layoutBindings[8].stageFlags = VK_SHADER_STAGE_FRAGMENT_BIT;
+		layoutBindings[8].pImmutableSamplers = nullptr;
+		BE_LOG(LogCategory::Trace, "[DESCRIPTOR SET LAYOUT]: Added descriptor of type VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC at binding 8");
+
+		// Shadow atlas
+		layoutBindings[9].binding = 9;
+		layoutBindings[9].descriptorType = VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE;
+		layoutBindings[9].descriptorCount = 1;
+		layoutBindings[9].stageFlags = VK_SHADER_STAGE_FRAGMENT_BIT;
+		layoutBindings[9].pImmutableSamplers = nullptr;
+		BE_LOG(LogCategory::Trace, "[DESCRIPTOR SET LAYOUT]: Added descriptor of type VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE at binding 9");
+
+		// Depth comparison sampler of the shadow atlas
+		layoutBindings[10].binding = 10;
+		layoutBindings[10].descriptorType = VK_DESCRIPTOR_TYPE_SAMPLER;
+		layoutBindings[10].descriptorCount = 1;
+		layoutBindings[10].stageFlags = VK_SHADER_STAGE_FRAGMENT_BIT;
+		layoutBindings[10].pImmutableSamplers = nullptr;
+		BE_LOG(LogCategory::Trace, "[DESCRIPTOR SET LAYOUT]: Added descriptor of type VK_DESCRIPTOR_TYPE_SAMPLER at binding 10");
 
 		VkDescriptorSetLayoutCreateInfo layoutCreateInfo{};
 		layoutCreateInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
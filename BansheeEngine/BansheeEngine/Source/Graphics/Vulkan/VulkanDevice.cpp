@@ -16,7 +16,8 @@ namespace Banshee
 		m_Surface{ _vkSurface },
 		m_GraphicsQueue{ VK_NULL_HANDLE },
 		m_TransferQueue{ VK_NULL_HANDLE },
-		m_PresentQueue{ VK_NULL_HANDLE }
+		m_PresentQueue{ VK_NULL_HANDLE },
+		m_SupportsDrawIndirectCount{ false }
 	{
 		BE_LOG(LogCategory::Trace, "[DEVICE]: Creating logical device");
 
@@ -118,8 +119,12 @@ namespace Banshee
 
 	bool VulkanDevice::CheckDeviceFeatures(const VkPhysicalDevice& _gpu) const noexcept
 	{
+		VkPhysicalDeviceVulkan13Features features13{};
+		features13.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_3_FEATURES;
+
 		VkPhysicalDeviceVulkan12Features features12{};
 		features12.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_2_FEATURES;
+		features12.pNext = &features13;
 
 		VkPhysicalDeviceFeatures2 deviceFeatures{};
 		deviceFeatures.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2;
@@ -127,7 +132,8 @@ namespace Banshee
 
 		vkGetPhysicalDeviceFeatures2(_gpu, &deviceFeatures);
 
-		return features12.runtimeDescriptorArray == VK_TRUE;
+		// The render graph records passes with dynamic rendering and synchronization2 barriers
+		return features12.runtimeDescriptorArray == VK_TRUE && features13.dynamicRendering == VK_TRUE && features13.synchronization2 == VK_TRUE;
 	}
 
 	void VulkanDevice::SetupQueueFamilyIndices()
@@ -204,9 +210,25 @@ namespace Banshee
 			enabledFeatures.fillModeNonSolid = VK_TRUE; // Enable wireframe mode
 		}
 
+		// Draw indirect count is optional, the GPU-driven render path is only available when it is supported
+		VkPhysicalDeviceVulkan12Features availableFeatures12{};
+		availableFeatures12.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_2_FEATURES;
+		VkPhysicalDeviceFeatures2 availableFeatures2{};
+		availableFeatures2.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2;
+		availableFeatures2.pNext = &availableFeatures12;
+		vkGetPhysicalDeviceFeatures2(m_PhysicalDevice, &availableFeatures2);
+		m_SupportsDrawIndirectCount = availableFeatures12.drawIndirectCount == VK_TRUE;
+
 		VkPhysicalDeviceVulkan12Features features12{};
 		features12.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_2_FEATURES;
 		features12.runtimeDescriptorArray = VK_TRUE;
+		features12.drawIndirectCount = availableFeatures12.drawIndirectCount;
+
+		VkPhysicalDeviceVulkan13Features features13{};
+		features13.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_3_FEATURES;
+		features13.dynamicRendering = VK_TRUE;
+		features13.synchronization2 = VK_TRUE;
+		features12.pNext = &features13;
 
 		std::vector<const char*> deviceExtentions = { VK_KHR_SWAPCHAIN_EXTENSION_NAME };
 		VulkanUtils::CheckDeviceExtSupport(m_PhysicalDevice, deviceExtentions);
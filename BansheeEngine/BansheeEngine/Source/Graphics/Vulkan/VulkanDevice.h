@@ -39,6 +39,7 @@ namespace Banshee
 		VkQueue GetPresentationQueue() const noexcept { return m_PresentQueue; }
 		VkQueue GetTransferQueue() const noexcept { return m_TransferQueue; }
 		VkPhysicalDeviceLimits GetLimits() const noexcept;
+		bool SupportsDrawIndirectCount() const noexcept { return m_SupportsDrawIndirectCount; }
 
 		VulkanDevice(const VulkanDevice&) = delete;
 		VulkanDevice& operator=(const VulkanDevice&) = delete;
@@ -60,5 +61,6 @@ namespace Banshee
 		VkQueue m_GraphicsQueue;
 		VkQueue m_TransferQueue;
 		VkQueue m_PresentQueue;
+		bool m_SupportsDrawIndirectCount;
 	};
 } // End of Banshee namespace
\ No newline at end of file
@@ -0,0 +1,37 @@
+#include "VulkanFrameAllocator.h"
+#include <stdexcept>
+
+namespace Banshee
+{
+	static uint64 AlignUp(const uint64 _value, const uint64 _alignment) noexcept
+	{
+		return (_value + _alignment - 1) & ~(_alignment - 1);
+	}
+
+	VulkanFrameAllocator::VulkanFrameAllocator(const VkDevice& _logicalDevice, const VkPhysicalDevice& _gpu, const uint32 _framesInFlight, const uint64 _frameCapacity, const uint64 _alignment) :
+		m_Buffer{ _logicalDevice, _gpu, AlignUp(_frameCapacity, _alignment) * _framesInFlight, true },
+		m_FrameCapacity{ AlignUp(_frameCapacity, _alignment) },
+		m_Alignment{ _alignment },
+		m_FrameStart{ 0 },
+		m_Head{ 0 }
+	{}
+
+	void VulkanFrameAllocator::BeginFrame(const uint32 _frameIndex) noexcept
+	{
+		m_FrameStart = m_FrameCapacity * _frameIndex;
+		m_Head = m_FrameStart;
+	}
+
+	UniformAllocation VulkanFrameAllocator::Allocate(const uint64 _size)
+	{
+		const uint64 offset = m_Head;
+		const uint64 end = AlignUp(offset + _size, m_Alignment);
+		if (end > m_FrameStart + m_FrameCapacity)
+		{
+			throw std::runtime_error("ERROR: Exceeded the per-frame uniform memory budget");
+		}
+
+		m_Head = end;
+		return { m_Buffer.GetMappedData() + offset, static_cast<uint32>(offset) };
+	}
+} // End of Banshee namespace
\ No newline at end of file
@@ -0,0 +1,51 @@
+#pragma once
+
+#include "VulkanUniformBuffer.h"
+#include "Foundation/Platform.h"
+#include <cstring>
+
+namespace Banshee
+{
+	struct UniformAllocation
+	{
+		uint8* m_Data;
+		uint32 m_Offset;   // Offset into the allocator's buffer, used as the dynamic offset when binding
+	};
+
+	// Linear allocator over one persistently mapped uniform buffer that is split into a region per frame in flight.
+	// BeginFrame rewinds to the start of the frame's region, which the GPU is done with once the frame's fence has signaled.
+	// Every allocation is aligned to the alignment passed in (the larger of the uniform and storage buffer offset alignments), so its offset
+	// can be bound as a dynamic uniform or storage buffer offset
+	class VulkanFrameAllocator
+	{
+	public:
+		VulkanFrameAllocator(const VkDevice& _logicalDevice, const VkPhysicalDevice& _gpu, const uint32 _framesInFlight, const uint64 _frameCapacity, const uint64 _alignment);
+		~VulkanFrameAllocator() = default;
+
+		void BeginFrame(const uint32 _frameIndex) noexcept;
+		UniformAllocation Allocate(const uint64 _size);
+
+		template<typename T>
+		uint32 Write(const T& _data)
+		{
+			const UniformAllocation allocation = Allocate(sizeof(T));
+			std::memcpy(allocation.m_Data, &_data, sizeof(T));
+			return allocation.m_Offset;
+		}
+
+		VkBuffer GetBuffer() const noexcept { return m_Buffer.GetBuffer(); }
+		uint64 GetAlignment() const noexcept { return m_Alignment; }
+
+		VulkanFrameAllocator(const VulkanFrameAllocator&) = delete;
+		VulkanFrameAllocator& operator=(const VulkanFrameAllocator&) = delete;
+		VulkanFrameAllocator(VulkanFrameAllocator&&) = delete;
+		VulkanFrameAllocator& operator=(VulkanFrameAllocator&&) = delete;
+
+	private:
+		VulkanUniformBuffer m_Buffer;
+		uint64 m_FrameCapacity;
+		uint64 m_Alignment;
+		uint64 m_FrameStart;
+		uint64 m_Head;
+	};
+} // End of Banshee namespace
\ No newline at end of file
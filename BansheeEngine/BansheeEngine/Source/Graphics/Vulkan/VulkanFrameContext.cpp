@@ -0,0 +1,35 @@
+#include "VulkanFrameContext.h"
+#include <vulkan/vulkan.h>
+
+namespace Banshee
+{
+	VulkanFrameContext::VulkanFrameContext(const VkDevice& _logicalDevice, const uint32 _queueFamilyIndex, const VkDescriptorPool& _descriptorPool, const VkDescriptorSetLayout& _descriptorSetLayout,
+		const uint32 _recordingSlots) :
+		m_LogicalDevice{ _logicalDevice },
+		m_CommandPool{ _logicalDevice, _queueFamilyIndex },
+		m_CommandBuffer{ _logicalDevice, m_CommandPool.Get() },
+		m_RecordingSlots{},
+		m_Semaphores{ _logicalDevice },
+		m_InFlightFence{ _logicalDevice },
+		m_DescriptorSet{ _logicalDevice, _descriptorPool, _descriptorSetLayout },
+		m_MaterialVersion{ 0 },
+		m_TextureVersion{ UINT64_MAX }
+	{
+		m_RecordingSlots.reserve(_recordingSlots);
+		for (uint32 slot = 0; slot < _recordingSlots; ++slot)
+		{
+			m_RecordingSlots.push_back(std::make_unique<RecordingSlot>(_logicalDevice, _queueFamilyIndex));
+		}
+	}
+
+	void VulkanFrameContext::Reset() noexcept
+	{
+		m_InFlightFence.Reset(0);
+		vkResetCommandPool(m_LogicalDevice, m_CommandPool.Get(), 0);
+
+		for (const auto& slot : m_RecordingSlots)
+		{
+			vkResetCommandPool(m_LogicalDevice, slot->m_CommandPool.Get(), 0);
+		}
+	}
+} // End of Banshee namespace
\ No newline at end of file
@@ -0,0 +1,76 @@
+#pragma once
+
+#include "VulkanCommandPool.h"
+#include "VulkanCommandBuffer.h"
+#include "VulkanSemaphore.h"
+#include "VulkanFence.h"
+#include "VulkanDescriptorSet.h"
+#include "Foundation/Platform.h"
+#include <vector>
+#include <memory>
+
+namespace Banshee
+{
+	// Owns everything the CPU touches while recording one frame: a command pool and buffer, one pool with a secondary buffer per recording job,
+	// the acquire/render semaphores, the fence
+	// signaled when the GPU is done with the frame, and the frame's descriptor set. Uniform data lives in the frame's region of the VulkanFrameAllocator.
+	// The renderer cycles through a configurable number of contexts independently of the swapchain image count.
+	// Once Wait returns, all of the context's resources can be rewritten without affecting frames still in flight
+	class VulkanFrameContext
+	{
+	public:
+		// _recordingSlots is how many secondary buffers can be recorded in parallel. Each has its own pool, as a pool may only be used by one thread at a time
+		VulkanFrameContext(const VkDevice& _logicalDevice, const uint32 _queueFamilyIndex, const VkDescriptorPool& _descriptorPool, const VkDescriptorSetLayout& _descriptorSetLayout,
+			const uint32 _recordingSlots);
+		~VulkanFrameContext() = default;
+
+		// Blocks until the GPU has finished the last submission recorded with this context
+		void Wait() const noexcept { m_InFlightFence.Wait(0); }
+		// Resets the fence and recycles all command buffer memory of the context at once. Only call after Wait
+		void Reset() noexcept;
+
+		VulkanCommandBuffer& GetCommandBuffers() noexcept { return m_CommandBuffer; }
+		VkCommandBuffer GetCommandBuffer() const noexcept { return m_CommandBuffer.Get()[0]; }
+		VulkanCommandBuffer& GetSecondaryCommandBuffers(const uint32 _slot) noexcept { return m_RecordingSlots[_slot]->m_CommandBuffer; }
+		VkCommandBuffer GetSecondaryCommandBuffer(const uint32 _slot) const noexcept { return m_RecordingSlots[_slot]->m_CommandBuffer.Get()[0]; }
+		uint32 GetRecordingSlotCount() const noexcept { return static_cast<uint32>(m_RecordingSlots.size()); }
+		VkSemaphore GetImageAvailableSemaphore() noexcept { return m_Semaphores.Get()[0].first; }
+		VkSemaphore GetRenderFinishedSemaphore() noexcept { return m_Semaphores.Get()[0].second; }
+		VkFence GetFence() noexcept { return m_InFlightFence.Get()[0]; }
+		const VulkanDescriptorSet& GetDescriptorSet() const noexcept { return m_DescriptorSet; }
+
+		// Versions of the renderer's material data and texture descriptors this context last synced, so it only catches up on what changed since
+		uint64 GetMaterialVersion() const noexcept { return m_MaterialVersion; }
+		void SetMaterialVersion(const uint64 _version) noexcept { m_MaterialVersion = _version; }
+		uint64 GetTextureVersion() const noexcept { return m_TextureVersion; }
+		void SetTextureVersion(const uint64 _version) noexcept { m_TextureVersion = _version; }
+
+		VulkanFrameContext(const VulkanFrameContext&) = delete;
+		VulkanFrameContext& operator=(const VulkanFrameContext&) = delete;
+		VulkanFrameContext(VulkanFrameContext&&) = delete;
+		VulkanFrameContext& operator=(VulkanFrameContext&&) = delete;
+
+	private:
+		struct RecordingSlot
+		{
+			RecordingSlot(const VkDevice& _logicalDevice, const uint32 _queueFamilyIndex) :
+				m_CommandPool{ _logicalDevice, _queueFamilyIndex },
+				m_CommandBuffer{ _logicalDevice, m_CommandPool.Get(), 1, true }
+			{}
+
+			VulkanCommandPool m_CommandPool;
+			VulkanCommandBuffer m_CommandBuffer;
+		};
+
+	private:
+		VkDevice m_LogicalDevice;
+		VulkanCommandPool m_CommandPool;
+		VulkanCommandBuffer m_CommandBuffer;
+		std::vector<std::unique_ptr<RecordingSlot>> m_RecordingSlots;
+		VulkanSemaphore m_Semaphores;
+		VulkanFence m_InFlightFence;
+		VulkanDescriptorSet m_DescriptorSet;
+		uint64 m_MaterialVersion;
+		uint64 m_TextureVersion;
+	};
+} // End of Banshee namespace
\ No newline at end of file
@@ -3,7 +3,6 @@
 #include "Foundation/ResourceManager/ResourceManager.h"
 #include "Foundation/Logging/Logger.h"
 #include "Graphics/Vertex.h"
-#include "Graphics/MVP.h"
 #include <vulkan/vulkan.h>
 #include <string>
 #include <stdexcept>
@@ -11,7 +10,7 @@
 
 namespace Banshee
 {
-	VulkanGraphicsPipeline::VulkanGraphicsPipeline(const VkDevice& _logicalDevice, const VkRenderPass& _renderPass, const VkDescriptorSetLayout& _descriptorSetLayout, const uint32 _w, const uint32 _h, const char* _vertShaderPath, const char* _fragShaderPath) :
+	VulkanGraphicsPipeline::VulkanGraphicsPipeline(const VkDevice& _logicalDevice, const uint32 _colorFormat, const uint32 _depthFormat, const VkDescriptorSetLayout& _descriptorSetLayout, const uint32 _w, const uint32 _h, const char* _vertShaderPath, const char* _fragShaderPath, const PipelineDepthMode _depthMode) :
 		m_LogicalDevice{ _logicalDevice },
 		m_PipelineLayout{ VK_NULL_HANDLE },
 		m_GraphicsPipeline{ VK_NULL_HANDLE }
@@ -20,13 +19,18 @@ namespace Banshee
 
 		// Vertex creation stage
 		BE_LOG(LogCategory::Trace, "[GRAPHICS PIPELINE]: Using vertex shader %s", _vertShaderPath);
-		BE_LOG(LogCategory::Trace, "[GRAPHICS PIPELINE]: Using frag shader %s", _fragShaderPath);
+		BE_LOG(LogCategory::Trace, "[GRAPHICS PIPELINE]: Using frag shader %s", _fragShaderPath ? _fragShaderPath : "none (depth-only)");
+		const bool depthOnly = _fragShaderPath == nullptr;
 
 		auto vertShaderBinary = g_ResourceManager.ReadBinaryFile(_vertShaderPath);
-		auto fragShaderBinary = g_ResourceManager.ReadBinaryFile(_fragShaderPath);
-
 		VkShaderModule vertexShaderModule = VulkanUtils::CreateShaderModule(_logicalDevice, vertShaderBinary);
-		VkShaderModule fragmentShaderModule = VulkanUtils::CreateShaderModule(_logicalDevice, fragShaderBinary);
+		VkShaderModule fragmentShaderModule = VK_NULL_HANDLE;
+
+		if (!depthOnly)
+		{
+			auto fragShaderBinary = g_ResourceManager.ReadBinaryFile(_fragShaderPath);
+			fragmentShaderModule = VulkanUtils::CreateShaderModule(_logicalDevice, fragShaderBinary);
+		}
 
 		// Shader creation stage
 		VkPipelineShaderStageCreateInfo vertexShaderCreateInfo{};
@@ -69,7 +73,7 @@ namespace Banshee
 		vertexInputCreateInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_VERTEX_INPUT_STATE_CREATE_INFO;
 		vertexInputCreateInfo.vertexBindingDescriptionCount = 1;
 		vertexInputCreateInfo.pVertexBindingDescriptions = &inputBindingDescription;
-		vertexInputCreateInfo.vertexAttributeDescriptionCount = static_cast<uint32>(inputAttributeDescriptions.size());
+		vertexInputCreateInfo.vertexAttributeDescriptionCount = depthOnly ? 1 : static_cast<uint32>(inputAttributeDescriptions.size());
 		vertexInputCreateInfo.pVertexAttributeDescriptions = inputAttributeDescriptions.data();
 
 		// Dynamic states stage
@@ -119,10 +123,10 @@ namespace Banshee
 		rasterizerStateCreateInfo.lineWidth = 1.0f;
 		rasterizerStateCreateInfo.cullMode = VK_CULL_MODE_NONE;
 		rasterizerStateCreateInfo.frontFace = VK_FRONT_FACE_COUNTER_CLOCKWISE;
-		rasterizerStateCreateInfo.depthBiasEnable = VK_FALSE;
-		rasterizerStateCreateInfo.depthBiasConstantFactor = 0.0f;
+		rasterizerStateCreateInfo.depthBiasEnable = _depthMode == PipelineDepthMode::ShadowCaster ? VK_TRUE : VK_FALSE;
+		rasterizerStateCreateInfo.depthBiasConstantFactor = _depthMode == PipelineDepthMode::ShadowCaster ? 1.25f : 0.0f;
 		rasterizerStateCreateInfo.depthBiasClamp = 0.0f;
-		rasterizerStateCreateInfo.depthBiasSlopeFactor = 0.0f;
+		rasterizerStateCreateInfo.depthBiasSlopeFactor = _depthMode == PipelineDepthMode::ShadowCaster ? 1.75f : 0.0f;
 
 		// Multisampling stage
 		VkPipelineMultisampleStateCreateInfo multisamplingStateCreateInfo{};
@@ -148,15 +152,15 @@ namespace Banshee
 		VkPipelineColorBlendStateCreateInfo colorBlendStateCreateInfo{};
 		colorBlendStateCreateInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_COLOR_BLEND_STATE_CREATE_INFO;
 		colorBlendStateCreateInfo.logicOpEnable = VK_FALSE;
-		colorBlendStateCreateInfo.attachmentCount = 1;
+		colorBlendStateCreateInfo.attachmentCount = depthOnly ? 0 : 1;
 		colorBlendStateCreateInfo.pAttachments = &colorBlendAttachmentState;
 
 		// Depth stencil stage
 		VkPipelineDepthStencilStateCreateInfo depthStencilCreateInfo{};
 		depthStencilCreateInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_DEPTH_STENCIL_STATE_CREATE_INFO;
 		depthStencilCreateInfo.depthTestEnable = VK_TRUE;
-		depthStencilCreateInfo.depthWriteEnable = VK_TRUE;
-		depthStencilCreateInfo.depthCompareOp = VK_COMPARE_OP_LESS;
+		depthStencilCreateInfo.depthWriteEnable = _depthMode == PipelineDepthMode::TestEqual ? VK_FALSE : VK_TRUE;
+		depthStencilCreateInfo.depthCompareOp = _depthMode == PipelineDepthMode::TestEqual ? VK_COMPARE_OP_EQUAL : VK_COMPARE_OP_LESS;
 		depthStencilCreateInfo.depthBoundsTestEnable = VK_FALSE;
 		depthStencilCreateInfo.minDepthBounds = 0.0f;
 		depthStencilCreateInfo.maxDepthBounds = 1.0f;
@@ -164,16 +168,11 @@ namespace Banshee
 		depthStencilCreateInfo.front = {};
 		depthStencilCreateInfo.back = {};
 
-		// Pipeline layout stage
-		VkPushConstantRange pushConstantRange{};
-		pushConstantRange.offset = 0;
-		pushConstantRange.size = sizeof(PushConstant);
-		pushConstantRange.stageFlags = VK_SHADER_STAGE_VERTEX_BIT;
-
+		// Pipeline layout stage. Per-draw data is read from the instance storage buffer, so no push constants are needed
 		VkPipelineLayoutCreateInfo pipelineLayoutCreateInfo{};
 		pipelineLayoutCreateInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
-		pipelineLayoutCreateInfo.pushConstantRangeCount = 1;
-		pipelineLayoutCreateInfo.pPushConstantRanges = &pushConstantRange;
+		pipelineLayoutCreateInfo.pushConstantRangeCount = 0;
+		pipelineLayoutCreateInfo.pPushConstantRanges = nullptr;
 		pipelineLayoutCreateInfo.setLayoutCount = 1;
 		pipelineLayoutCreateInfo.pSetLayouts = &_descriptorSetLayout;
 
@@ -182,9 +181,19 @@ namespace Banshee
 			throw std::runtime_error("ERROR: Failed to create a pipeline layout");
 		}
 
+		// Attachment formats for dynamic rendering, the render graph begins each pass without a render pass object
+		const VkFormat colorFormat{ static_cast<VkFormat>(_colorFormat) };
+
+		VkPipelineRenderingCreateInfo renderingCreateInfo{};
+		renderingCreateInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_RENDERING_CREATE_INFO;
+		renderingCreateInfo.colorAttachmentCount = depthOnly ? 0 : 1;
+		renderingCreateInfo.pColorAttachmentFormats = &colorFormat;
+		renderingCreateInfo.depthAttachmentFormat = static_cast<VkFormat>(_depthFormat);
+
 		VkGraphicsPipelineCreateInfo graphicsPipelineCreateInfo{};
 		graphicsPipelineCreateInfo.sType = VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_CREATE_INFO;
-		graphicsPipelineCreateInfo.stageCount = 2;
+		graphicsPipelineCreateInfo.pNext = &renderingCreateInfo;
+		graphicsPipelineCreateInfo.stageCount = depthOnly ? 1 : 2;
 		graphicsPipelineCreateInfo.pStages = shaderStageCreateInfos;
 		graphicsPipelineCreateInfo.pVertexInputState = &vertexInputCreateInfo;
 		graphicsPipelineCreateInfo.pInputAssemblyState = &inputAssemblyCreateInfo;
@@ -195,7 +204,7 @@ namespace Banshee
 		graphicsPipelineCreateInfo.pColorBlendState = &colorBlendStateCreateInfo;
 		graphicsPipelineCreateInfo.pDynamicState = &dynamicStateCreateInfo;
 		graphicsPipelineCreateInfo.layout = m_PipelineLayout;
-		graphicsPipelineCreateInfo.renderPass = _renderPass;
+		graphicsPipelineCreateInfo.renderPass = VK_NULL_HANDLE;
 		graphicsPipelineCreateInfo.subpass = 0;
 		graphicsPipelineCreateInfo.basePipelineHandle = VK_NULL_HANDLE;
 		graphicsPipelineCreateInfo.basePipelineIndex = -1;
@@ -206,7 +215,10 @@ namespace Banshee
 		}
 
 		vkDestroyShaderModule(_logicalDevice, vertexShaderModule, nullptr);
-		vkDestroyShaderModule(_logicalDevice, fragmentShaderModule, nullptr);
+		if (fragmentShaderModule != VK_NULL_HANDLE)
+		{
+			vkDestroyShaderModule(_logicalDevice, fragmentShaderModule, nullptr);
+		}
 
 		BE_LOG(LogCategory::Info, "[GRAPHICS PIPELINE]: Created graphics pipeline");
 	}
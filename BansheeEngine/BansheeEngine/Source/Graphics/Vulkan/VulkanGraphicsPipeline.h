@@ -3,17 +3,26 @@
 #include "Foundation/Platform.h"
 
 typedef struct VkDevice_T* VkDevice;
-typedef struct VkRenderPass_T* VkRenderPass;
 typedef struct VkPipelineLayout_T* VkPipelineLayout;
 typedef struct VkPipeline_T* VkPipeline;
 typedef struct VkDescriptorSetLayout_T* VkDescriptorSetLayout;
 
 namespace Banshee
 {
+	enum class PipelineDepthMode : uint8
+	{
+		TestAndWrite,
+		// Depth was laid down by a prepass, so only the front-most fragment of each pixel passes and nothing is written
+		TestEqual,
+		// Shadow map rendering. Depth is biased by the slope of each triangle, so surfaces don't shadow themselves when the map is sampled
+		ShadowCaster
+	};
+
+	// Without a fragment shader the pipeline is depth-only: it reads vertex positions alone and has no color attachment
 	class VulkanGraphicsPipeline
 	{
 	public:
-		VulkanGraphicsPipeline(const VkDevice& _logicalDevice, const VkRenderPass& _renderPass, const VkDescriptorSetLayout& _descriptorSetLayout, const uint32 _w, const uint32 _h, const char* _vertShaderPath = "Shaders/Standard/standard_vert.spv", const char* _fragShaderPath = "Shaders/Standard/standard_frag.spv");
+		VulkanGraphicsPipeline(const VkDevice& _logicalDevice, const uint32 _colorFormat, const uint32 _depthFormat, const VkDescriptorSetLayout& _descriptorSetLayout, const uint32 _w, const uint32 _h, const char* _vertShaderPath = "Shaders/Standard/standard_vert.spv", const char* _fragShaderPath = "Shaders/Standard/standard_frag.spv", const PipelineDepthMode _depthMode = PipelineDepthMode::TestAndWrite);
 		~VulkanGraphicsPipeline();
 
 		VkPipeline Get() const noexcept { return m_GraphicsPipeline; }
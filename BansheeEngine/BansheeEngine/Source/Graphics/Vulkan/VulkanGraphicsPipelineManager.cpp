@@ -3,9 +3,27 @@
 
 namespace Banshee
 {
-	VulkanGraphicsPipelineManager::VulkanGraphicsPipelineManager(const VkDevice& _device, const VkRenderPass& _renderPass, const VkDescriptorSetLayout& _descriptorSetLayout, const uint32 _width, const uint32 _height)
+	VulkanGraphicsPipelineManager::VulkanGraphicsPipelineManager(const VkDevice& _device, const uint32 _colorFormat, const uint32 _depthFormat, const uint32 _shadowFormat, const VkDescriptorSetLayout& _descriptorSetLayout, const uint32 _width, const uint32 _height, const bool _depthPrepass) :
+		m_Pipelines{},
+		m_PrepassedPipelines{},
+		m_DepthOnlyPipeline{ nullptr },
+		m_ShadowPipeline{ nullptr },
+		m_DepthPrepass{ _depthPrepass }
 	{
-		m_Pipelines[ShaderType::Standard] = std::make_shared<VulkanGraphicsPipeline>(_device, _renderPass, _descriptorSetLayout, _width, _height);
-		m_Pipelines[ShaderType::Unlit] = std::make_shared<VulkanGraphicsPipeline>(_device, _renderPass, _descriptorSetLayout, _width, _height, "Shaders/Unlit/unlit_vert.spv", "Shaders/Unlit/unlit_frag.spv");
+		m_Pipelines[ShaderType::Standard] = std::make_shared<VulkanGraphicsPipeline>(_device, _colorFormat, _depthFormat, _descriptorSetLayout, _width, _height);
+		m_Pipelines[ShaderType::Unlit] = std::make_shared<VulkanGraphicsPipeline>(_device, _colorFormat, _depthFormat, _descriptorSetLayout, _width, _height, "Shaders/Unlit/unlit_vert.spv", "Shaders/Unlit/unlit_frag.spv");
+
+		if (_depthPrepass)
+		{
+			m_PrepassedPipelines[ShaderType::Standard] = std::make_shared<VulkanGraphicsPipeline>(_device, _colorFormat, _depthFormat, _descriptorSetLayout, _width, _height,
+				"Shaders/Standard/standard_vert.spv", "Shaders/Standard/standard_frag.spv", PipelineDepthMode::TestEqual);
+			m_PrepassedPipelines[ShaderType::Unlit] = std::make_shared<VulkanGraphicsPipeline>(_device, _colorFormat, _depthFormat, _descriptorSetLayout, _width, _height,
+				"Shaders/Unlit/unlit_vert.spv", "Shaders/Unlit/unlit_frag.spv", PipelineDepthMode::TestEqual);
+			m_DepthOnlyPipeline = std::make_shared<VulkanGraphicsPipeline>(_device, 0, _depthFormat, _descriptorSetLayout, _width, _height, "Shaders/Depth/depth_vert.spv", nullptr);
+		}
+
+		// Shadow maps reuse the depth-only vertex shader, with the light's view-projection bound in place of the camera's
+		m_ShadowPipeline = std::make_shared<VulkanGraphicsPipeline>(_device, 0, _shadowFormat, _descriptorSetLayout, _width, _height, "Shaders/Depth/depth_vert.spv", nullptr,
+			PipelineDepthMode::ShadowCaster);
 	}
 } // End of Banshee namespace
@@ -6,7 +6,6 @@
 #include <unordered_map>
 
 typedef struct VkDevice_T* VkDevice;
-typedef struct VkRenderPass_T* VkRenderPass;
 typedef struct VkDescriptorSetLayout_T* VkDescriptorSetLayout;
 
 namespace Banshee
@@ -16,9 +15,15 @@ namespace Banshee
     class VulkanGraphicsPipelineManager
     {
     public:
-        VulkanGraphicsPipelineManager(const VkDevice& _device, const VkRenderPass& _renderPass, const VkDescriptorSetLayout& _descriptorSetLayout, const uint32 _width, const uint32 _height);
+        // With _depthPrepass, opaque geometry is drawn by the depth-only pipeline first and shaded with depth test EQUAL afterwards.
+        // Shadow casters are drawn into a depth attachment of _shadowFormat
+        VulkanGraphicsPipelineManager(const VkDevice& _device, const uint32 _colorFormat, const uint32 _depthFormat, const uint32 _shadowFormat, const VkDescriptorSetLayout& _descriptorSetLayout, const uint32 _width, const uint32 _height, const bool _depthPrepass);
 
         const std::shared_ptr<VulkanGraphicsPipeline>& GetPipeline(const ShaderType _shaderType) { return m_Pipelines[_shaderType]; }
+        const std::shared_ptr<VulkanGraphicsPipeline>& GetOpaquePipeline(const ShaderType _shaderType) { return m_DepthPrepass ? m_PrepassedPipelines[_shaderType] : m_Pipelines[_shaderType]; }
+        // Null without a depth prepass
+        const std::shared_ptr<VulkanGraphicsPipeline>& GetDepthOnlyPipeline() const noexcept { return m_DepthOnlyPipeline; }
+        const std::shared_ptr<VulkanGraphicsPipeline>& GetShadowPipeline() const noexcept { return m_ShadowPipeline; }
 
         VulkanGraphicsPipelineManager(const VulkanGraphicsPipelineManager&) = delete;
         VulkanGraphicsPipelineManager& operator=(const VulkanGraphicsPipelineManager&) = delete;
@@ -27,5 +32,9 @@ namespace Banshee
 
     private:
         std::unordered_map<ShaderType, std::shared_ptr<VulkanGraphicsPipeline>> m_Pipelines;
+        std::unordered_map<ShaderType, std::shared_ptr<VulkanGraphicsPipeline>> m_PrepassedPipelines;
+        std::shared_ptr<VulkanGraphicsPipeline> m_DepthOnlyPipeline;
+        std::shared_ptr<VulkanGraphicsPipeline> m_ShadowPipeline;
+        bool m_DepthPrepass;
     };
 } // End of Banshee namespace
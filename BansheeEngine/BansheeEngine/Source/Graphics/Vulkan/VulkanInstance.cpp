@@ -15,7 +15,7 @@ constexpr bool g_EnableValidationLayers{ true };
 
 namespace Banshee
 {
-	VulkanInstance::VulkanInstance() :
+	VulkanInstance::VulkanInstance(const bool _headless) :
 		m_Instance{ VK_NULL_HANDLE },
 		m_DebugMessenger{ VK_NULL_HANDLE }
 	{
@@ -33,19 +33,25 @@ namespace Banshee
 		instanceCreateInfo.sType = VK_STRUCTURE_TYPE_INSTANCE_CREATE_INFO;
 		instanceCreateInfo.pApplicationInfo = &appInfo;
 
-		// Query the required extensions for GLFW
+		// Query the required extensions for GLFW. Headless runs never initialize GLFW
 		unsigned int glfwExtensionCount = 0;
-		const char** glfwExtensions = glfwGetRequiredInstanceExtensions(&glfwExtensionCount);
+		const char** glfwExtensions = _headless ? nullptr : glfwGetRequiredInstanceExtensions(&glfwExtensionCount);
 
 		// List the required instance extensions
 		std::vector<const char*> requiredInstanceExtensions;
-		requiredInstanceExtensions.reserve((size_t)glfwExtensionCount + 1);
+		requiredInstanceExtensions.reserve((size_t)glfwExtensionCount + 2);
 
 		for (size_t i = 0; i < glfwExtensionCount; ++i)
 		{
 			requiredInstanceExtensions.emplace_back(glfwExtensions[i]);
 		}
 
+		if (_headless)
+		{
+			requiredInstanceExtensions.emplace_back(VK_KHR_SURFACE_EXTENSION_NAME);
+			requiredInstanceExtensions.emplace_back(VK_EXT_HEADLESS_SURFACE_EXTENSION_NAME);
+		}
+
 		instanceCreateInfo.enabledLayerCount = 0;
 		instanceCreateInfo.ppEnabledLayerNames = nullptr;
 
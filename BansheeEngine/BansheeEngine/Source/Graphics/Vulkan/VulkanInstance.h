@@ -8,7 +8,8 @@ namespace Banshee
 	class VulkanInstance
 	{
 	public:
-		VulkanInstance();
+		// A headless instance enables VK_EXT_headless_surface in place of the extensions GLFW needs for its window surface
+		explicit VulkanInstance(const bool _headless = false);
 		~VulkanInstance();
 
 		VkInstance Get() const noexcept { return m_Instance; }
@@ -0,0 +1,124 @@
+#include "VulkanLightClusteringPass.h"
+#include "Graphics/Components/Light/LightData.h"
+#include "Foundation/Logging/Logger.h"
+#include <vulkan/vulkan.h>
+#include <stdexcept>
+
+namespace Banshee
+{
+	constexpr static uint32 g_ClusteringGroupSize{ 128 };
+	constexpr static uint32 g_ClusteringBindingCount{ 2 };
+
+	VulkanLightClusteringPass::VulkanLightClusteringPass(const VkDevice& _logicalDevice, const VkBuffer& _buffer) :
+		m_LogicalDevice{ _logicalDevice },
+		m_DescriptorSetLayout{ VK_NULL_HANDLE },
+		m_DescriptorPool{ VK_NULL_HANDLE },
+		m_DescriptorSet{ VK_NULL_HANDLE },
+		m_Pipeline{ nullptr }
+	{
+		BE_LOG(LogCategory::Trace, "[LIGHT CLUSTERING PASS]: Creating light clustering pass");
+
+		// Lights and cluster light lists
+		std::array<VkDescriptorSetLayoutBinding, g_ClusteringBindingCount> layoutBindings{};
+		for (uint32 binding = 0; binding < g_ClusteringBindingCount; ++binding)
+		{
+			layoutBindings[binding].binding = binding;
+			layoutBindings[binding].descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER_DYNAMIC;
+			layoutBindings[binding].descriptorCount = 1;
+			layoutBindings[binding].stageFlags = VK_SHADER_STAGE_COMPUTE_BIT;
+			layoutBindings[binding].pImmutableSamplers = nullptr;
+		}
+
+		VkDescriptorSetLayoutCreateInfo layoutCreateInfo{};
+		layoutCreateInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
+		layoutCreateInfo.bindingCount = static_cast<uint32>(layoutBindings.size());
+		layoutCreateInfo.pBindings = layoutBindings.data();
+
+		if (vkCreateDescriptorSetLayout(_logicalDevice, &layoutCreateInfo, nullptr, &m_DescriptorSetLayout) != VK_SUCCESS)
+		{
+			throw std::runtime_error("ERROR: Failed to create the light clustering descriptor set layout");
+		}
+
+		VkDescriptorPoolSize poolSize{};
+		poolSize.type = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER_DYNAMIC;
+		poolSize.descriptorCount = g_ClusteringBindingCount;
+
+		VkDescriptorPoolCreateInfo poolCreateInfo{};
+		poolCreateInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
+		poolCreateInfo.maxSets = 1;
+		poolCreateInfo.poolSizeCount = 1;
+		poolCreateInfo.pPoolSizes = &poolSize;
+
+		if (vkCreateDescriptorPool(_logicalDevice, &poolCreateInfo, nullptr, &m_DescriptorPool) != VK_SUCCESS)
+		{
+			throw std::runtime_error("ERROR: Failed to create the light clustering descriptor pool");
+		}
+
+		VkDescriptorSetAllocateInfo allocInfo{};
+		allocInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+		allocInfo.descriptorPool = m_DescriptorPool;
+		allocInfo.descriptorSetCount = 1;
+		allocInfo.pSetLayouts = &m_DescriptorSetLayout;
+
+		if (vkAllocateDescriptorSets(_logicalDevice, &allocInfo, &m_DescriptorSet) != VK_SUCCESS)
+		{
+			throw std::runtime_error("ERROR: Failed to allocate the light clustering descriptor set");
+		}
+
+		const std::array<uint64, g_ClusteringBindingCount> ranges =
+		{
+			sizeof(LightData) * s_MaxLights,
+			sizeof(uint32) * s_ClusterCount * s_ClusterListStride
+		};
+
+		std::array<VkDescriptorBufferInfo, g_ClusteringBindingCount> bufferInfos{};
+		std::array<VkWriteDescriptorSet, g_ClusteringBindingCount> descriptorWrites{};
+		for (uint32 binding = 0; binding < g_ClusteringBindingCount; ++binding)
+		{
+			bufferInfos[binding].buffer = _buffer;
+			bufferInfos[binding].offset = 0;
+			bufferInfos[binding].range = ranges[binding];
+
+			descriptorWrites[binding].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+			descriptorWrites[binding].dstSet = m_DescriptorSet;
+			descriptorWrites[binding].dstBinding = binding;
+			descriptorWrites[binding].descriptorCount = 1;
+			descriptorWrites[binding].descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER_DYNAMIC;
+			descriptorWrites[binding].pBufferInfo = &bufferInfos[binding];
+		}
+
+		vkUpdateDescriptorSets(_logicalDevice, static_cast<uint32>(descriptorWrites.size()), descriptorWrites.data(), 0, nullptr);
+
+		m_Pipeline = std::make_unique<VulkanComputePipeline>(_logicalDevice, m_DescriptorSetLayout, static_cast<uint32>(sizeof(LightClusteringConstants)), "Shaders/Lighting/cluster_lights_comp.spv");
+
+		BE_LOG(LogCategory::Info, "[LIGHT CLUSTERING PASS]: Created light clustering pass");
+	}
+
+	VulkanLightClusteringPass::~VulkanLightClusteringPass()
+	{
+		m_Pipeline.reset();
+
+		vkDestroyDescriptorPool(m_LogicalDevice, m_DescriptorPool, nullptr);
+		m_DescriptorPool = VK_NULL_HANDLE;
+
+		vkDestroyDescriptorSetLayout(m_LogicalDevice, m_DescriptorSetLayout, nullptr);
+		m_DescriptorSetLayout = VK_NULL_HANDLE;
+	}
+
+	void VulkanLightClusteringPass::Record(const VkCommandBuffer& _cmdBuffer, const std::array<uint32, 2>& _dynamicOffsets, const LightClusteringConstants& _constants) const noexcept
+	{
+		// One invocation per cluster. Every cluster's count is written, even with no lights, so nothing has to be cleared beforehand
+		vkCmdBindPipeline(_cmdBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, m_Pipeline->Get());
+		vkCmdBindDescriptorSets(_cmdBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, m_Pipeline->GetLayout(), 0, 1, &m_DescriptorSet,
+			static_cast<uint32>(_dynamicOffsets.size()), _dynamicOffsets.data());
+		vkCmdPushConstants(_cmdBuffer, m_Pipeline->GetLayout(), VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof(LightClusteringConstants), &_constants);
+		vkCmdDispatch(_cmdBuffer, (s_ClusterCount + g_ClusteringGroupSize - 1) / g_ClusteringGroupSize, 1, 1);
+
+		// Cluster light lists are read while shading
+		VkMemoryBarrier barrier{};
+		barrier.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+		barrier.srcAccessMask = VK_ACCESS_SHADER_WRITE_BIT;
+		barrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
+		vkCmdPipelineBarrier(_cmdBuffer, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT, 0, 1, &barrier, 0, nullptr, 0, nullptr);
+	}
+} // End of Banshee namespace
\ No newline at end of file
@@ -0,0 +1,71 @@
+#pragma once
+
+#include "VulkanComputePipeline.h"
+#include "Foundation/Platform.h"
+#include <glm/glm.hpp>
+#include <array>
+#include <memory>
+
+typedef struct VkDevice_T* VkDevice;
+typedef struct VkBuffer_T* VkBuffer;
+typedef struct VkCommandBuffer_T* VkCommandBuffer;
+typedef struct VkDescriptorSetLayout_T* VkDescriptorSetLayout;
+typedef struct VkDescriptorPool_T* VkDescriptorPool;
+typedef struct VkDescriptorSet_T* VkDescriptorSet;
+
+namespace Banshee
+{
+	// The structs below mirror Res/Shaders/Lighting/cluster_lights.comp and the cluster uniform of standard.frag
+
+	struct LightClusteringConstants
+	{
+		glm::mat4 m_InverseProjection;
+		glm::uvec4 m_GridSize;      // Clusters along x, y and z, light count
+		glm::vec4 m_ScreenParams;   // Tile width and height, screen width and height, in pixels
+		glm::vec2 m_DepthRange;     // Camera near and far planes
+	};
+
+	// What the fragment shader needs to find its cluster: the grid size with the cluster list stride in w,
+	// and the tile size in pixels followed by the scale and bias mapping log(view depth) to a depth slice
+	struct ClusterData
+	{
+		glm::uvec4 m_GridSize;
+		glm::vec4 m_Params;
+	};
+
+	// Clustered forward lighting. View space is split into screen tiles and exponentially spaced depth slices, and one dispatch tests
+	// every light's sphere of influence against every cluster's bounds. Each cluster keeps a fixed-size list of the lights touching it,
+	// so shading cost follows the lights near a fragment rather than the total light count.
+	// Buffers are sub-allocated from the frame allocator's buffer and bound with dynamic offsets, like the culling pass's
+	class VulkanLightClusteringPass
+	{
+	public:
+		static constexpr uint32 s_GridSizeX{ 16 };
+		static constexpr uint32 s_GridSizeY{ 9 };
+		static constexpr uint32 s_GridSizeZ{ 24 };
+		static constexpr uint32 s_ClusterCount{ s_GridSizeX * s_GridSizeY * s_GridSizeZ };
+		static constexpr uint32 s_MaxLights{ 4096 };
+		// Lights past this many in one cluster are dropped from it
+		static constexpr uint32 s_MaxLightsPerCluster{ 128 };
+		// Each cluster's list is its light count followed by room for s_MaxLightsPerCluster light indices
+		static constexpr uint32 s_ClusterListStride{ s_MaxLightsPerCluster + 1 };
+
+		VulkanLightClusteringPass(const VkDevice& _logicalDevice, const VkBuffer& _buffer);
+		~VulkanLightClusteringPass();
+
+		// _dynamicOffsets are the frame's light and cluster light list allocations, in that order
+		void Record(const VkCommandBuffer& _cmdBuffer, const std::array<uint32, 2>& _dynamicOffsets, const LightClusteringConstants& _constants) const noexcept;
+
+		VulkanLightClusteringPass(const VulkanLightClusteringPass&) = delete;
+		VulkanLightClusteringPass& operator=(const VulkanLightClusteringPass&) = delete;
+		VulkanLightClusteringPass(VulkanLightClusteringPass&&) = delete;
+		VulkanLightClusteringPass& operator=(VulkanLightClusteringPass&&) = delete;
+
+	private:
+		VkDevice m_LogicalDevice;
+		VkDescriptorSetLayout m_DescriptorSetLayout;
+		VkDescriptorPool m_DescriptorPool;
+		VkDescriptorSet m_DescriptorSet;
+		std::unique_ptr<VulkanComputePipeline> m_Pipeline;
+	};
+} // End of Banshee namespace
\ No newline at end of file
@@ -0,0 +1,631 @@
+#include "VulkanRenderGraph.h"
+#include "VulkanUtils.h"
+#include "Foundation/Logging/Logger.h"
+#include <vulkan/vulkan.h>
+#include <algorithm>
+#include <stdexcept>
+
+namespace Banshee
+{
+	constexpr static uint32 g_InvalidPass{ UINT32_MAX };
+
+	struct AccessState
+	{
+		VkImageLayout m_Layout;
+		VkPipelineStageFlags2 m_Stage;
+		VkAccessFlags2 m_Access;
+	};
+
+	static AccessState GetAccessState(const RenderGraphAccess _access) noexcept
+	{
+		switch (_access)
+		{
+		case RenderGraphAccess::ColorAttachment:
+			return { VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL, VK_PIPELINE_STAGE_2_COLOR_ATTACHMENT_OUTPUT_BIT,
+				VK_ACCESS_2_COLOR_ATTACHMENT_READ_BIT | VK_ACCESS_2_COLOR_ATTACHMENT_WRITE_BIT };
+		case RenderGraphAccess::DepthAttachment:
+			return { VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL, VK_PIPELINE_STAGE_2_EARLY_FRAGMENT_TESTS_BIT | VK_PIPELINE_STAGE_2_LATE_FRAGMENT_TESTS_BIT,
+				VK_ACCESS_2_DEPTH_STENCIL_ATTACHMENT_READ_BIT | VK_ACCESS_2_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT };
+		case RenderGraphAccess::DepthRead:
+			return { VK_IMAGE_LAYOUT_DEPTH_STENCIL_READ_ONLY_OPTIMAL, VK_PIPELINE_STAGE_2_EARLY_FRAGMENT_TESTS_BIT | VK_PIPELINE_STAGE_2_LATE_FRAGMENT_TESTS_BIT,
+				VK_ACCESS_2_DEPTH_STENCIL_ATTACHMENT_READ_BIT };
+		case RenderGraphAccess::ShaderRead:
+			return { VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL, VK_PIPELINE_STAGE_2_FRAGMENT_SHADER_BIT | VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT,
+				VK_ACCESS_2_SHADER_SAMPLED_READ_BIT };
+		case RenderGraphAccess::StorageWrite:
+			return { VK_IMAGE_LAYOUT_GENERAL, VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT, VK_ACCESS_2_SHADER_STORAGE_READ_BIT | VK_ACCESS_2_SHADER_STORAGE_WRITE_BIT };
+		case RenderGraphAccess::Present:
+		default:
+			return { VK_IMAGE_LAYOUT_PRESENT_SRC_KHR, VK_PIPELINE_STAGE_2_NONE, VK_ACCESS_2_NONE };
+		}
+	}
+
+	static bool IsWrite(const RenderGraphAccess _access) noexcept
+	{
+		return _access == RenderGraphAccess::ColorAttachment || _access == RenderGraphAccess::DepthAttachment || _access == RenderGraphAccess::StorageWrite;
+	}
+
+	// Attachments that aren't cleared load what the previous writer left, which makes the pass depend on that writer
+	static bool ReadsContents(const RenderGraphAccess _access, const bool _clear) noexcept
+	{
+		return !IsWrite(_access) || !_clear;
+	}
+
+	static bool IsDepthFormat(const VkFormat _format) noexcept
+	{
+		switch (_format)
+		{
+		case VK_FORMAT_D16_UNORM:
+		case VK_FORMAT_X8_D24_UNORM_PACK32:
+		case VK_FORMAT_D32_SFLOAT:
+		case VK_FORMAT_D16_UNORM_S8_UINT:
+		case VK_FORMAT_D24_UNORM_S8_UINT:
+		case VK_FORMAT_D32_SFLOAT_S8_UINT:
+			return true;
+		default:
+			return false;
+		}
+	}
+
+	// Without separateDepthStencilLayouts, barriers on combined formats have to cover both aspects
+	static VkImageAspectFlags GetBarrierAspect(const VkFormat _format) noexcept
+	{
+		switch (_format)
+		{
+		case VK_FORMAT_D16_UNORM_S8_UINT:
+		case VK_FORMAT_D24_UNORM_S8_UINT:
+		case VK_FORMAT_D32_SFLOAT_S8_UINT:
+			return VK_IMAGE_ASPECT_DEPTH_BIT | VK_IMAGE_ASPECT_STENCIL_BIT;
+		default:
+			return IsDepthFormat(_format) ? VK_IMAGE_ASPECT_DEPTH_BIT : VK_IMAGE_ASPECT_COLOR_BIT;
+		}
+	}
+
+	static uint64 AlignOffset(const uint64 _offset, const uint64 _alignment) noexcept
+	{
+		return (_offset + _alignment - 1) / _alignment * _alignment;
+	}
+
+	RenderGraphBuilder::RenderGraphBuilder(VulkanRenderGraph& _graph, const uint32 _pass) noexcept :
+		m_Graph{ _graph },
+		m_Pass{ _pass }
+	{
+	}
+
+	void RenderGraphBuilder::WriteColor(const RenderGraphResource _resource) noexcept
+	{
+		m_Graph.m_Passes[m_Pass].m_Accesses.push_back({ _resource, RenderGraphAccess::ColorAttachment, false });
+	}
+
+	void RenderGraphBuilder::WriteColor(const RenderGraphResource _resource, const glm::vec4& _clearColor) noexcept
+	{
+		m_Graph.m_Passes[m_Pass].m_Accesses.push_back({ _resource, RenderGraphAccess::ColorAttachment, true });
+		m_Graph.m_Passes[m_Pass].m_ClearColor = _clearColor;
+	}
+
+	void RenderGraphBuilder::WriteDepth(const RenderGraphResource _resource) noexcept
+	{
+		m_Graph.m_Passes[m_Pass].m_Accesses.push_back({ _resource, RenderGraphAccess::DepthAttachment, false });
+	}
+
+	void RenderGraphBuilder::WriteDepth(const RenderGraphResource _resource, const float _clearDepth) noexcept
+	{
+		m_Graph.m_Passes[m_Pass].m_Accesses.push_back({ _resource, RenderGraphAccess::DepthAttachment, true });
+		m_Graph.m_Passes[m_Pass].m_ClearDepth = _clearDepth;
+	}
+
+	void RenderGraphBuilder::ReadDepth(const RenderGraphResource _resource) noexcept
+	{
+		m_Graph.m_Passes[m_Pass].m_Accesses.push_back({ _resource, RenderGraphAccess::DepthRead, false });
+	}
+
+	void RenderGraphBuilder::ReadTexture(const RenderGraphResource _resource) noexcept
+	{
+		m_Graph.m_Passes[m_Pass].m_Accesses.push_back({ _resource, RenderGraphAccess::ShaderRead, false });
+	}
+
+	void RenderGraphBuilder::WriteStorage(const RenderGraphResource _resource) noexcept
+	{
+		m_Graph.m_Passes[m_Pass].m_Accesses.push_back({ _resource, RenderGraphAccess::StorageWrite, true });
+	}
+
+	void RenderGraphBuilder::UseSecondaryCommandBuffers() noexcept
+	{
+		m_Graph.m_Passes[m_Pass].m_SecondaryCommandBuffers = true;
+	}
+
+	void RenderGraphBuilder::SetSideEffects() noexcept
+	{
+		m_Graph.m_Passes[m_Pass].m_SideEffects = true;
+	}
+
+	VulkanRenderGraph::VulkanRenderGraph(const VkDevice& _logicalDevice, const VkPhysicalDevice& _gpu) noexcept :
+		m_LogicalDevice{ _logicalDevice },
+		m_PhysicalDevice{ _gpu },
+		m_Resources{},
+		m_Passes{},
+		m_FinalBarriers{},
+		m_TransientMemory{ VK_NULL_HANDLE },
+		m_Stats{}
+	{
+	}
+
+	VulkanRenderGraph::~VulkanRenderGraph()
+	{
+		ReleaseTransientImages();
+	}
+
+	RenderGraphResource VulkanRenderGraph::CreateImage(const char* _name, const RenderGraphImageDesc& _desc)
+	{
+		m_Resources.push_back({ _name, _desc, RenderGraphAccess::ShaderRead, false, false, VK_NULL_HANDLE, VK_NULL_HANDLE, 0, g_InvalidPass, g_InvalidPass, 0 });
+		return static_cast<RenderGraphResource>(m_Resources.size() - 1);
+	}
+
+	RenderGraphResource VulkanRenderGraph::ImportImage(const char* _name, const RenderGraphImageDesc& _desc, const RenderGraphAccess _finalAccess, const bool _preserveContents)
+	{
+		m_Resources.push_back({ _name, _desc, _finalAccess, true, _preserveContents, VK_NULL_HANDLE, VK_NULL_HANDLE, 0, g_InvalidPass, g_InvalidPass, 0 });
+		return static_cast<RenderGraphResource>(m_Resources.size() - 1);
+	}
+
+	void VulkanRenderGraph::SetImportedImage(const RenderGraphResource _resource, const VkImage& _image, const VkImageView& _imageView) noexcept
+	{
+		m_Resources[_resource].m_Image = _image;
+		m_Resources[_resource].m_ImageView = _imageView;
+	}
+
+	void VulkanRenderGraph::AddPass(const char* _name, const SetupCallback& _setup, const ExecuteCallback& _execute, const ConditionCallback& _condition)
+	{
+		m_Passes.push_back({ _name, _execute, _condition, {}, {}, glm::vec4(0.0f), 1.0f, 0, false, false, false });
+
+		RenderGraphBuilder builder{ *this, static_cast<uint32>(m_Passes.size() - 1) };
+		_setup(builder);
+	}
+
+	void VulkanRenderGraph::Compile()
+	{
+		ReleaseTransientImages();
+		m_Stats = {};
+
+		CullPasses();
+		ComputeLifetimes();
+		AllocateTransientImages();
+		BuildBarriers();
+
+		BE_LOG(LogCategory::Info, "[RENDER GRAPH]: Compiled %u passes (%u culled), %u barriers, %llu KB of transient memory (%llu KB without aliasing)",
+			m_Stats.m_Passes, m_Stats.m_CulledPasses, m_Stats.m_Barriers, m_Stats.m_TransientMemory / 1024, m_Stats.m_UnaliasedMemory / 1024);
+	}
+
+	void VulkanRenderGraph::CullPasses()
+	{
+		// A pass is referenced once per image it writes and an image once per pass reading it. Imported images are always consumed
+		for (Resource& resource : m_Resources)
+		{
+			resource.m_RefCount = resource.m_Imported ? 1 : 0;
+		}
+
+		for (Pass& pass : m_Passes)
+		{
+			pass.m_Culled = false;
+			pass.m_RefCount = 0;
+
+			for (const PassAccess& access : pass.m_Accesses)
+			{
+				pass.m_RefCount += IsWrite(access.m_Access) ? 1 : 0;
+				m_Resources[access.m_Resource].m_RefCount += ReadsContents(access.m_Access, access.m_Clear) ? 1 : 0;
+			}
+		}
+
+		// Culling a pass releases the images it reads, which can leave their writers unreferenced in turn
+		std::vector<RenderGraphResource> unreferenced{};
+		const auto cullPass = [this, &unreferenced](Pass& _pass)
+			{
+				_pass.m_Culled = true;
+				for (const PassAccess& access : _pass.m_Accesses)
+				{
+					if (ReadsContents(access.m_Access, access.m_Clear) && --m_Resources[access.m_Resource].m_RefCount == 0)
+					{
+						unreferenced.push_back(access.m_Resource);
+					}
+				}
+			};
+
+		for (Pass& pass : m_Passes)
+		{
+			if (pass.m_RefCount == 0 && !pass.m_SideEffects)
+			{
+				cullPass(pass);
+			}
+		}
+
+		for (RenderGraphResource i = 0; i < m_Resources.size(); ++i)
+		{
+			if (m_Resources[i].m_RefCount == 0)
+			{
+				unreferenced.push_back(i);
+			}
+		}
+
+		while (!unreferenced.empty())
+		{
+			const RenderGraphResource resource = unreferenced.back();
+			unreferenced.pop_back();
+
+			for (Pass& pass : m_Passes)
+			{
+				if (pass.m_Culled || pass.m_SideEffects)
+				{
+					continue;
+				}
+
+				for (const PassAccess& access : pass.m_Accesses)
+				{
+					if (access.m_Resource == resource && IsWrite(access.m_Access) && --pass.m_RefCount == 0)
+					{
+						cullPass(pass);
+						break;
+					}
+				}
+			}
+		}
+
+		for (const Pass& pass : m_Passes)
+		{
+			++(pass.m_Culled ? m_Stats.m_CulledPasses : m_Stats.m_Passes);
+		}
+	}
+
+	void VulkanRenderGraph::ComputeLifetimes() noexcept
+	{
+		for (Resource& resource : m_Resources)
+		{
+			resource.m_FirstPass = g_InvalidPass;
+			resource.m_LastPass = g_InvalidPass;
+		}
+
+		for (uint32 i = 0; i < m_Passes.size(); ++i)
+		{
+			if (m_Passes[i].m_Culled)
+			{
+				continue;
+			}
+
+			for (const PassAccess& access : m_Passes[i].m_Accesses)
+			{
+				Resource& resource = m_Resources[access.m_Resource];
+				resource.m_FirstPass = std::min(resource.m_FirstPass, i);
+				resource.m_LastPass = resource.m_LastPass == g_InvalidPass ? i : std::max(resource.m_LastPass, i);
+			}
+		}
+	}
+
+	void VulkanRenderGraph::AllocateTransientImages()
+	{
+		struct Placement
+		{
+			RenderGraphResource m_Resource;
+			uint64 m_Offset;
+			uint64 m_Size;
+		};
+
+		std::vector<Placement> placements{};
+		std::vector<VkMemoryRequirements> requirements{};
+		uint32 memoryTypeBits{ UINT32_MAX };
+
+		for (RenderGraphResource i = 0; i < m_Resources.size(); ++i)
+		{
+			Resource& resource = m_Resources[i];
+			if (resource.m_Imported || resource.m_FirstPass == g_InvalidPass)
+			{
+				continue;
+			}
+
+			VkImageCreateInfo imageCreateInfo{};
+			imageCreateInfo.sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
+			imageCreateInfo.imageType = VK_IMAGE_TYPE_2D;
+			imageCreateInfo.extent = { resource.m_Desc.m_Width, resource.m_Desc.m_Height, 1 };
+			imageCreateInfo.mipLevels = 1;
+			imageCreateInfo.arrayLayers = 1;
+			imageCreateInfo.format = static_cast<VkFormat>(resource.m_Desc.m_Format);
+			imageCreateInfo.tiling = VK_IMAGE_TILING_OPTIMAL;
+			imageCreateInfo.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+			imageCreateInfo.usage = resource.m_Desc.m_Usage;
+			imageCreateInfo.samples = VK_SAMPLE_COUNT_1_BIT;
+			imageCreateInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+
+			if (vkCreateImage(m_LogicalDevice, &imageCreateInfo, nullptr, &resource.m_Image) != VK_SUCCESS)
+			{
+				throw std::runtime_error("ERROR: Failed to create render graph image " + resource.m_Name);
+			}
+
+			VkMemoryRequirements memoryRequirements{};
+			vkGetImageMemoryRequirements(m_LogicalDevice, resource.m_Image, &memoryRequirements);
+			memoryTypeBits &= memoryRequirements.memoryTypeBits;
+			m_Stats.m_UnaliasedMemory += memoryRequirements.size;
+
+			placements.push_back({ i, 0, memoryRequirements.size });
+			requirements.push_back(memoryRequirements);
+		}
+
+		if (placements.empty())
+		{
+			return;
+		}
+
+		if (memoryTypeBits == 0)
+		{
+			throw std::runtime_error("ERROR: Render graph transient images have no memory type in common");
+		}
+
+		// Largest first, each image goes to the lowest offset that doesn't overlap an image alive during any of the same passes
+		std::vector<uint32> order(placements.size());
+		for (uint32 i = 0; i < order.size(); ++i)
+		{
+			order[i] = i;
+		}
+		std::sort(order.begin(), order.end(), [&placements](const uint32 _a, const uint32 _b) { return placements[_a].m_Size > placements[_b].m_Size; });
+
+		std::vector<Placement> placed{};
+		std::vector<Placement> overlapping{};
+		for (const uint32 index : order)
+		{
+			Placement& placement = placements[index];
+			const Resource& resource = m_Resources[placement.m_Resource];
+
+			overlapping.clear();
+			for (const Placement& other : placed)
+			{
+				const Resource& otherResource = m_Resources[other.m_Resource];
+				if (resource.m_FirstPass <= otherResource.m_LastPass && otherResource.m_FirstPass <= resource.m_LastPass)
+				{
+					overlapping.push_back(other);
+				}
+			}
+			std::sort(overlapping.begin(), overlapping.end(), [](const Placement& _a, const Placement& _b) { return _a.m_Offset < _b.m_Offset; });
+
+			const uint64 alignment = requirements[index].alignment;
+			uint64 offset{ 0 };
+			for (const Placement& other : overlapping)
+			{
+				offset = AlignOffset(offset, alignment);
+				if (offset + placement.m_Size <= other.m_Offset)
+				{
+					break;
+				}
+				offset = std::max(offset, other.m_Offset + other.m_Size);
+			}
+
+			placement.m_Offset = AlignOffset(offset, alignment);
+			m_Stats.m_TransientMemory = std::max(m_Stats.m_TransientMemory, placement.m_Offset + placement.m_Size);
+			placed.push_back(placement);
+		}
+
+		VkMemoryAllocateInfo allocateInfo{};
+		allocateInfo.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
+		allocateInfo.allocationSize = m_Stats.m_TransientMemory;
+		allocateInfo.memoryTypeIndex = VulkanUtils::FindMemoryTypeIndex(m_PhysicalDevice, memoryTypeBits, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
+
+		if (vkAllocateMemory(m_LogicalDevice, &allocateInfo, nullptr, &m_TransientMemory) != VK_SUCCESS)
+		{
+			throw std::runtime_error("ERROR: Failed to allocate render graph transient memory");
+		}
+
+		for (const Placement& placement : placements)
+		{
+			Resource& resource = m_Resources[placement.m_Resource];
+			resource.m_MemoryOffset = placement.m_Offset;
+			vkBindImageMemory(m_LogicalDevice, resource.m_Image, m_TransientMemory, placement.m_Offset);
+
+			const VkFormat format = static_cast<VkFormat>(resource.m_Desc.m_Format);
+			VulkanUtils::CreateImageView(m_LogicalDevice, resource.m_Image, format, IsDepthFormat(format) ? VK_IMAGE_ASPECT_DEPTH_BIT : VK_IMAGE_ASPECT_COLOR_BIT, resource.m_ImageView);
+		}
+	}
+
+	void VulkanRenderGraph::BuildBarriers()
+	{
+		// Imported images start the frame undefined after the acquire semaphore, which is waited on at color attachment output.
+		// Transient images may still be used by the previous frame or by an image aliasing their memory, so their first use waits on everything.
+		// Preserved images start where the previous frame left them, so their first write also waits for that frame's reads
+		std::vector<AccessState> states(m_Resources.size());
+		for (RenderGraphResource i = 0; i < m_Resources.size(); ++i)
+		{
+			const Resource& resource = m_Resources[i];
+			if (resource.m_PreserveContents)
+			{
+				states[i] = GetAccessState(resource.m_FinalAccess);
+				continue;
+			}
+
+			states[i] = resource.m_Imported ?
+				AccessState{ VK_IMAGE_LAYOUT_UNDEFINED, VK_PIPELINE_STAGE_2_COLOR_ATTACHMENT_OUTPUT_BIT, VK_ACCESS_2_NONE } :
+				AccessState{ VK_IMAGE_LAYOUT_UNDEFINED, VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT, VK_ACCESS_2_MEMORY_WRITE_BIT };
+		}
+
+		const auto transition = [&states](const RenderGraphResource _resource, const AccessState& _target, const bool _write, std::vector<Barrier>& _outBarriers)
+			{
+				AccessState& state = states[_resource];
+				constexpr VkAccessFlags2 writeMask = VK_ACCESS_2_COLOR_ATTACHMENT_WRITE_BIT | VK_ACCESS_2_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT | VK_ACCESS_2_SHADER_STORAGE_WRITE_BIT |
+					VK_ACCESS_2_MEMORY_WRITE_BIT;
+
+				// Reads following reads in the same layout need no barrier, but a later write has to wait for all of them
+				if (state.m_Layout == _target.m_Layout && !_write && (state.m_Access & writeMask) == 0)
+				{
+					state.m_Stage |= _target.m_Stage;
+					state.m_Access |= _target.m_Access;
+					return;
+				}
+
+				_outBarriers.push_back({ _resource, static_cast<uint32>(state.m_Layout), static_cast<uint32>(_target.m_Layout),
+					state.m_Stage, state.m_Access, _target.m_Stage, _target.m_Access });
+				state = _target;
+			};
+
+		for (Pass& pass : m_Passes)
+		{
+			pass.m_Barriers.clear();
+			if (pass.m_Culled)
+			{
+				continue;
+			}
+
+			for (const PassAccess& access : pass.m_Accesses)
+			{
+				transition(access.m_Resource, GetAccessState(access.m_Access), IsWrite(access.m_Access), pass.m_Barriers);
+			}
+			m_Stats.m_Barriers += static_cast<uint32>(pass.m_Barriers.size());
+		}
+
+		m_FinalBarriers.clear();
+		for (RenderGraphResource i = 0; i < m_Resources.size(); ++i)
+		{
+			if (m_Resources[i].m_Imported && m_Resources[i].m_FirstPass != g_InvalidPass)
+			{
+				// Preserved images already read in their final layout need no barrier, the next frame's first write waits for those reads
+				transition(i, GetAccessState(m_Resources[i].m_FinalAccess), !m_Resources[i].m_PreserveContents, m_FinalBarriers);
+			}
+		}
+		m_Stats.m_Barriers += static_cast<uint32>(m_FinalBarriers.size());
+	}
+
+	void VulkanRenderGraph::ReleaseTransientImages() noexcept
+	{
+		for (Resource& resource : m_Resources)
+		{
+			if (resource.m_Imported)
+			{
+				continue;
+			}
+
+			vkDestroyImageView(m_LogicalDevice, resource.m_ImageView, nullptr);
+			vkDestroyImage(m_LogicalDevice, resource.m_Image, nullptr);
+			resource.m_ImageView = VK_NULL_HANDLE;
+			resource.m_Image = VK_NULL_HANDLE;
+		}
+
+		vkFreeMemory(m_LogicalDevice, m_TransientMemory, nullptr);
+		m_TransientMemory = VK_NULL_HANDLE;
+	}
+
+	void VulkanRenderGraph::Execute(const VkCommandBuffer& _cmdBuffer) const
+	{
+		for (const Pass& pass : m_Passes)
+		{
+			if (!pass.m_Culled)
+			{
+				RecordBarriers(_cmdBuffer, pass.m_Barriers);
+				RecordPass(_cmdBuffer, pass);
+			}
+		}
+
+		RecordBarriers(_cmdBuffer, m_FinalBarriers);
+	}
+
+	void VulkanRenderGraph::RecordBarriers(const VkCommandBuffer& _cmdBuffer, const std::vector<Barrier>& _barriers) const
+	{
+		if (_barriers.empty())
+		{
+			return;
+		}
+
+		std::vector<VkImageMemoryBarrier2> imageBarriers(_barriers.size());
+		for (uint32 i = 0; i < _barriers.size(); ++i)
+		{
+			const Barrier& barrier = _barriers[i];
+			const Resource& resource = m_Resources[barrier.m_Resource];
+
+			VkImageMemoryBarrier2& imageBarrier = imageBarriers[i];
+			imageBarrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER_2;
+			imageBarrier.srcStageMask = barrier.m_SrcStage;
+			imageBarrier.srcAccessMask = barrier.m_SrcAccess;
+			imageBarrier.dstStageMask = barrier.m_DstStage;
+			imageBarrier.dstAccessMask = barrier.m_DstAccess;
+			imageBarrier.oldLayout = static_cast<VkImageLayout>(barrier.m_OldLayout);
+			imageBarrier.newLayout = static_cast<VkImageLayout>(barrier.m_NewLayout);
+			imageBarrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+			imageBarrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+			imageBarrier.image = resource.m_Image;
+			imageBarrier.subresourceRange.aspectMask = GetBarrierAspect(static_cast<VkFormat>(resource.m_Desc.m_Format));
+			imageBarrier.subresourceRange.baseMipLevel = 0;
+			imageBarrier.subresourceRange.levelCount = VK_REMAINING_MIP_LEVELS;
+			imageBarrier.subresourceRange.baseArrayLayer = 0;
+			imageBarrier.subresourceRange.layerCount = 1;
+		}
+
+		VkDependencyInfo dependencyInfo{};
+		dependencyInfo.sType = VK_STRUCTURE_TYPE_DEPENDENCY_INFO;
+		dependencyInfo.imageMemoryBarrierCount = static_cast<uint32>(imageBarriers.size());
+		dependencyInfo.pImageMemoryBarriers = imageBarriers.data();
+
+		vkCmdPipelineBarrier2(_cmdBuffer, &dependencyInfo);
+	}
+
+	void VulkanRenderGraph::RecordPass(const VkCommandBuffer& _cmdBuffer, const Pass& _pass) const
+	{
+		// A skipped pass still had its barriers recorded, so the layouts later barriers were compiled against stay valid
+		if (_pass.m_Condition && !_pass.m_Condition())
+		{
+			return;
+		}
+
+		VkRenderingAttachmentInfo colorAttachment{};
+		VkRenderingAttachmentInfo depthAttachment{};
+		uint32 colorAttachmentCount{ 0 };
+		bool hasDepthAttachment{ false };
+		VkExtent2D extent{ 0, 0 };
+
+		for (uint32 i = 0; i < _pass.m_Accesses.size(); ++i)
+		{
+			const PassAccess& access = _pass.m_Accesses[i];
+			if (access.m_Access != RenderGraphAccess::ColorAttachment && access.m_Access != RenderGraphAccess::DepthAttachment && access.m_Access != RenderGraphAccess::DepthRead)
+			{
+				continue;
+			}
+
+			// Transient contents nobody reads after this pass don't need to reach memory
+			const Resource& resource = m_Resources[access.m_Resource];
+			const bool keepContents = resource.m_Imported || resource.m_LastPass != static_cast<uint32>(&_pass - m_Passes.data());
+			const bool isColor = access.m_Access == RenderGraphAccess::ColorAttachment;
+
+			VkRenderingAttachmentInfo& attachment = isColor ? colorAttachment : depthAttachment;
+			attachment.sType = VK_STRUCTURE_TYPE_RENDERING_ATTACHMENT_INFO;
+			attachment.imageView = resource.m_ImageView;
+			attachment.imageLayout = GetAccessState(access.m_Access).m_Layout;
+			attachment.loadOp = access.m_Clear ? VK_ATTACHMENT_LOAD_OP_CLEAR : VK_ATTACHMENT_LOAD_OP_LOAD;
+			attachment.storeOp = access.m_Access == RenderGraphAccess::DepthRead ? VK_ATTACHMENT_STORE_OP_NONE :
+				(keepContents ? VK_ATTACHMENT_STORE_OP_STORE : VK_ATTACHMENT_STORE_OP_DONT_CARE);
+
+			if (isColor)
+			{
+				attachment.clearValue.color = { { _pass.m_ClearColor.r, _pass.m_ClearColor.g, _pass.m_ClearColor.b, _pass.m_ClearColor.a } };
+				colorAttachmentCount = 1;
+			}
+			else
+			{
+				attachment.clearValue.depthStencil = { _pass.m_ClearDepth, 0 };
+				hasDepthAttachment = true;
+			}
+
+			extent = { resource.m_Desc.m_Width, resource.m_Desc.m_Height };
+		}
+
+		// Passes without attachments (compute, copies) are recorded outside of a rendering scope
+		if (colorAttachmentCount == 0 && !hasDepthAttachment)
+		{
+			_pass.m_Execute(_cmdBuffer);
+			return;
+		}
+
+		VkRenderingInfo renderingInfo{};
+		renderingInfo.sType = VK_STRUCTURE_TYPE_RENDERING_INFO;
+		renderingInfo.flags = _pass.m_SecondaryCommandBuffers ? VK_RENDERING_CONTENTS_SECONDARY_COMMAND_BUFFERS_BIT : 0;
+		renderingInfo.renderArea.offset = { 0, 0 };
+		renderingInfo.renderArea.extent = extent;
+		renderingInfo.layerCount = 1;
+		renderingInfo.colorAttachmentCount = colorAttachmentCount;
+		renderingInfo.pColorAttachments = colorAttachmentCount > 0 ? &colorAttachment : nullptr;
+		renderingInfo.pDepthAttachment = hasDepthAttachment ? &depthAttachment : nullptr;
+
+		vkCmdBeginRendering(_cmdBuffer, &renderingInfo);
+		_pass.m_Execute(_cmdBuffer);
+		vkCmdEndRendering(_cmdBuffer);
+	}
+} // End of Banshee namespace
\ No newline at end of file
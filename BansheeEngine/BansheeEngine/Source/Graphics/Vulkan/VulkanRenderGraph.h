@@ -0,0 +1,181 @@
+#pragma once
+
+#include "Foundation/Platform.h"
+#include <glm/glm.hpp>
+#include <functional>
+#include <string>
+#include <vector>
+
+typedef struct VkDevice_T* VkDevice;
+typedef struct VkPhysicalDevice_T* VkPhysicalDevice;
+typedef struct VkCommandBuffer_T* VkCommandBuffer;
+typedef struct VkImage_T* VkImage;
+typedef struct VkImageView_T* VkImageView;
+typedef struct VkDeviceMemory_T* VkDeviceMemory;
+
+namespace Banshee
+{
+	using RenderGraphResource = uint32;
+
+	// How a pass uses an image. Layouts, pipeline stages and access masks of the barriers are derived from these
+	enum class RenderGraphAccess : uint8
+	{
+		ColorAttachment,
+		DepthAttachment,
+		DepthRead,   // Depth tested against without writing, bound as a read-only depth attachment
+		ShaderRead,  // Sampled from a fragment or compute shader
+		StorageWrite,  // Written as a storage image from a compute shader, every mip in the general layout
+		Present
+	};
+
+	struct RenderGraphImageDesc
+	{
+		uint32 m_Width;
+		uint32 m_Height;
+		uint32 m_Format;
+		uint32 m_Usage;
+	};
+
+	struct RenderGraphStats
+	{
+		uint32 m_Passes;
+		uint32 m_CulledPasses;
+		uint32 m_Barriers;
+		uint64 m_TransientMemory;  // Size of the shared allocation transient images are placed in
+		uint64 m_UnaliasedMemory;  // What the same images would take with an allocation each
+	};
+
+	class VulkanRenderGraph;
+
+	// Handed to a pass's setup callback to declare the images the pass reads and writes
+	class RenderGraphBuilder
+	{
+	public:
+		RenderGraphBuilder(VulkanRenderGraph& _graph, const uint32 _pass) noexcept;
+
+		// Overloads taking a clear value clear the attachment when the pass begins, the others load its previous contents
+		void WriteColor(const RenderGraphResource _resource) noexcept;
+		void WriteColor(const RenderGraphResource _resource, const glm::vec4& _clearColor) noexcept;
+		void WriteDepth(const RenderGraphResource _resource) noexcept;
+		void WriteDepth(const RenderGraphResource _resource, const float _clearDepth) noexcept;
+		void ReadDepth(const RenderGraphResource _resource) noexcept;
+		void ReadTexture(const RenderGraphResource _resource) noexcept;
+		// The pass overwrites the whole image from compute, so it doesn't depend on earlier writers
+		void WriteStorage(const RenderGraphResource _resource) noexcept;
+		// The pass only calls vkCmdExecuteCommands between begin and end rendering
+		void UseSecondaryCommandBuffers() noexcept;
+		// The pass has effects the graph can't see (buffer writes, readbacks), so it's never culled
+		void SetSideEffects() noexcept;
+
+	private:
+		VulkanRenderGraph& m_Graph;
+		uint32 m_Pass;
+	};
+
+	// Passes declare the images they use and the graph derives everything in between: it culls passes whose outputs are never consumed,
+	// inserts the layout transitions and barriers between passes, begins dynamic rendering with the declared attachments and places
+	// transient images whose lifetimes don't overlap in the same memory. Only images are tracked, buffer dependencies stay with the passes
+	class VulkanRenderGraph
+	{
+	public:
+		using SetupCallback = std::function<void(RenderGraphBuilder&)>;
+		using ExecuteCallback = std::function<void(const VkCommandBuffer&)>;
+		using ConditionCallback = std::function<bool()>;
+
+		VulkanRenderGraph(const VkDevice& _logicalDevice, const VkPhysicalDevice& _gpu) noexcept;
+		~VulkanRenderGraph();
+
+		// Images owned by the graph, created on Compile() and only valid between the passes that use them
+		RenderGraphResource CreateImage(const char* _name, const RenderGraphImageDesc& _desc);
+		// Images owned elsewhere. Their handles can change every frame through SetImportedImage() and they're left in _finalAccess's layout.
+		// Images with _preserveContents keep what earlier frames rendered (caches), so they have to be in _finalAccess's layout before the first frame
+		RenderGraphResource ImportImage(const char* _name, const RenderGraphImageDesc& _desc, const RenderGraphAccess _finalAccess, const bool _preserveContents = false);
+		void SetImportedImage(const RenderGraphResource _resource, const VkImage& _image, const VkImageView& _imageView) noexcept;
+		// Passes execute in the order they're added. A pass with a _condition is only recorded on frames where it returns true
+		void AddPass(const char* _name, const SetupCallback& _setup, const ExecuteCallback& _execute, const ConditionCallback& _condition = nullptr);
+
+		void Compile();
+		void Execute(const VkCommandBuffer& _cmdBuffer) const;
+
+		VkImageView GetImageView(const RenderGraphResource _resource) const noexcept { return m_Resources[_resource].m_ImageView; }
+		uint32 GetFormat(const RenderGraphResource _resource) const noexcept { return m_Resources[_resource].m_Desc.m_Format; }
+		const RenderGraphStats& GetStats() const noexcept { return m_Stats; }
+
+		VulkanRenderGraph(const VulkanRenderGraph&) = delete;
+		VulkanRenderGraph& operator=(const VulkanRenderGraph&) = delete;
+		VulkanRenderGraph(VulkanRenderGraph&&) = delete;
+		VulkanRenderGraph& operator=(VulkanRenderGraph&&) = delete;
+
+	private:
+		friend class RenderGraphBuilder;
+
+		struct Resource
+		{
+			std::string m_Name;
+			RenderGraphImageDesc m_Desc;
+			RenderGraphAccess m_FinalAccess;
+			bool m_Imported;
+			bool m_PreserveContents;
+			VkImage m_Image;
+			VkImageView m_ImageView;
+			uint64 m_MemoryOffset;
+			uint32 m_FirstPass;  // Lifetime over the passes that survived culling
+			uint32 m_LastPass;
+			uint32 m_RefCount;
+		};
+
+		struct PassAccess
+		{
+			RenderGraphResource m_Resource;
+			RenderGraphAccess m_Access;
+			bool m_Clear;
+		};
+
+		// Precomputed on Compile(), only the image handle is filled in when executing
+		struct Barrier
+		{
+			RenderGraphResource m_Resource;
+			uint32 m_OldLayout;
+			uint32 m_NewLayout;
+			uint64 m_SrcStage;
+			uint64 m_SrcAccess;
+			uint64 m_DstStage;
+			uint64 m_DstAccess;
+		};
+
+		struct Pass
+		{
+			std::string m_Name;
+			ExecuteCallback m_Execute;
+			ConditionCallback m_Condition;
+			std::vector<PassAccess> m_Accesses;
+			std::vector<Barrier> m_Barriers;
+			glm::vec4 m_ClearColor;
+			float m_ClearDepth;
+			uint32 m_RefCount;
+			bool m_SecondaryCommandBuffers;
+			bool m_SideEffects;
+			bool m_Culled;
+		};
+
+	private:
+		void CullPasses();
+		void ComputeLifetimes() noexcept;
+		void AllocateTransientImages();
+		void BuildBarriers();
+		void ReleaseTransientImages() noexcept;
+		void RecordBarriers(const VkCommandBuffer& _cmdBuffer, const std::vector<Barrier>& _barriers) const;
+		void RecordPass(const VkCommandBuffer& _cmdBuffer, const Pass& _pass) const;
+
+	private:
+		VkDevice m_LogicalDevice;
+		VkPhysicalDevice m_PhysicalDevice;
+		std::vector<Resource> m_Resources;
+		std::vector<Pass> m_Passes;
+		// Transitions imported images to their final layout after the last pass
+		std::vector<Barrier> m_FinalBarriers;
+		// Every transient image is bound into this one allocation at the offset aliasing assigned it
+		VkDeviceMemory m_TransientMemory;
+		RenderGraphStats m_Stats;
+	};
+} // End of Banshee namespace
\ No newline at end of file
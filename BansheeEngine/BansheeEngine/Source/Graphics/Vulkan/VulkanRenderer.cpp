@@ -1,240 +1,655 @@
 #include "VulkanRenderer.h"
+#include "VulkanUtils.h"
 #include "Foundation/Logging/Logger.h"
 #include "Foundation/Entity/EntityManager.h"
+#include "Foundation/Events/ComponentEvents.h"
 #include "Graphics/Components/TransformComponent.h"
 #include "Graphics/Components/Light/LightComponent.h"
+#include "Graphics/Components/Light/LightData.h"
 #include "Graphics/Components/MeshComponent.h"
 #include "Graphics/Window.h"
+#include "Foundation/EngineConfig.h"
+#include "Foundation/Jobs/JobSystem.h"
 #include <array>
 #include <algorithm>
+#include <stdexcept>
+#include <cstring>
+#include <cmath>
+#include <limits>
+#include <glm/gtc/matrix_transform.hpp>
 #include <vulkan/vulkan.h>
 
 namespace Banshee
 {
-	constexpr static uint64 g_MaxEntities{ 512 };
+	// Distinct materials that can be resident at once, each one takes a slot of the material buffer
+	constexpr static uint64 g_MaxMaterials{ 512 };
+	// Per-frame room for uniform data other than materials, instances and lights (view-projection matrices, cluster and shadow parameters)
+	constexpr static uint64 g_TransientUniformBytes{ 64 * 1024 };
+	// Below this many batch groups per job, handing work to another thread costs more than recording it
+	constexpr static uint32 g_MinGroupsPerRecordingJob{ 64 };
+	// Screen size (bounding sphere diameter over viewport height) below which a sub-mesh switches from LOD i to LOD i + 1
+	constexpr static std::array<float, g_MaxMeshLods - 1> g_LodScreenSizes{ 0.25f, 0.12f, 0.06f, 0.03f };
+	// A sub-mesh only changes LOD once its screen size is this fraction past the threshold, so objects near a threshold don't flicker between LODs
+	constexpr static float g_LodHysteresis{ 0.1f };
 
-	VulkanRenderer::VulkanRenderer(const Window& _window) :
-		m_VkInstance{},
+	static uint64 AlignUniformSize(const uint64 _size, const uint64 _alignment) noexcept
+	{
+		return (_size + _alignment - 1) & ~(_alignment - 1);
+	}
+
+	// Dynamic offsets of uniform and storage buffers both have to respect their own alignment, so the frame allocator uses the larger one
+	static uint64 GetFrameAllocatorAlignment(const VkPhysicalDeviceLimits& _limits) noexcept
+	{
+		return std::max(_limits.minUniformBufferOffsetAlignment, _limits.minStorageBufferOffsetAlignment);
+	}
+
+	// Materials are an std430 array in the shaders, whose stride is the struct size rounded up to its vec4 alignment
+	static uint64 GetMaterialStride() noexcept
+	{
+		return AlignUniformSize(sizeof(Material), sizeof(glm::vec4));
+	}
+
+	static uint64 GetFrameCapacity(const VkPhysicalDeviceLimits& _limits, const EngineConfig& _config) noexcept
+	{
+		const uint64 alignment = GetFrameAllocatorAlignment(_limits);
+		const uint64 maxInstances = _config.m_MaxInstances;
+		uint64 capacity = AlignUniformSize(GetMaterialStride() * g_MaxMaterials, alignment) + AlignUniformSize(sizeof(InstanceData) * maxInstances, alignment) + g_TransientUniformBytes;
+
+		// Lights and the per-cluster light lists of the clustering pass
+		capacity += AlignUniformSize(sizeof(LightData) * VulkanLightClusteringPass::s_MaxLights, alignment) +
+			AlignUniformSize(sizeof(uint32) * VulkanLightClusteringPass::s_ClusterCount * VulkanLightClusteringPass::s_ClusterListStride, alignment);
+
+		// Instances of the casters drawn into redrawn shadow tiles
+		capacity += AlignUniformSize(sizeof(InstanceData) * maxInstances, alignment);
+
+		// Objects and batches staged for the culling pass's scene buffer, draw commands and draw counts. There can't be more batches or groups than instances
+		if (_config.m_GpuDrivenRendering)
+		{
+			capacity += AlignUniformSize(sizeof(CullObject) * maxInstances, alignment) + 2 * AlignUniformSize(sizeof(DrawBatch) * maxInstances, alignment) +
+				AlignUniformSize(sizeof(uint32) * maxInstances, alignment);
+
+			// The second occlusion culling phase's instances, draw commands and draw counts, and the first phase's visibility flags
+			if (_config.m_OcclusionCulling)
+			{
+				capacity += AlignUniformSize(sizeof(DrawBatch) * maxInstances, alignment) + AlignUniformSize(sizeof(InstanceData) * maxInstances, alignment) +
+					2 * AlignUniformSize(sizeof(uint32) * maxInstances, alignment);
+			}
+		}
+
+		return capacity;
+	}
+
+	static uint32 FindDepthFormat(const VkPhysicalDevice& _gpu)
+	{
+		return static_cast<uint32>(VulkanUtils::FindSupportedFormat
+		(
+			_gpu,
+			{ VK_FORMAT_D32_SFLOAT, VK_FORMAT_D32_SFLOAT_S8_UINT, VK_FORMAT_D24_UNORM_S8_UINT },
+			VK_IMAGE_TILING_OPTIMAL,
+			VK_FORMAT_FEATURE_DEPTH_STENCIL_ATTACHMENT_BIT
+		));
+	}
+
+	// Walks from the LOD used last frame towards the one matching the screen size, only crossing thresholds by more than the hysteresis
+	static uint32 SelectLod(const Mesh& _subMesh, const float _screenSize) noexcept
+	{
+		uint32 lod = std::min(_subMesh.GetSelectedLod(), _subMesh.lodCount - 1);
+		while (lod > 0 && _screenSize > g_LodScreenSizes[lod - 1] * (1.0f + g_LodHysteresis))
+		{
+			--lod;
+		}
+
+		while (lod + 1 < _subMesh.lodCount && _screenSize < g_LodScreenSizes[lod] * (1.0f - g_LodHysteresis))
+		{
+			++lod;
+		}
+
+		return lod;
+	}
+
+	VulkanRenderer::VulkanRenderer(const Window& _window, const EngineConfig& _config, JobSystem& _jobSystem) :
+		m_VkInstance{ _window.IsHeadless() },
 		m_VkSurface{ _window.GetWindow(), m_VkInstance.Get() },
 		m_VkDevice{ m_VkInstance.Get(), m_VkSurface.Get() },
 		m_VkSwapchain{ m_VkDevice.GetLogicalDevice(), m_VkDevice.GetPhysicalDevice(), m_VkSurface.Get(), _window.GetWidth(), _window.GetHeight() },
-		m_DepthBuffer{ m_VkDevice.GetLogicalDevice(), m_VkDevice.GetPhysicalDevice(), m_VkSwapchain.GetWidth(), m_VkSwapchain.GetHeight() },
-		m_VkRenderPass{ m_VkDevice.GetLogicalDevice(), m_VkSwapchain.GetFormat(), static_cast<uint32>(m_DepthBuffer.GetFormat()) },
+		m_DepthFormat{ FindDepthFormat(m_VkDevice.GetPhysicalDevice()) },
 		m_VkCommandPool{ m_VkDevice.GetLogicalDevice(), m_VkDevice.GetQueueIndices().m_GraphicsQueueFamilyIndex },
-		m_VkCommandBuffers{ m_VkDevice.GetLogicalDevice(), m_VkCommandPool.Get(), static_cast<uint16>(m_VkSwapchain.GetImageViews().size()) },
-		m_VkFramebuffers{ m_VkDevice.GetLogicalDevice(), m_VkRenderPass.Get(), m_VkSwapchain.GetImageViews(), m_DepthBuffer.GetImageView(), m_VkSwapchain.GetWidth(), m_VkSwapchain.GetHeight() },
-		m_VkSemaphores{ m_VkDevice.GetLogicalDevice(), static_cast<uint16>(m_VkSwapchain.GetImageViews().size()) },
-		m_VkInFlightFences{ m_VkDevice.GetLogicalDevice(), static_cast<uint16>(m_VkSwapchain.GetImageViews().size()) },
+		m_RenderGraph{ m_VkDevice.GetLogicalDevice(), m_VkDevice.GetPhysicalDevice() },
+		m_BackbufferResource{ 0 },
+		m_ShadowAtlas{ m_VkDevice.GetLogicalDevice(), m_VkDevice.GetPhysicalDevice(), m_VkCommandPool.Get(), m_VkDevice.GetGraphicsQueue() },
+		m_ShadowAtlasResource{ 0 },
 		m_VertexBufferManager{ m_VkDevice.GetLogicalDevice(), m_VkDevice.GetPhysicalDevice(), m_VkCommandPool.Get(), m_VkDevice.GetGraphicsQueue() },
 		m_VkTextureSampler{ m_VkDevice.GetLogicalDevice(), m_VkDevice.GetPhysicalDevice() },
 		m_VkTextureManager{ m_VkDevice.GetLogicalDevice(), m_VkDevice.GetPhysicalDevice(), m_VkDevice.GetGraphicsQueue(), m_VkCommandPool.Get() },
 		m_VkDescriptorSetLayout{ m_VkDevice.GetLogicalDevice() },
-		m_VkDescriptorPool{ m_VkDevice.GetLogicalDevice(), static_cast<uint16>(m_VkSwapchain.GetImageViews().size()) },
-		m_VkGraphicsPipelineManager{ m_VkDevice.GetLogicalDevice(), m_VkRenderPass.Get(), m_VkDescriptorSetLayout.Get(), m_VkSwapchain.GetWidth(), m_VkSwapchain.GetHeight() },
+		m_VkDescriptorPool{ m_VkDevice.GetLogicalDevice(), _config.m_FramesInFlight },
+		m_VkGraphicsPipelineManager{ m_VkDevice.GetLogicalDevice(), m_VkSwapchain.GetFormat(), m_DepthFormat, m_ShadowAtlas.GetFormat(), m_VkDescriptorSetLayout.Get(), m_VkSwapchain.GetWidth(), m_VkSwapchain.GetHeight(),
+			_config.m_DepthPrepass },
+		m_JobSystem{ _jobSystem },
+		m_FrameAllocator{ m_VkDevice.GetLogicalDevice(), m_VkDevice.GetPhysicalDevice(), _config.m_FramesInFlight,
+			GetFrameCapacity(m_VkDevice.GetLimits(), _config), GetFrameAllocatorAlignment(m_VkDevice.GetLimits()) },
+		m_DepthPyramid{ nullptr },
+		m_DepthPyramidResource{ 0 },
+		m_DepthPyramidValid{ false },
+		m_CullingPass{ nullptr },
+		m_LightClusteringPass{ m_VkDevice.GetLogicalDevice(), m_FrameAllocator.GetBuffer() },
+		m_ShadowPass{ m_ShadowAtlas, m_FrameAllocator, m_VertexBufferManager, _config.m_MaxInstances },
+		m_FrameContexts{},
+		m_ImagesInFlight(m_VkSwapchain.GetImageViews().size(), VK_NULL_HANDLE),
 		m_Camera{ 45.0f, static_cast<float>(_window.GetWidth()) / _window.GetHeight(), 0.1f, 100.0f, _window.GetWindow() },
 		m_MeshSystem{},
-		m_LightSystem{},
+		m_MeshView{},
+		m_LightView{},
+		m_Frustum{},
 		m_CurrentFrameIndex{ 0 },
-		m_MaterialDynamicBufferMemAlignment{ 0 },
-		m_MaterialDynamicBufferMemBlock{ nullptr, [](Material* _ptr) noexcept { _aligned_free(_ptr); } }
+		m_MaxInstances{ _config.m_MaxInstances },
+		m_DroppedInstances{ 0 },
+		m_DepthPrepass{ _config.m_DepthPrepass },
+		m_MaterialStride{ 0 },
+		m_MaterialDynamicBufferMemBlock{ nullptr, [](Material* _ptr) noexcept { _aligned_free(_ptr); } },
+		m_MaterialSlotVersions(g_MaxMaterials, 0),
+		m_DynamicOffsets{},
+		m_DrawCommandsOffset{ 0 },
+		m_DrawCountsOffset{ 0 },
+		m_LateCullingOffsets{},
+		m_LateCullingConstants{},
+		m_CullObjectsDirty{ true },
+		m_CullingModelVersion{ 0 },
+		m_ChangedCullObjects{},
+		m_InstanceItems{},
+		m_UploadedBatches{},
+		m_ObjectUploads{},
+		m_BatchUploads{},
+		m_MaterialSlotsByEntity{},
+		m_MaterialSlotsByKey{},
+		m_MaterialSlotKeys(g_MaxMaterials),
+		m_MaterialSlotRefCounts(g_MaxMaterials, 0),
+		m_FreeMaterialSlots{},
+		m_NextMaterialSlot{ 0 },
+		m_MaterialSlotsExhausted{ false },
+		m_MaterialVersion{ 0 },
+		m_TextureVersion{ 0 },
+		m_AddedMeshEntities{},
+		m_RemovedMeshEntities{},
+		m_ChangedMeshEntities{},
+		m_DrawItems{},
+		m_SortedDrawItems{},
+		m_RenderQueue{},
+		m_Instances{},
+		m_Batches{},
+		m_BatchGroups{},
+		m_OpaqueGroupCount{ 0 },
+		m_CullingBounds{},
+		m_Visibility{},
+		m_CullingStats{},
+		m_CullingReadbacks(_config.m_FramesInFlight),
+		m_RecordedCommandBuffers{},
+		m_JobCommandStats{},
+		m_CommandStats{},
+		m_EventSubscriptions{}
 	{
-		FetchGraphicsComponents();
 		AllocateDynamicBufferSpace();
 		CreateDescriptorSetWriteBufferProperties();
 
-		const size_t numOfSwapImages{ m_VkSwapchain.GetImageViews().size() };
-		m_VPUniformBuffers.reserve(numOfSwapImages);
-		m_MaterialUniformBuffers.reserve(numOfSwapImages);
-		m_LightUniformBuffers.reserve(numOfSwapImages);
-		m_DescriptorSets.reserve(numOfSwapImages);
-
-		for (size_t i = 0; i < numOfSwapImages; ++i)
+		if (_config.m_FramesInFlight == 0)
 		{
-			m_VPUniformBuffers.emplace_back(m_VkDevice.GetLogicalDevice(), m_VkDevice.GetPhysicalDevice(), sizeof(ViewProjMatrix));
-			m_MaterialUniformBuffers.emplace_back(m_VkDevice.GetLogicalDevice(), m_VkDevice.GetPhysicalDevice(), m_MaterialDynamicBufferMemAlignment * g_MaxEntities);
-			m_LightUniformBuffers.emplace_back(m_VkDevice.GetLogicalDevice(), m_VkDevice.GetPhysicalDevice(), sizeof(LightData));
-			m_DescriptorSets.emplace_back(m_VkDevice.GetLogicalDevice(), m_VkDescriptorPool.Get(), m_VkDescriptorSetLayout.Get());
+			throw std::runtime_error("ERROR: At least one frame in flight is required");
 		}
 
-		for (const auto& meshComponent : m_MeshSystem.GetMeshComponents())
+		if (_config.m_GpuDrivenRendering)
 		{
-			meshComponent->SetDirty(true);
-
-			if (meshComponent->HasModel())
+			if (m_VkDevice.SupportsDrawIndirectCount())
 			{
-				m_VertexBufferManager.CreateModelVertexBuffer(meshComponent.get(), &m_MeshSystem);
+				// The culling pass samples the pyramid through its own descriptor set, so the pyramid comes first
+				if (_config.m_OcclusionCulling)
+				{
+					m_DepthPyramid = std::make_unique<VulkanDepthPyramid>(m_VkDevice.GetLogicalDevice(), m_VkDevice.GetPhysicalDevice(), m_VkCommandPool.Get(), m_VkDevice.GetGraphicsQueue(),
+						m_VkSwapchain.GetWidth(), m_VkSwapchain.GetHeight());
+				}
+
+				m_CullingPass = std::make_unique<VulkanCullingPass>(m_VkDevice.GetLogicalDevice(), m_VkDevice.GetPhysicalDevice(), m_FrameAllocator.GetBuffer(),
+					m_FrameAllocator.GetAlignment(), m_MaxInstances, m_DepthPyramid.get());
 			}
 			else
 			{
-				m_VertexBufferManager.CreateBasicShapeVertexBuffer(meshComponent.get(), &m_MeshSystem);
+				BE_LOG(LogCategory::Warning, "[RENDERER]: GPU-driven rendering requires drawIndirectCount, falling back to CPU submitted draws");
 			}
 		}
+		else if (_config.m_OcclusionCulling)
+		{
+			BE_LOG(LogCategory::Warning, "[RENDERER]: Occlusion culling requires GPU-driven rendering, rendering without it");
+		}
+
+		m_FrameContexts.reserve(_config.m_FramesInFlight);
+		for (uint32 i = 0; i < _config.m_FramesInFlight; ++i)
+		{
+			m_FrameContexts.push_back(std::make_unique<VulkanFrameContext>(m_VkDevice.GetLogicalDevice(), m_VkDevice.GetQueueIndices().m_GraphicsQueueFamilyIndex,
+				m_VkDescriptorPool.Get(), m_VkDescriptorSetLayout.Get(), m_JobSystem.GetWorkerCount() + 1));
+		}
+
+		// Meshes that exist before the renderer are uploaded immediately, everything spawned afterwards arrives through mesh events
+		const auto subscribeMeshEvent = [this](const ComponentEvent _event, std::vector<Entity>& _outEntities)
+			{
+				m_EventSubscriptions.push_back(ComponentEvents::Subscribe<MeshComponent>(_event, [&_outEntities](std::span<const Entity> _entities)
+					{
+						_outEntities.insert(_outEntities.end(), _entities.begin(), _entities.end());
+					}));
+			};
+
+		subscribeMeshEvent(ComponentEvent::Added, m_AddedMeshEntities);
+		subscribeMeshEvent(ComponentEvent::Removed, m_RemovedMeshEntities);
+		subscribeMeshEvent(ComponentEvent::Changed, m_ChangedMeshEntities);
+
+		std::vector<Entity> meshEntities{};
+		meshEntities.reserve(m_MeshView.GetEntityCount());
+		m_MeshView.ForEach([&meshEntities](const Entity _entity, MeshComponent&)
+			{
+				meshEntities.push_back(_entity);
+			});
+
+		for (const Entity entity : meshEntities)
+		{
+			RegisterMeshComponent(entity);
+		}
 
-		UpdateMaterialData();
 		m_VkTextureManager.UploadTextures();
 		StaticUpdateDescriptorSets();
-		BE_LOG(LogCategory::Trace, "[RENDERER]: Vulkan initialized");
+		BuildRenderGraph();
+		m_RenderGraph.SetImportedImage(m_ShadowAtlasResource, m_ShadowAtlas.GetImage(), m_ShadowAtlas.GetImageView());
+		if (m_DepthPyramid)
+		{
+			m_RenderGraph.SetImportedImage(m_DepthPyramidResource, m_DepthPyramid->GetImage(), m_DepthPyramid->GetImageView());
+		}
+		BE_LOG(LogCategory::Trace, "[RENDERER]: Vulkan initialized with %u frames in flight%s%s%s", _config.m_FramesInFlight, m_CullingPass ? " (GPU-driven)" : "",
+			m_DepthPrepass ? " (depth prepass)" : "", m_DepthPyramid ? " (occlusion culling)" : "");
 	}
 
 	VulkanRenderer::~VulkanRenderer()
 	{
 		vkDeviceWaitIdle(m_VkDevice.GetLogicalDevice());
-		BE_LOG(LogCategory::Trace, "[RENDERER]: Vulkan shutting down");
-	}
-
-	void VulkanRenderer::FetchGraphicsComponents()
-	{
-		std::vector<std::shared_ptr<MeshComponent>> meshComponents{};
-		std::vector<std::shared_ptr<LightComponent>> lightComponents{};
 
-		for (const auto& entity : EntityManager::GetAllEntities())
+		for (const uint32 subscription : m_EventSubscriptions)
 		{
-			if (const auto& meshComponent = entity->GetComponent<MeshComponent>())
-			{
-				meshComponents.push_back(meshComponent);
-			}
-
-			if (const auto& lightComponent = entity->GetComponent<LightComponent>())
-			{
-				lightComponents.push_back(lightComponent);
-			}
+			ComponentEvents::Unsubscribe(subscription);
 		}
 
-		// Sort mesh components based on shader type (optimization)
-		std::sort(meshComponents.begin(), meshComponents.end(), [](const std::shared_ptr<MeshComponent>& _a, const std::shared_ptr<MeshComponent>& _b) noexcept
-			{
-				return _a->GetShaderType() < _b->GetShaderType();
-			});
-
-		m_MeshSystem.SetMeshComponents(meshComponents);
-		m_LightSystem.SetLightComponents(lightComponents);
+		BE_LOG(LogCategory::Trace, "[RENDERER]: Vulkan shutting down");
 	}
 
 	void VulkanRenderer::AllocateDynamicBufferSpace() noexcept
 	{
-		const VkDeviceSize minUniformBufferOffset = m_VkDevice.GetLimits().minUniformBufferOffsetAlignment;
-		m_MaterialDynamicBufferMemAlignment = (sizeof(Material) + minUniformBufferOffset - 1) & ~(m_VkDevice.GetLimits().minUniformBufferOffsetAlignment - 1);
-		m_MaterialDynamicBufferMemBlock.reset(static_cast<Material*>(_aligned_malloc(m_MaterialDynamicBufferMemAlignment * g_MaxEntities, m_MaterialDynamicBufferMemAlignment)));
+		m_MaterialStride = GetMaterialStride();
+		m_MaterialDynamicBufferMemBlock.reset(static_cast<Material*>(_aligned_malloc(m_MaterialStride * g_MaxMaterials, alignof(Material))));
 	}
 
 	void VulkanRenderer::CreateDescriptorSetWriteBufferProperties()
 	{
-		constexpr uint32 descriptorWriteBufferCount{ 3 };
-		constexpr uint32 descriptorWriteTextureCount{ 2 };
+		constexpr uint32 descriptorWriteBufferCount{ 7 };
+		constexpr uint32 descriptorWriteTextureCount{ 4 };
 
 		m_DescriptorSetWriteBufferProperties.resize(descriptorWriteBufferCount);
 		m_DescriptorSetWriteTextureProperties.resize(descriptorWriteTextureCount);
 
-		m_DescriptorSetWriteBufferProperties[0].Initialize(0, VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER);
-		m_DescriptorSetWriteBufferProperties[1].Initialize(1, VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC);
-		m_DescriptorSetWriteBufferProperties[2].Initialize(4, VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER);
+		m_DescriptorSetWriteBufferProperties[0].Initialize(0, VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC);
+		m_DescriptorSetWriteBufferProperties[1].Initialize(1, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER_DYNAMIC);
+		m_DescriptorSetWriteBufferProperties[2].Initialize(4, VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC);
+		m_DescriptorSetWriteBufferProperties[3].Initialize(5, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER_DYNAMIC);
+		m_DescriptorSetWriteBufferProperties[4].Initialize(6, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER_DYNAMIC);
+		m_DescriptorSetWriteBufferProperties[5].Initialize(7, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER_DYNAMIC);
+		m_DescriptorSetWriteBufferProperties[6].Initialize(8, VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC);
 
 		m_DescriptorSetWriteTextureProperties[0].Initialize(2, VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE);
 		m_DescriptorSetWriteTextureProperties[1].Initialize(3, VK_DESCRIPTOR_TYPE_SAMPLER);
+		m_DescriptorSetWriteTextureProperties[2].Initialize(9, VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE);
+		m_DescriptorSetWriteTextureProperties[3].Initialize(10, VK_DESCRIPTOR_TYPE_SAMPLER);
 	}
 
-	void VulkanRenderer::UpdateMaterialData()
+	void VulkanRenderer::RegisterMeshComponent(const Entity _entity)
 	{
-		// Update dynamic buffer with material data
-		for (const auto& meshComponent : m_MeshSystem.GetMeshComponents())
+		MeshComponent* const meshComponent = _entity.GetComponent<MeshComponent>();
+		if (!meshComponent || m_MaterialSlotsByEntity.contains(_entity.GetUniqueId()))
+		{
+			return;
+		}
+
+		if (meshComponent->HasModel())
+		{
+			m_VertexBufferManager.CreateModelVertexBuffer(meshComponent);
+		}
+		else
+		{
+			m_VertexBufferManager.CreateBasicShapeVertexBuffer(meshComponent);
+		}
+
+		std::vector<uint32>& materialSlots = m_MaterialSlotsByEntity[_entity.GetUniqueId()];
+		for (auto& subMesh : meshComponent->GetSubMeshes())
+		{
+			const uint32 materialSlot = AcquireMaterialSlot(subMesh.material);
+			subMesh.SetMaterialIndex(materialSlot);
+			materialSlots.push_back(materialSlot);
+		}
+
+		m_MeshSystem.AddMeshEntity(_entity);
+	}
+
+	void VulkanRenderer::UnregisterMeshComponent(const Entity _entity)
+	{
+		auto materialSlots = m_MaterialSlotsByEntity.find(_entity.GetUniqueId());
+		if (materialSlots == m_MaterialSlotsByEntity.end())
+		{
+			return;
+		}
+
+		for (const uint32 materialSlot : materialSlots->second)
+		{
+			ReleaseMaterialSlot(materialSlot);
+		}
+
+		m_MaterialSlotsByEntity.erase(materialSlots);
+		m_MeshSystem.RemoveMeshEntity(_entity);
+	}
+
+	uint32 VulkanRenderer::AcquireMaterialSlot(const Material& _material)
+	{
+		const glm::vec4& diffuse = _material.GetDiffuseColor();
+		const glm::vec4& specular = _material.GetSpecularColor();
+		const MaterialKey key{ diffuse.r, diffuse.g, diffuse.b, diffuse.a, specular.r, specular.g, specular.b, specular.a, _material.GetShininess() };
+
+		// Sub-meshes with identical materials share a slot, which is what lets their draws be batched into one instanced draw
+		auto sharedSlot = m_MaterialSlotsByKey.find(key);
+		if (sharedSlot != m_MaterialSlotsByKey.end())
 		{
-			for (const auto& subMesh : meshComponent->GetSubMeshes())
+			++m_MaterialSlotRefCounts[sharedSlot->second];
+			return sharedSlot->second;
+		}
+
+		// Slots of released materials are reused before new ones are handed out
+		uint32 materialSlot{ 0 };
+		if (!m_FreeMaterialSlots.empty())
+		{
+			materialSlot = m_FreeMaterialSlots.back();
+			m_FreeMaterialSlots.pop_back();
+		}
+		else if (m_NextMaterialSlot < g_MaxMaterials)
+		{
+			materialSlot = m_NextMaterialSlot++;
+		}
+		else
+		{
+			// Out of slots. The sub-mesh borrows the first slot and is drawn with its material until one frees up and it changes
+			if (!m_MaterialSlotsExhausted)
 			{
-				const Material material = subMesh.material;
-				Material* materialData = (Material*)((uint64)m_MaterialDynamicBufferMemBlock.get() + (subMesh.GetMaterialIndex() * m_MaterialDynamicBufferMemAlignment));
-				const glm::vec3 diffuseColor = material.GetDiffuseColor();
-				const glm::vec3 specularColor = material.GetSpecularColor();
-				const float shininess = material.GetShininess();
-				*materialData = { diffuseColor, specularColor, shininess };
+				BE_LOG(LogCategory::Warning, "[RENDERER]: More than %llu distinct materials are in use, the extra ones are drawn with the first material", g_MaxMaterials);
+				m_MaterialSlotsExhausted = true;
 			}
+
+			++m_MaterialSlotRefCounts[0];
+			return 0;
 		}
 
-		for (size_t i = 0; i < m_DescriptorSets.size(); ++i)
+		m_MaterialSlotsByKey.emplace(key, materialSlot);
+		m_MaterialSlotKeys[materialSlot] = key;
+		m_MaterialSlotRefCounts[materialSlot] = 1;
+		WriteMaterialData(materialSlot, _material);
+		return materialSlot;
+	}
+
+	void VulkanRenderer::ReleaseMaterialSlot(const uint32 _slot) noexcept
+	{
+		if (--m_MaterialSlotRefCounts[_slot] == 0)
 		{
-			m_MaterialUniformBuffers[i].CopyData(m_MaterialDynamicBufferMemBlock.get());
+			m_MaterialSlotsByKey.erase(m_MaterialSlotKeys[_slot]);
+			m_FreeMaterialSlots.push_back(_slot);
+			m_MaterialSlotsExhausted = false;
 		}
 	}
 
-	void VulkanRenderer::UpdateLightData()
+	void VulkanRenderer::WriteMaterialData(const uint32 _slot, const Material& _material)
 	{
-		const auto& lightComponents = m_LightSystem.GetLightComponents();
-		for (const auto& lightComponent : lightComponents)
+		Material* materialData = (Material*)((uint64)m_MaterialDynamicBufferMemBlock.get() + (_slot * m_MaterialStride));
+		*materialData = { _material.GetDiffuseColor(), _material.GetSpecularColor(), _material.GetShininess() };
+		m_MaterialSlotVersions[_slot] = ++m_MaterialVersion;
+	}
+
+	void VulkanRenderer::ProcessComponentChanges(const VkCommandBuffer& _cmdBuffer)
+	{
+		// Removals are handled first so a mesh that was replaced during the frame is registered again with its new data
+		for (const Entity entity : m_RemovedMeshEntities)
+		{
+			UnregisterMeshComponent(entity);
+		}
+
+		if (!m_AddedMeshEntities.empty())
 		{
-			if (auto transformComponent = lightComponent->GetOwner()->GetTransform())
+			m_VertexBufferManager.BeginRecordedUploads(_cmdBuffer, m_CurrentFrameIndex);
+
+			for (const Entity entity : m_AddedMeshEntities)
 			{
-				// TODO: Enable support for multiple light sources
-				const glm::vec3 lightPos = glm::vec3(m_Camera.GetViewMatrix() * glm::vec4(transformComponent->GetPosition(), 1.0f));
-				LightData lightData(lightPos, lightComponent->GetColor());
-				m_LightUniformBuffers[m_CurrentFrameIndex].CopyData(&lightData);
+				if (entity.IsAlive())
+				{
+					RegisterMeshComponent(entity);
+				}
+			}
+
+			m_VertexBufferManager.EndRecordedUploads();
+
+			if (m_VkTextureManager.UploadTextures(_cmdBuffer, m_CurrentFrameIndex))
+			{
+				++m_TextureVersion;
 			}
 		}
+
+		// A changed material moves the sub-mesh to the slot matching its new contents instead of overwriting a slot others may share
+		for (const Entity entity : m_ChangedMeshEntities)
+		{
+			MeshComponent* const meshComponent = entity.GetComponent<MeshComponent>();
+			auto materialSlots = m_MaterialSlotsByEntity.find(entity.GetUniqueId());
+			if (!meshComponent || materialSlots == m_MaterialSlotsByEntity.end())
+			{
+				continue;
+			}
+
+			std::vector<uint32>& slots = materialSlots->second;
+			std::vector<Mesh>& subMeshes = meshComponent->GetSubMeshes();
+			for (size_t i = 0; i < subMeshes.size() && i < slots.size(); ++i)
+			{
+				const uint32 materialSlot = AcquireMaterialSlot(subMeshes[i].material);
+				ReleaseMaterialSlot(slots[i]);
+				subMeshes[i].SetMaterialIndex(materialSlot);
+				slots[i] = materialSlot;
+			}
+		}
+
+		// Any of these may add or remove shadow casters from cached shadow tiles. They also shift instance indices or change materials,
+		// so every culling object is uploaded again
+		for (const std::vector<Entity>* const entities : { &m_AddedMeshEntities, &m_RemovedMeshEntities, &m_ChangedMeshEntities })
+		{
+			for (const Entity entity : *entities)
+			{
+				m_ShadowPass.InvalidateCaster(entity.GetUniqueId());
+				m_CullObjectsDirty = true;
+			}
+		}
+
+		m_AddedMeshEntities.clear();
+		m_RemovedMeshEntities.clear();
+		m_ChangedMeshEntities.clear();
+	}
+
+	void VulkanRenderer::UpdateLightData(const VkCommandBuffer& _cmdBuffer)
+	{
+		constexpr uint32 gridX{ VulkanLightClusteringPass::s_GridSizeX };
+		constexpr uint32 gridY{ VulkanLightClusteringPass::s_GridSizeY };
+		constexpr uint32 gridZ{ VulkanLightClusteringPass::s_GridSizeZ };
+		constexpr uint32 maxLights{ VulkanLightClusteringPass::s_MaxLights };
+
+		// Whole ranges are reserved so the descriptors' fixed ranges stay inside the frame's region
+		const UniformAllocation lights = m_FrameAllocator.Allocate(sizeof(LightData) * maxLights);
+		const UniformAllocation lightLists = m_FrameAllocator.Allocate(sizeof(uint32) * VulkanLightClusteringPass::s_ClusterCount * VulkanLightClusteringPass::s_ClusterListStride);
+
+		// Lights are clustered and shaded in view space. Lights past the limit are ignored, directional lights reach every cluster and are
+		// shaded from the shadow uniform instead
+		LightData* const lightData = reinterpret_cast<LightData*>(lights.m_Data);
+		const glm::mat4& viewMatrix = m_Camera.GetViewMatrix();
+		uint32 lightCount{ 0 };
+		m_LightView.ForEach([this, &viewMatrix, lightData, &lightCount](const Entity _entity, LightComponent& _lightComponent)
+			{
+				const TransformComponent* const transformComponent = _entity.GetTransform();
+				if (!transformComponent || lightCount == maxLights || _lightComponent.GetType() == LightType::Directional)
+				{
+					return;
+				}
+
+				const glm::vec3 lightPos = glm::vec3(viewMatrix * glm::vec4(transformComponent->GetPosition(), 1.0f));
+				LightData& light = lightData[lightCount++];
+				light = LightData(lightPos, _lightComponent.GetColor(), _lightComponent.GetRange());
+
+				if (_lightComponent.GetType() == LightType::Spot)
+				{
+					const float cosInner = std::cos(glm::radians(_lightComponent.GetInnerConeAngle()));
+					const float cosOuter = std::cos(glm::radians(_lightComponent.GetOuterConeAngle()));
+					light.m_Direction = glm::mat3(viewMatrix) * _lightComponent.GetDirection();
+					light.m_SpotScale = 1.0f / std::max(cosInner - cosOuter, 1e-4f);
+					light.m_SpotOffset = -cosOuter * light.m_SpotScale;
+
+					light.m_ShadowTile = m_ShadowPass.GetLightTile(_entity.GetUniqueId());
+				}
+			});
+
+		const float width = static_cast<float>(m_VkSwapchain.GetWidth());
+		const float height = static_cast<float>(m_VkSwapchain.GetHeight());
+		const glm::vec2 tileSize{ std::ceil(width / gridX), std::ceil(height / gridY) };
+		const float nearPlane = m_Camera.GetNear();
+		const float farPlane = m_Camera.GetFar();
+		const float logDepthRatio = std::log(farPlane / nearPlane);
+
+		// Depth slice k starts at near * (far / near)^(k / gridZ), so a fragment's slice is log(depth) * scale + bias
+		ClusterData clusterData{};
+		clusterData.m_GridSize = glm::uvec4(gridX, gridY, gridZ, VulkanLightClusteringPass::s_ClusterListStride);
+		clusterData.m_Params = glm::vec4(tileSize, gridZ / logDepthRatio, -(gridZ * std::log(nearPlane)) / logDepthRatio);
+
+		m_DynamicOffsets[2] = m_FrameAllocator.Write(clusterData);
+		m_DynamicOffsets[4] = lights.m_Offset;
+		m_DynamicOffsets[5] = lightLists.m_Offset;
+
+		// Same flipped projection as the draws, so cluster tiles line up with gl_FragCoord
+		glm::mat4 projection = m_Camera.GetProjectionMatrix();
+		projection[1][1] *= -1.0f;
+
+		LightClusteringConstants constants{};
+		constants.m_InverseProjection = glm::inverse(projection);
+		constants.m_GridSize = glm::uvec4(gridX, gridY, gridZ, lightCount);
+		constants.m_ScreenParams = glm::vec4(tileSize, width, height);
+		constants.m_DepthRange = glm::vec2(nearPlane, farPlane);
+		m_LightClusteringPass.Record(_cmdBuffer, { lights.m_Offset, lightLists.m_Offset }, constants);
 	}
 
-	void VulkanRenderer::UpdateDescriptorSets(const uint8 _descriptorSetIndex)
+	void VulkanRenderer::UpdateFrameData(VulkanFrameContext& _frame)
 	{
-		m_DescriptorSetWriteBufferProperties[0].SetBuffer(m_VPUniformBuffers[_descriptorSetIndex].GetBuffer(), m_VPUniformBuffers[_descriptorSetIndex].GetBufferSize());
-		m_DescriptorSetWriteBufferProperties[1].SetBuffer(m_MaterialUniformBuffers[_descriptorSetIndex].GetBuffer(), m_MaterialDynamicBufferMemAlignment);
-		m_DescriptorSetWriteBufferProperties[2].SetBuffer(m_LightUniformBuffers[_descriptorSetIndex].GetBuffer(), m_LightUniformBuffers[_descriptorSetIndex].GetBufferSize());
-		m_DescriptorSets[_descriptorSetIndex].UpdateDescriptorSet(m_DescriptorSetWriteBufferProperties);
+		// The frame's fence has signaled, so its uniform region and descriptor set are no longer read by the GPU
+		m_FrameAllocator.BeginFrame(m_CurrentFrameIndex);
+
+		// Materials are allocated first so they land at the same offset of the region every time this frame index comes around.
+		// The region still holds what was written then, so only the slots that changed since are copied
+		const UniformAllocation materials = m_FrameAllocator.Allocate(m_MaterialStride * g_MaxMaterials);
+		if (_frame.GetMaterialVersion() != m_MaterialVersion)
+		{
+			const uint8* const materialBlock = reinterpret_cast<const uint8*>(m_MaterialDynamicBufferMemBlock.get());
+			for (uint32 slot = 0; slot < m_NextMaterialSlot; ++slot)
+			{
+				if (m_MaterialSlotVersions[slot] > _frame.GetMaterialVersion())
+				{
+					const uint64 offset = slot * m_MaterialStride;
+					std::memcpy(materials.m_Data + offset, materialBlock + offset, sizeof(Material));
+				}
+			}
+
+			_frame.SetMaterialVersion(m_MaterialVersion);
+		}
+
+		m_DynamicOffsets[1] = materials.m_Offset;
+
+		if (_frame.GetTextureVersion() != m_TextureVersion)
+		{
+			m_DescriptorSetWriteTextureProperties[0].SetImageView(m_VkTextureManager.GetTextureImageViews());
+			_frame.GetDescriptorSet().UpdateDescriptorSet(m_DescriptorSetWriteTextureProperties);
+			_frame.SetTextureVersion(m_TextureVersion);
+		}
 
-		// Update uniform buffer with the ViewProjMatrix
 		ViewProjMatrix viewProjMatrix = m_Camera.GetViewProjMatrix();
 		viewProjMatrix.m_Proj[1][1] *= -1.0f;
-		m_VPUniformBuffers[m_CurrentFrameIndex].CopyData(&viewProjMatrix);
-
-		UpdateLightData();
+		m_DynamicOffsets[0] = m_FrameAllocator.Write(viewProjMatrix);
+		m_Frustum = Frustum::FromViewProj(viewProjMatrix.m_Proj * viewProjMatrix.m_View);
 	}
 
 	void VulkanRenderer::StaticUpdateDescriptorSets() noexcept
 	{
 		m_DescriptorSetWriteTextureProperties[0].SetImageView(m_VkTextureManager.GetTextureImageViews());
 		m_DescriptorSetWriteTextureProperties[1].SetSampler(m_VkTextureSampler.Get());
+		m_DescriptorSetWriteTextureProperties[2].SetImageView({ m_ShadowAtlas.GetImageView() });
+		m_DescriptorSetWriteTextureProperties[3].SetSampler(m_ShadowAtlas.GetSampler());
+
+		// Every buffer binding points at the frame allocator's buffer and is positioned with a dynamic offset, so the buffer descriptors are only written once
+		m_DescriptorSetWriteBufferProperties[0].SetBuffer(m_FrameAllocator.GetBuffer(), sizeof(ViewProjMatrix));
+		m_DescriptorSetWriteBufferProperties[1].SetBuffer(m_FrameAllocator.GetBuffer(), m_MaterialStride * g_MaxMaterials);
+		m_DescriptorSetWriteBufferProperties[2].SetBuffer(m_FrameAllocator.GetBuffer(), sizeof(ClusterData));
+		m_DescriptorSetWriteBufferProperties[3].SetBuffer(m_FrameAllocator.GetBuffer(), sizeof(InstanceData) * m_MaxInstances);
+		m_DescriptorSetWriteBufferProperties[4].SetBuffer(m_FrameAllocator.GetBuffer(), sizeof(LightData) * VulkanLightClusteringPass::s_MaxLights);
+		m_DescriptorSetWriteBufferProperties[5].SetBuffer(m_FrameAllocator.GetBuffer(), sizeof(uint32) * VulkanLightClusteringPass::s_ClusterCount * VulkanLightClusteringPass::s_ClusterListStride);
+		m_DescriptorSetWriteBufferProperties[6].SetBuffer(m_FrameAllocator.GetBuffer(), sizeof(ShadowData));
 
-		for (size_t i = 0; i < m_DescriptorSets.size(); ++i)
+		for (const auto& frame : m_FrameContexts)
 		{
-			m_DescriptorSets[i].UpdateDescriptorSet(m_DescriptorSetWriteTextureProperties);
+			frame->GetDescriptorSet().UpdateDescriptorSet(m_DescriptorSetWriteBufferProperties);
+			frame->GetDescriptorSet().UpdateDescriptorSet(m_DescriptorSetWriteTextureProperties);
+			frame->SetTextureVersion(m_TextureVersion);
 		}
 	}
 
 	void VulkanRenderer::DrawFrame(const double _deltaTime)
 	{
+		VulkanFrameContext& frame = *m_FrameContexts[m_CurrentFrameIndex];
 		uint32 imgIndex{ 0 };
 
-		m_VkInFlightFences.Wait(m_CurrentFrameIndex);
-		m_VkInFlightFences.Reset(m_CurrentFrameIndex);
+		// Everything this context recorded the last time it was used has completed once its fence signals
+		frame.Wait();
+		m_VertexBufferManager.ReleaseStagingBuffers(m_CurrentFrameIndex);
+		m_VkTextureManager.ReleaseStagingBuffers(m_CurrentFrameIndex);
+		ReadCullingStats(m_CurrentFrameIndex);
 
 		vkAcquireNextImageKHR
 		(
 			m_VkDevice.GetLogicalDevice(),
 			m_VkSwapchain.Get(),
 			UINT64_MAX,
-			m_VkSemaphores.Get()[m_CurrentFrameIndex].first,
+			frame.GetImageAvailableSemaphore(),
 			VK_NULL_HANDLE,
 			&imgIndex
 		);
 
-		// Update the camera's position and rotation
-		m_Camera.ProcessInput(_deltaTime);
+		// With more frames in flight than swapchain images, another frame may still be rendering into the acquired image
+		if (m_ImagesInFlight[imgIndex] != VK_NULL_HANDLE && m_ImagesInFlight[imgIndex] != frame.GetFence())
+		{
+			vkWaitForFences(m_VkDevice.GetLogicalDevice(), 1, &m_ImagesInFlight[imgIndex], VK_TRUE, UINT64_MAX);
+		}
 
-		// Get the semaphores to use for this frame
-		VkSemaphore waitSemaphore = m_VkSemaphores.Get()[m_CurrentFrameIndex].first;
-		VkSemaphore signalSemaphore = m_VkSemaphores.Get()[m_CurrentFrameIndex].second;
+		m_ImagesInFlight[imgIndex] = frame.GetFence();
+		frame.Reset();
 
-		// Get the command buffer for this image index
-		VkCommandBuffer cmdBuffer = m_VkCommandBuffers.Get()[imgIndex];
+		// Update the camera's position and rotation
+		m_Camera.ProcessInput(_deltaTime);
 
-		// Reset the command buffer and record render commands
-		vkResetCommandBuffer(cmdBuffer, 0);
-		RecordRenderCommands(imgIndex);
+		RecordRenderCommands(frame, imgIndex);
 
 		// Submit the command buffer and signal the next semaphore
-		m_VkCommandBuffers.Submit
+		VkSemaphore signalSemaphore = frame.GetRenderFinishedSemaphore();
+		frame.GetCommandBuffers().Submit
 		(
-			imgIndex,
+			0,
 			m_VkDevice.GetGraphicsQueue(),
-			waitSemaphore,
+			frame.GetImageAvailableSemaphore(),
 			signalSemaphore,
-			m_VkInFlightFences.Get()[m_CurrentFrameIndex],
+			frame.GetFence(),
 			VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT
 		);
 
@@ -251,33 +666,391 @@ namespace Banshee
 		presentInfo.pResults = nullptr;
 
 		vkQueuePresentKHR(m_VkDevice.GetPresentationQueue(), &presentInfo);
-		m_CurrentFrameIndex = (m_CurrentFrameIndex + 1) % m_VkSwapchain.GetImageViews().size();
+		m_CurrentFrameIndex = static_cast<uint8>((m_CurrentFrameIndex + 1) % m_FrameContexts.size());
+	}
+
+	void VulkanRenderer::GatherDrawItems()
+	{
+		m_DrawItems.clear();
+		m_Instances.clear();
+		m_Batches.clear();
+		m_BatchGroups.clear();
+		m_OpaqueGroupCount = 0;
+		m_CullingBounds.Clear();
+		m_ShadowPass.ClearCasters();
+		m_ChangedCullObjects.clear();
+
+		const glm::mat4& viewMatrix = m_Camera.GetViewMatrix();
+		const float projectionScale = std::abs(m_Camera.GetProjectionMatrix()[1][1]);
+		uint32 droppedInstances{ 0 };
+
+		for (const Entity entity : m_MeshSystem.GetMeshEntities())
+		{
+			MeshComponent* const meshComponent = entity.GetComponent<MeshComponent>();
+			if (!meshComponent)
+			{
+				continue;
+			}
+
+			glm::mat4 entityModelMatrix = glm::mat4(1.0f);
+			bool moved{ false };
+			if (const TransformComponent* const transform = entity.GetTransform())
+			{
+				entityModelMatrix = transform->GetModel();
+				if (transform->GetModelVersion() > m_ShadowPass.GetModelVersion())
+				{
+					m_ShadowPass.InvalidateCaster(entity.GetUniqueId());
+				}
+
+				moved = transform->GetModelVersion() > m_CullingModelVersion;
+			}
+
+			std::vector<Mesh>& subMeshes = meshComponent->GetSubMeshes();
+			for (uint32 subMeshIndex = 0; subMeshIndex < subMeshes.size(); ++subMeshIndex)
+			{
+				// The per-frame instance memory is sized for MaxInstances, anything past it is left out of the frame
+				if (m_Instances.size() == m_MaxInstances)
+				{
+					++droppedInstances;
+					continue;
+				}
+
+				Mesh& subMesh = subMeshes[subMeshIndex];
+				const glm::mat4 modelMatrix = entityModelMatrix * subMesh.localTransform;
+				if (!m_CullingPass)
+				{
+					m_CullingBounds.Add(modelMatrix, subMesh.boundingSphere, subMesh.boundingBox);
+				}
+
+				// Sorting depth is the view-space distance to the sub-mesh's bounding sphere center
+				const bool translucent = subMesh.material.GetDiffuseColor().a < 1.0f;
+				const float depth = -(viewMatrix * modelMatrix * glm::vec4(subMesh.boundingSphere.m_Center, 1.0f)).z;
+
+				// Screen size is the projected diameter of the world-space bounding sphere over the viewport height
+				const float worldRadius = subMesh.boundingSphere.m_Radius *
+					std::max({ glm::length(glm::vec3(modelMatrix[0])), glm::length(glm::vec3(modelMatrix[1])), glm::length(glm::vec3(modelMatrix[2])) });
+				const float screenSize = depth > worldRadius ? worldRadius * projectionScale / depth : std::numeric_limits<float>::max();
+				const uint32 lod = SelectLod(subMesh, screenSize);
+				const bool lodChanged = lod != subMesh.GetSelectedLod();
+				if (lodChanged)
+				{
+					// The cached shadow maps the sub-mesh is in were drawn with its old LOD
+					subMesh.SetSelectedLod(lod);
+					m_ShadowPass.InvalidateCaster(entity.GetUniqueId());
+				}
+
+				// Each LOD sorts as its own sub-mesh so instances drawing the same LOD still end up in one batch
+				const MeshLod meshLod = subMesh.GetLod(lod);
+				const uint32 sortSubMesh = subMeshIndex * g_MaxMeshLods + lod;
+				const uint64 sortKey = translucent ?
+					RenderQueue::MakeTranslucentKey(meshComponent->GetShaderType(), meshComponent->GetMeshId(), sortSubMesh, depth) :
+					RenderQueue::MakeOpaqueKey(meshComponent->GetShaderType(), meshComponent->GetMeshId(), sortSubMesh, depth);
+
+				m_DrawItems.push_back({ sortKey, meshComponent->GetShaderType(), meshComponent->GetMeshId(), meshLod.indexOffset, meshLod.indexCount,
+					static_cast<uint32>(m_Instances.size()), 0, glm::vec4(subMesh.boundingSphere.m_Center, subMesh.boundingSphere.m_Radius) });
+				m_Instances.emplace_back(modelMatrix, subMesh.GetTexId(), subMesh.HasTexture(), subMesh.GetMaterialIndex());
+
+				if (m_CullingPass && (moved || lodChanged || translucent))
+				{
+					m_ChangedCullObjects.push_back(static_cast<uint32>(m_Instances.size() - 1));
+				}
+
+				if (!translucent)
+				{
+					m_ShadowPass.AddCaster({ entity.GetUniqueId(), meshComponent->GetMeshId(), meshLod.indexOffset, meshLod.indexCount,
+						static_cast<uint32>(m_Instances.size() - 1) }, modelMatrix, subMesh.boundingSphere, subMesh.boundingBox);
+				}
+			}
+		}
+
+		if (droppedInstances != m_DroppedInstances)
+		{
+			if (droppedInstances > 0)
+			{
+				BE_LOG(LogCategory::Warning, "[RENDERER]: %u sub-meshes exceed MaxInstances (%u) and are not drawn, raise MaxInstances in config.ini", droppedInstances, m_MaxInstances);
+			}
+
+			m_DroppedInstances = droppedInstances;
+		}
+
+		// Items are still in instance order here, so an item's instance index is also its index into the culling bounds
+		if (!m_CullingPass)
+		{
+			m_Visibility.resize(m_CullingBounds.Size());
+			const uint32 visible = FrustumCuller::Cull(m_Frustum, m_CullingBounds, m_Visibility.data());
+			m_CullingStats = { visible, static_cast<uint32>(m_DrawItems.size()) - visible };
+			std::erase_if(m_DrawItems, [this](const DrawItem& _drawItem) noexcept { return m_Visibility[_drawItem.m_Instance] == 0; });
+		}
+
+		m_RenderQueue.Clear();
+		for (uint32 item = 0; item < m_DrawItems.size(); ++item)
+		{
+			m_RenderQueue.Push(m_DrawItems[item].m_SortKey, item);
+		}
+
+		m_RenderQueue.Sort();
+
+		m_SortedDrawItems.clear();
+		for (const RenderQueue::Entry& entry : m_RenderQueue.GetEntries())
+		{
+			m_SortedDrawItems.push_back(m_DrawItems[entry.m_Item]);
+		}
+
+		m_DrawItems.swap(m_SortedDrawItems);
+
+		if (m_CullingPass)
+		{
+			m_InstanceItems.resize(m_Instances.size());
+		}
+
+		// Each batch owns the instance range of its items, so both the CPU and the culling shader can write a batch's instances without overlap.
+		// Translucent items sort after every opaque one and start their own groups, as they aren't part of the depth prepass
+		for (uint32 item = 0; item < m_DrawItems.size(); ++item)
+		{
+			DrawItem& drawItem = m_DrawItems[item];
+			if (m_CullingPass)
+			{
+				m_InstanceItems[drawItem.m_Instance] = item;
+			}
+
+			const bool translucent = RenderQueue::IsTranslucentKey(drawItem.m_SortKey);
+			const bool newGroup = m_BatchGroups.empty() || m_BatchGroups.back().m_ShaderType != drawItem.m_ShaderType || m_BatchGroups.back().m_MeshId != drawItem.m_MeshId ||
+				(translucent && m_OpaqueGroupCount == m_BatchGroups.size());
+			if (newGroup)
+			{
+				const VulkanGraphicsPipeline* const pipeline = translucent ? m_VkGraphicsPipelineManager.GetPipeline(drawItem.m_ShaderType).get() :
+					m_VkGraphicsPipelineManager.GetOpaquePipeline(drawItem.m_ShaderType).get();
+				m_BatchGroups.push_back({ drawItem.m_ShaderType, drawItem.m_MeshId, static_cast<uint32>(m_Batches.size()), 0, pipeline, m_VertexBufferManager.GetVertexBuffer(drawItem.m_MeshId) });
+				m_OpaqueGroupCount += translucent ? 0 : 1;
+			}
+
+			if (newGroup || m_Batches.back().m_FirstIndex != drawItem.m_IndexOffset)
+			{
+				BatchGroup& group = m_BatchGroups.back();
+				m_Batches.push_back({ drawItem.m_IndexCount, 0, drawItem.m_IndexOffset, 0, item, static_cast<uint32>(m_BatchGroups.size() - 1), group.m_FirstBatch, 0 });
+				++group.m_BatchCount;
+			}
+
+			++m_Batches.back().m_InstanceCount;
+			drawItem.m_Batch = static_cast<uint32>(m_Batches.size() - 1);
+		}
+	}
+
+	void VulkanRenderer::WriteInstanceData()
+	{
+		// The whole instance range is reserved so the descriptor's fixed range stays inside the frame's region.
+		// Instances are written in draw order, so each batch reads a contiguous run starting at its firstInstance
+		const UniformAllocation instances = m_FrameAllocator.Allocate(sizeof(InstanceData) * m_MaxInstances);
+		InstanceData* const instanceData = reinterpret_cast<InstanceData*>(instances.m_Data);
+		for (size_t i = 0; i < m_DrawItems.size(); ++i)
+		{
+			instanceData[i] = m_Instances[m_DrawItems[i].m_Instance];
+		}
+
+		m_DynamicOffsets[3] = instances.m_Offset;
+	}
+
+	void VulkanRenderer::RecordGpuCulling(const VkCommandBuffer& _cmdBuffer)
+	{
+		const uint32 objectCount = static_cast<uint32>(m_DrawItems.size());
+		const uint32 batchCount = static_cast<uint32>(m_Batches.size());
+
+		// Translucent groups follow the opaque ones, so their batches do as well
+		const uint32 firstTranslucentBatch = m_OpaqueGroupCount < m_BatchGroups.size() ? m_BatchGroups[m_OpaqueGroupCount].m_FirstBatch : batchCount;
+
+		m_ObjectUploads.clear();
+		m_BatchUploads.clear();
+
+		// Batches are few and uploaded whole. Objects reference them by index, so opaque objects only keep their batch while the opaque batches are unchanged
+		const bool batchesChanged = m_Batches != m_UploadedBatches;
+		const bool opaqueBatchesChanged = batchesChanged && (firstTranslucentBatch > m_UploadedBatches.size() ||
+			!std::equal(m_Batches.begin(), m_Batches.begin() + firstTranslucentBatch, m_UploadedBatches.begin()));
+		if (batchesChanged)
+		{
+			// Instance counts start at zero and are incremented by the culling shader for every visible instance
+			if (batchCount > 0)
+			{
+				const UniformAllocation batches = m_FrameAllocator.Allocate(sizeof(DrawBatch) * batchCount);
+				DrawBatch* const batchData = reinterpret_cast<DrawBatch*>(batches.m_Data);
+				for (uint32 i = 0; i < batchCount; ++i)
+				{
+					batchData[i] = m_Batches[i];
+					batchData[i].m_InstanceCount = 0;
+				}
+
+				m_BatchUploads.push_back({ batches.m_Offset, 0, batchCount });
+			}
+
+			m_UploadedBatches = m_Batches;
+		}
+
+		if (m_CullObjectsDirty || opaqueBatchesChanged)
+		{
+			if (objectCount > 0)
+			{
+				const UniformAllocation objects = m_FrameAllocator.Allocate(sizeof(CullObject) * objectCount);
+				CullObject* const objectData = reinterpret_cast<CullObject*>(objects.m_Data);
+				for (const DrawItem& drawItem : m_DrawItems)
+				{
+					objectData[drawItem.m_Instance] = { m_Instances[drawItem.m_Instance], drawItem.m_BoundingSphere, drawItem.m_Batch, {} };
+				}
+
+				m_ObjectUploads.push_back({ objects.m_Offset, 0, objectCount });
+			}
+		}
+		else if (!m_ChangedCullObjects.empty())
+		{
+			const UniformAllocation objects = m_FrameAllocator.Allocate(sizeof(CullObject) * m_ChangedCullObjects.size());
+			CullObject* const objectData = reinterpret_cast<CullObject*>(objects.m_Data);
+			for (uint32 i = 0; i < m_ChangedCullObjects.size(); ++i)
+			{
+				const uint32 instance = m_ChangedCullObjects[i];
+				const DrawItem& drawItem = m_DrawItems[m_InstanceItems[instance]];
+				objectData[i] = { m_Instances[instance], drawItem.m_BoundingSphere, drawItem.m_Batch, {} };
+
+				// Runs of consecutive instances are copied with one region
+				if (!m_ObjectUploads.empty() && m_ObjectUploads.back().m_First + m_ObjectUploads.back().m_Count == instance)
+				{
+					++m_ObjectUploads.back().m_Count;
+				}
+				else
+				{
+					m_ObjectUploads.push_back({ objects.m_Offset + i * static_cast<uint32>(sizeof(CullObject)), instance, 1 });
+				}
+			}
+		}
+
+		m_CullObjectsDirty = false;
+		m_CullingModelVersion = TransformComponent::GetLatestModelVersion();
+		m_CullingPass->RecordUploads(_cmdBuffer, m_ObjectUploads, m_BatchUploads);
+
+		// The culling shader fills the instance allocation, which is what the vertex shaders read through binding 5
+		const UniformAllocation instances = m_FrameAllocator.Allocate(sizeof(InstanceData) * m_MaxInstances);
+		const UniformAllocation commands = m_FrameAllocator.Allocate(sizeof(DrawBatch) * m_MaxInstances);
+		const UniformAllocation counts = m_FrameAllocator.Allocate(sizeof(uint32) * m_MaxInstances);
+		std::memset(counts.m_Data, 0, sizeof(uint32) * m_BatchGroups.size());
+
+		m_DynamicOffsets[3] = instances.m_Offset;
+		m_DrawCommandsOffset = commands.m_Offset;
+		m_DrawCountsOffset = counts.m_Offset;
+
+		CullingReadback& readback = m_CullingReadbacks[m_CurrentFrameIndex];
+		readback.m_Commands = { reinterpret_cast<const DrawBatch*>(commands.m_Data), nullptr };
+		readback.m_Counts = { reinterpret_cast<const uint32*>(counts.m_Data), nullptr };
+		readback.m_GroupFirstBatches.clear();
+		for (const BatchGroup& batchGroup : m_BatchGroups)
+		{
+			readback.m_GroupFirstBatches.push_back(batchGroup.m_FirstBatch);
+		}
+
+		readback.m_ObjectCount = objectCount;
+
+		CullingConstants constants{};
+		constants.m_FrustumPlanes = m_Frustum.m_Planes;
+		constants.m_ObjectCount = objectCount;
+		constants.m_BatchCount = batchCount;
+
+		if (!m_DepthPyramid)
+		{
+			m_CullingPass->Record(_cmdBuffer, { instances.m_Offset, commands.m_Offset, counts.m_Offset, 0, 0 }, constants);
+			return;
+		}
+
+		// Spheres are projected with the unflipped projection, the shader flips the y of the screen rectangle itself
+		const glm::mat4& projection = m_Camera.GetProjectionMatrix();
+		OcclusionData occlusionData{};
+		occlusionData.m_View = m_Camera.GetViewMatrix();
+		occlusionData.m_Projection = glm::vec4(projection[0][0], projection[1][1], projection[2][2], projection[3][2]);
+		occlusionData.m_PyramidParams = glm::vec4(static_cast<float>(m_DepthPyramid->GetWidth()), static_cast<float>(m_DepthPyramid->GetHeight()),
+			static_cast<float>(m_DepthPyramid->GetMipCount()), m_Camera.GetNear());
+		const uint32 occlusionDataOffset = m_FrameAllocator.Write(occlusionData);
+		const UniformAllocation visibility = m_FrameAllocator.Allocate(sizeof(uint32) * m_MaxInstances);
+
+		// The second phase fills its own batches in the scene buffer, so the draws of the first phase stay intact while it runs
+		const UniformAllocation lateInstances = m_FrameAllocator.Allocate(sizeof(InstanceData) * m_MaxInstances);
+		const UniformAllocation lateCommands = m_FrameAllocator.Allocate(sizeof(DrawBatch) * m_MaxInstances);
+		const UniformAllocation lateCounts = m_FrameAllocator.Allocate(sizeof(uint32) * m_MaxInstances);
+		std::memset(lateCounts.m_Data, 0, sizeof(uint32) * m_BatchGroups.size());
+		readback.m_Commands[1] = reinterpret_cast<const DrawBatch*>(lateCommands.m_Data);
+		readback.m_Counts[1] = reinterpret_cast<const uint32*>(lateCounts.m_Data);
+
+		constants.m_FirstTranslucentBatch = firstTranslucentBatch;
+		constants.m_Phase = 0;
+		constants.m_OcclusionTest = m_DepthPyramidValid ? 1 : 0;
+		m_CullingPass->Record(_cmdBuffer, { instances.m_Offset, commands.m_Offset, counts.m_Offset, occlusionDataOffset, visibility.m_Offset }, constants);
+
+		m_LateCullingOffsets = { lateInstances.m_Offset, lateCommands.m_Offset, lateCounts.m_Offset, occlusionDataOffset, visibility.m_Offset };
+		m_LateCullingConstants = constants;
+		m_LateCullingConstants.m_Phase = 1;
+		m_LateCullingConstants.m_OcclusionTest = 1;
+	}
+
+	void VulkanRenderer::RecordLateCulling(const VkCommandBuffer& _cmdBuffer) const noexcept
+	{
+		m_CullingPass->Record(_cmdBuffer, m_LateCullingOffsets, m_LateCullingConstants);
+	}
+
+	void VulkanRenderer::ReadCullingStats(const uint8 _frameIndex) noexcept
+	{
+		CullingReadback& readback = m_CullingReadbacks[_frameIndex];
+		if (!readback.m_Commands[0])
+		{
+			return;
+		}
+
+		// Every visible object is one instance of its batch's draw command, so the drawn instances are the visible objects
+		uint32 visible{ 0 };
+		for (uint32 phase = 0; phase < readback.m_Commands.size() && readback.m_Commands[phase]; ++phase)
+		{
+			for (uint32 group = 0; group < readback.m_GroupFirstBatches.size(); ++group)
+			{
+				const DrawBatch* const commands = readback.m_Commands[phase] + readback.m_GroupFirstBatches[group];
+				for (uint32 draw = 0; draw < readback.m_Counts[phase][group]; ++draw)
+				{
+					visible += commands[draw].m_InstanceCount;
+				}
+			}
+		}
+
+		m_CullingStats = { visible, readback.m_ObjectCount - visible };
+		readback.m_Commands = {};
 	}
 
-	void VulkanRenderer::RecordRenderCommands(const uint8 _imgIndex)
+	void VulkanRenderer::RecordInstancedDraws(VulkanCommandEncoder& _encoder, const uint32 _firstGroup, const uint32 _endGroup, const VulkanGraphicsPipeline* _pipeline) const noexcept
 	{
-		const VkCommandBuffer cmdBuffer = m_VkCommandBuffers.Get()[_imgIndex];
-		m_VkCommandBuffers.Begin(_imgIndex);
+		for (uint32 group = _firstGroup; group < _endGroup; ++group)
+		{
+			const BatchGroup& batchGroup = m_BatchGroups[group];
+			_encoder.BindPipeline(_pipeline ? _pipeline->Get() : batchGroup.m_Pipeline->Get());
 
-		VkRenderPassBeginInfo renderPassInfo{};
-		renderPassInfo.sType = VK_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO;
-		renderPassInfo.renderPass = m_VkRenderPass.Get();
-		renderPassInfo.framebuffer = m_VkFramebuffers.Get()[_imgIndex];
-		renderPassInfo.renderArea.offset = { 0, 0 };
-		renderPassInfo.renderArea.extent = VkExtent2D({ m_VkSwapchain.GetWidth(), m_VkSwapchain.GetHeight() });
+			// Bind vertex & index buffers. Sub-meshes are selected with each batch's first index
+			batchGroup.m_VertexBuffer->Bind(_encoder, 0);
 
-		// Clear attachments
-		const VkClearColorValue clearColor{ 0.1f, 0.1f, 0.1f, 1.0f };
-		const VkClearDepthStencilValue clearDepthStencil{ 1.0f, 0 };
+			for (uint32 batch = batchGroup.m_FirstBatch; batch < batchGroup.m_FirstBatch + batchGroup.m_BatchCount; ++batch)
+			{
+				const DrawBatch& drawBatch = m_Batches[batch];
+				_encoder.DrawIndexed(drawBatch.m_IndexCount, drawBatch.m_InstanceCount, drawBatch.m_FirstIndex, drawBatch.m_VertexOffset, drawBatch.m_FirstInstance);
+			}
+		}
+	}
 
-		std::array<VkClearValue, 2> clearAttachments{};
-		clearAttachments[0].color = clearColor;
-		clearAttachments[1].depthStencil = clearDepthStencil;
-		renderPassInfo.clearValueCount = static_cast<uint32>(clearAttachments.size());
-		renderPassInfo.pClearValues = clearAttachments.data();
+	void VulkanRenderer::RecordIndirectDraws(VulkanCommandEncoder& _encoder, const uint32 _firstGroup, const uint32 _endGroup, const VulkanGraphicsPipeline* _pipeline) const noexcept
+	{
+		const VkBuffer buffer = m_FrameAllocator.GetBuffer();
 
-		vkCmdBeginRenderPass(cmdBuffer, &renderPassInfo, VK_SUBPASS_CONTENTS_INLINE);
+		// One indirect count draw per group. The culling pass wrote the group's visible batches to the start of its command range
+		for (uint32 group = _firstGroup; group < _endGroup; ++group)
+		{
+			const BatchGroup& batchGroup = m_BatchGroups[group];
+			_encoder.BindPipeline(_pipeline ? _pipeline->Get() : batchGroup.m_Pipeline->Get());
+			batchGroup.m_VertexBuffer->Bind(_encoder, 0);
+			_encoder.DrawIndexedIndirectCount(buffer, m_DrawCommandsOffset + static_cast<uint64>(batchGroup.m_FirstBatch) * sizeof(DrawBatch),
+				buffer, m_DrawCountsOffset + static_cast<uint64>(group) * sizeof(uint32), batchGroup.m_BatchCount, sizeof(DrawBatch));
+		}
+	}
 
+	void VulkanRenderer::SetViewportAndScissor(const VkCommandBuffer& _cmdBuffer) const noexcept
+	{
 		VkViewport viewport{};
 		viewport.x = 0.0f;
 		viewport.y = 0.0f;
@@ -285,50 +1058,282 @@ namespace Banshee
 		viewport.height = static_cast<float>(m_VkSwapchain.GetHeight());
 		viewport.minDepth = 0.0f;
 		viewport.maxDepth = 1.0f;
-		vkCmdSetViewport(cmdBuffer, 0, 1, &viewport);
+		vkCmdSetViewport(_cmdBuffer, 0, 1, &viewport);
 
 		VkRect2D scissor{};
 		scissor.offset = { 0, 0 };
 		scissor.extent = VkExtent2D({ m_VkSwapchain.GetWidth(), m_VkSwapchain.GetHeight() });
-		vkCmdSetScissor(cmdBuffer, 0, 1, &scissor);
+		vkCmdSetScissor(_cmdBuffer, 0, 1, &scissor);
+	}
 
-		UpdateDescriptorSets(_imgIndex);
+	void VulkanRenderer::RecordShadowPass(const VkCommandBuffer& _cmdBuffer)
+	{
+		VulkanCommandEncoder encoder{ _cmdBuffer };
+		m_ShadowPass.Record(encoder, *m_VkGraphicsPipelineManager.GetShadowPipeline(), m_FrameContexts[m_CurrentFrameIndex]->GetDescriptorSet().Get(), m_DynamicOffsets);
+		m_CommandStats += encoder.GetStats();
+	}
 
-		const std::vector<std::shared_ptr<MeshComponent>>& meshComponents = m_MeshSystem.GetMeshComponents();
-		for (size_t i = 0; i < meshComponents.size(); ++i)
+	void VulkanRenderer::RecordDepthPrepass(const VkCommandBuffer& _cmdBuffer)
+	{
+		if (m_OpaqueGroupCount == 0)
 		{
-			glm::mat4 entityModelMatrix = glm::mat4(1.0f);
-			if (auto transform = meshComponents[i]->GetOwner()->GetTransform())
+			return;
+		}
+
+		// The depth-only pipeline shares the descriptor set layout, so the frame's set binds as is
+		const VulkanGraphicsPipeline* const pipeline = m_VkGraphicsPipelineManager.GetDepthOnlyPipeline().get();
+		VulkanCommandEncoder encoder{ _cmdBuffer };
+		SetViewportAndScissor(_cmdBuffer);
+		encoder.BindDescriptorSet(pipeline->GetLayout(), 0, m_FrameContexts[m_CurrentFrameIndex]->GetDescriptorSet().Get(), m_DynamicOffsets);
+
+		if (m_CullingPass)
+		{
+			RecordIndirectDraws(encoder, 0, m_OpaqueGroupCount, pipeline);
+		}
+		else
+		{
+			RecordInstancedDraws(encoder, 0, m_OpaqueGroupCount, pipeline);
+		}
+
+		m_CommandStats += encoder.GetStats();
+	}
+
+	void VulkanRenderer::RecordDrawCommands(VulkanFrameContext& _frame)
+	{
+		// With occlusion culling the translucent groups are only drawn by the second phase
+		const uint32 groupCount = m_DepthPyramid ? m_OpaqueGroupCount : static_cast<uint32>(m_BatchGroups.size());
+		if (groupCount == 0)
+		{
+			return;
+		}
+
+		const uint32 jobCount = std::min(_frame.GetRecordingSlotCount(), (groupCount + g_MinGroupsPerRecordingJob - 1) / g_MinGroupsPerRecordingJob);
+		const uint32 groupsPerJob = (groupCount + jobCount - 1) / jobCount;
+		const uint32 colorFormat = m_VkSwapchain.GetFormat();
+		const VkDescriptorSet descriptorSet = _frame.GetDescriptorSet().Get();
+		m_JobCommandStats.assign(jobCount, {});
+
+		// Every job records into the secondary buffer of its own slot, whose pool no other thread touches this frame.
+		// Secondary buffers inherit none of the primary buffer's state, so each one sets viewport, scissor and descriptor set itself
+		const auto recordJob = [&](const uint32 _job)
 			{
-				entityModelMatrix = transform->GetModel();
-			}
+				const uint32 firstGroup = _job * groupsPerJob;
+				const uint32 endGroup = std::min(groupCount, firstGroup + groupsPerJob);
+				VulkanCommandEncoder encoder{ _frame.GetSecondaryCommandBuffer(_job) };
+
+				_frame.GetSecondaryCommandBuffers(_job).BeginSecondary(0, colorFormat, m_DepthFormat);
+				SetViewportAndScissor(encoder.Get());
+
+				// Both pipelines share the descriptor set layout, so the set is bound once per job.
+				// Dynamic offsets are consumed in binding order (view-projection, materials, light, instances)
+				encoder.BindDescriptorSet(m_BatchGroups[firstGroup].m_Pipeline->GetLayout(), 0, descriptorSet, m_DynamicOffsets);
+
+				if (m_CullingPass)
+				{
+					RecordIndirectDraws(encoder, firstGroup, endGroup);
+				}
+				else
+				{
+					RecordInstancedDraws(encoder, firstGroup, endGroup);
+				}
+
+				_frame.GetSecondaryCommandBuffers(_job).End();
+				m_JobCommandStats[_job] = encoder.GetStats();
+			};
+
+		if (jobCount == 1)
+		{
+			recordJob(0);
+		}
+		else
+		{
+			m_JobSystem.ParallelFor(jobCount, 1, [&recordJob](const uint32 _begin, const uint32 _end)
+				{
+					for (uint32 job = _begin; job < _end; ++job)
+					{
+						recordJob(job);
+					}
+				});
+		}
 
-			const VulkanVertexBuffer* const vertexBuffer = m_VertexBufferManager.GetVertexBuffer(meshComponents[i]->GetMeshId());
+		m_RecordedCommandBuffers.clear();
+		for (uint32 job = 0; job < jobCount; ++job)
+		{
+			m_RecordedCommandBuffers.push_back(_frame.GetSecondaryCommandBuffer(job));
+			m_CommandStats += m_JobCommandStats[job];
+		}
+
+		vkCmdExecuteCommands(_frame.GetCommandBuffer(), static_cast<uint32>(m_RecordedCommandBuffers.size()), m_RecordedCommandBuffers.data());
+	}
+
+	void VulkanRenderer::RecordLateDrawCommands(const VkCommandBuffer& _cmdBuffer)
+	{
+		if (m_BatchGroups.empty())
+		{
+			return;
+		}
+
+		const VkBuffer buffer = m_FrameAllocator.GetBuffer();
+		VulkanCommandEncoder encoder{ _cmdBuffer };
+		SetViewportAndScissor(_cmdBuffer);
 
-			const auto& graphicsPipeline = m_VkGraphicsPipelineManager.GetPipeline(meshComponents[i]->GetShaderType());
-			vkCmdBindPipeline(cmdBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, graphicsPipeline->Get());
+		// The vertex shaders read the second phase's instances in place of the first's
+		std::array<uint32, 7> dynamicOffsets = m_DynamicOffsets;
+		dynamicOffsets[3] = m_LateCullingOffsets[0];
+		encoder.BindDescriptorSet(m_BatchGroups[0].m_Pipeline->GetLayout(), 0, m_FrameContexts[m_CurrentFrameIndex]->GetDescriptorSet().Get(), dynamicOffsets);
+
+		// Opaque objects drawn here weren't part of a depth prepass, so every group uses the pipeline that tests LESS and writes depth
+		for (uint32 group = 0; group < m_BatchGroups.size(); ++group)
+		{
+			const BatchGroup& batchGroup = m_BatchGroups[group];
+			encoder.BindPipeline(m_VkGraphicsPipelineManager.GetPipeline(batchGroup.m_ShaderType)->Get());
+			batchGroup.m_VertexBuffer->Bind(encoder, 0);
+			encoder.DrawIndexedIndirectCount(buffer, m_LateCullingOffsets[1] + static_cast<uint64>(batchGroup.m_FirstBatch) * sizeof(DrawBatch),
+				buffer, m_LateCullingOffsets[2] + static_cast<uint64>(group) * sizeof(uint32), batchGroup.m_BatchCount, sizeof(DrawBatch));
+		}
 
-			for (const auto& subMesh : meshComponents[i]->GetSubMeshes())
+		m_CommandStats += encoder.GetStats();
+	}
+
+	void VulkanRenderer::BuildRenderGraph()
+	{
+		const uint32 w = m_VkSwapchain.GetWidth();
+		const uint32 h = m_VkSwapchain.GetHeight();
+
+		m_BackbufferResource = m_RenderGraph.ImportImage("Backbuffer", { w, h, m_VkSwapchain.GetFormat(), VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT }, RenderGraphAccess::Present);
+		// Occlusion culling reduces the depth of the first culling phase into the depth pyramid, which is kept for the next frame's first phase
+		const RenderGraphResource depth = m_RenderGraph.CreateImage("Depth", { w, h, m_DepthFormat,
+			VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT | (m_DepthPyramid ? static_cast<uint32>(VK_IMAGE_USAGE_SAMPLED_BIT) : 0u) });
+		if (m_DepthPyramid)
+		{
+			m_DepthPyramidResource = m_RenderGraph.ImportImage("Depth Pyramid", { m_DepthPyramid->GetWidth(), m_DepthPyramid->GetHeight(), m_DepthPyramid->GetFormat(),
+				VK_IMAGE_USAGE_STORAGE_BIT | VK_IMAGE_USAGE_SAMPLED_BIT }, RenderGraphAccess::ShaderRead, true);
+		}
+
+		// The atlas keeps its contents across frames. Tiles are cleared individually before they're redrawn
+		constexpr uint32 atlasSize{ VulkanShadowAtlas::s_AtlasSize };
+		m_ShadowAtlasResource = m_RenderGraph.ImportImage("Shadow Atlas", { atlasSize, atlasSize, m_ShadowAtlas.GetFormat(),
+			VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT | VK_IMAGE_USAGE_SAMPLED_BIT }, RenderGraphAccess::ShaderRead, true);
+
+		m_RenderGraph.AddPass("Shadows",
+			[this](RenderGraphBuilder& _builder)
+			{
+				_builder.WriteDepth(m_ShadowAtlasResource);
+			},
+			[this](const VkCommandBuffer& _cmdBuffer)
 			{
-				// Bind vertex & index buffers
-				const VkDeviceSize indexOffset = subMesh.indexOffset * sizeof(uint32);
-				vertexBuffer->Bind(cmdBuffer, indexOffset);
+				RecordShadowPass(_cmdBuffer);
+			},
+			[this]()
+			{
+				return m_ShadowPass.HasTilesToRedraw();
+			});
 
-				// Bind descriptor set
-				const uint32 dynamicOffset = static_cast<uint32>(m_MaterialDynamicBufferMemAlignment) * subMesh.GetMaterialIndex();
-				auto currentDescriptorSet = m_DescriptorSets[_imgIndex].Get();
-				vkCmdBindDescriptorSets(cmdBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, graphicsPipeline->GetLayout(), 0, 1, &currentDescriptorSet, 1, &dynamicOffset);
+		if (m_DepthPrepass)
+		{
+			m_RenderGraph.AddPass("Depth Prepass",
+				[depth](RenderGraphBuilder& _builder)
+				{
+					_builder.WriteDepth(depth, 1.0f);
+				},
+				[this](const VkCommandBuffer& _cmdBuffer)
+				{
+					RecordDepthPrepass(_cmdBuffer);
+				});
+		}
 
-				// Push constants
-				const glm::mat4& modelMatrix = entityModelMatrix * subMesh.localTransform;
-				const PushConstant pc(modelMatrix, subMesh.GetTexId(), subMesh.HasTexture());
-				vkCmdPushConstants(cmdBuffer, graphicsPipeline->GetLayout(), VK_SHADER_STAGE_VERTEX_BIT, 0, sizeof(PushConstant), &pc);
+		// After a prepass the forward pass keeps its depth, opaque pipelines test EQUAL against it while translucent ones still test and write
+		m_RenderGraph.AddPass("Forward",
+			[this, depth](RenderGraphBuilder& _builder)
+			{
+				_builder.WriteColor(m_BackbufferResource, glm::vec4(0.1f, 0.1f, 0.1f, 1.0f));
+				_builder.ReadTexture(m_ShadowAtlasResource);
+				if (m_DepthPrepass)
+				{
+					_builder.WriteDepth(depth);
+				}
+				else
+				{
+					_builder.WriteDepth(depth, 1.0f);
+				}
+				_builder.UseSecondaryCommandBuffers();
+			},
+			[this](const VkCommandBuffer&)
+			{
+				RecordDrawCommands(*m_FrameContexts[m_CurrentFrameIndex]);
+			});
 
-				vkCmdDrawIndexed(cmdBuffer, static_cast<uint32>(subMesh.indices.size()), 1, 0, 0, 0);
-			}
+		// The second culling phase tests what the first didn't draw against the depth drawn so far and draws it on top
+		if (m_DepthPyramid)
+		{
+			m_RenderGraph.AddPass("Depth Pyramid",
+				[this, depth](RenderGraphBuilder& _builder)
+				{
+					_builder.ReadTexture(depth);
+					_builder.WriteStorage(m_DepthPyramidResource);
+				},
+				[this](const VkCommandBuffer& _cmdBuffer)
+				{
+					m_DepthPyramid->Record(_cmdBuffer);
+				});
+
+			m_RenderGraph.AddPass("Late Culling",
+				[this](RenderGraphBuilder& _builder)
+				{
+					_builder.ReadTexture(m_DepthPyramidResource);
+					_builder.SetSideEffects();
+				},
+				[this](const VkCommandBuffer& _cmdBuffer)
+				{
+					RecordLateCulling(_cmdBuffer);
+				});
+
+			m_RenderGraph.AddPass("Late Forward",
+				[this, depth](RenderGraphBuilder& _builder)
+				{
+					_builder.WriteColor(m_BackbufferResource);
+					_builder.ReadTexture(m_ShadowAtlasResource);
+					_builder.WriteDepth(depth);
+				},
+				[this](const VkCommandBuffer& _cmdBuffer)
+				{
+					RecordLateDrawCommands(_cmdBuffer);
+				});
+		}
+
+		m_RenderGraph.Compile();
+
+		if (m_DepthPyramid)
+		{
+			m_DepthPyramid->SetDepthSource(m_RenderGraph.GetImageView(depth));
+		}
+	}
+
+	void VulkanRenderer::RecordRenderCommands(VulkanFrameContext& _frame, const uint32 _imgIndex)
+	{
+		const VkCommandBuffer cmdBuffer = _frame.GetCommandBuffer();
+		_frame.GetCommandBuffers().Begin();
+		ProcessComponentChanges(cmdBuffer);
+
+		UpdateFrameData(_frame);
+		GatherDrawItems();
+		m_DynamicOffsets[6] = m_ShadowPass.Update(m_Camera, m_Frustum, m_Instances);
+		UpdateLightData(cmdBuffer);
+		m_CommandStats = {};
+
+		// Culling runs in compute and has to be recorded before the render graph begins rendering
+		if (m_CullingPass)
+		{
+			RecordGpuCulling(cmdBuffer);
+		}
+		else
+		{
+			WriteInstanceData();
 		}
 
-		vkCmdEndRenderPass(cmdBuffer);
-		m_VkCommandBuffers.End(_imgIndex);
+		m_RenderGraph.SetImportedImage(m_BackbufferResource, m_VkSwapchain.GetImages()[_imgIndex], m_VkSwapchain.GetImageViews()[_imgIndex]);
+		m_RenderGraph.Execute(cmdBuffer);
+		m_DepthPyramidValid = m_DepthPyramid != nullptr;
+		_frame.GetCommandBuffers().End();
 	}
 } // End of Banshee namespace
\ No newline at end of file
@@ -4,41 +4,61 @@
 #include "VulkanSurface.h"
 #include "VulkanDevice.h"
 #include "VulkanSwapchain.h"
-#include "VulkanDepthBuffer.h"
-#include "VulkanRenderPass.h"
 #include "VulkanDescriptorSetLayout.h"
 #include "VulkanDescriptorPool.h"
 #include "VulkanDescriptorSet.h"
 #include "VulkanGraphicsPipeline.h"
 #include "VulkanGraphicsPipelineManager.h"
 #include "VulkanCommandPool.h"
-#include "VulkanCommandBuffer.h"
-#include "VulkanFramebuffer.h"
-#include "VulkanSemaphore.h"
-#include "VulkanFence.h"
-#include "VulkanUniformBuffer.h"
+#include "VulkanFrameContext.h"
+#include "VulkanFrameAllocator.h"
 #include "VulkanDescriptorSetProperties.h"
 #include "VulkanTextureManager.h"
 #include "VulkanTextureSampler.h"
 #include "VulkanVertexBufferManager.h"
+#include "VulkanCullingPass.h"
+#include "VulkanDepthPyramid.h"
+#include "VulkanLightClusteringPass.h"
+#include "VulkanShadowAtlas.h"
+#include "VulkanShadowPass.h"
+#include "VulkanCommandEncoder.h"
+#include "VulkanRenderGraph.h"
 #include "Graphics/Systems/MeshSystem.h"
-#include "Graphics/Systems/LightSystem.h"
 #include "Graphics/Camera.h"
+#include "Graphics/Components/MeshComponent.h"
+#include "Graphics/Components/Light/LightComponent.h"
+#include "Graphics/MVP.h"
+#include "Graphics/Bounds.h"
+#include "Graphics/FrustumCuller.h"
+#include "Graphics/RenderQueue.h"
+#include "Foundation/Entity/View.h"
 #include <vector>
+#include <array>
+#include <map>
 #include <memory>
+#include <unordered_map>
 
 namespace Banshee
 {
 	class Window;
 	class Material;
+	class JobSystem;
+	struct EngineConfig;
 
 	class VulkanRenderer
 	{
 	public:
-		explicit VulkanRenderer(const Window& _window);
+		// Frames in flight, the instance budget and whether culling and draw submission run on the GPU are read from _config.
+		// Draw commands are recorded in parallel on _jobSystem's workers
+		VulkanRenderer(const Window& _window, const EngineConfig& _config, JobSystem& _jobSystem);
 		~VulkanRenderer();
 
 		void DrawFrame(const double _deltaTime);
+		// Sub-meshes kept and rejected by culling. CPU culling reports the last frame. With GPU-driven rendering the counts are read back from the
+		// device once a frame's fence has signaled, so they trail the last frame by the number of frames in flight
+		const CullingStats& GetCullingStats() const noexcept { return m_CullingStats; }
+		// Binds and draws recorded in the last frame's shadow pass, depth prepass and draw pass, summed over every recording job
+		const CommandEncoderStats& GetCommandStats() const noexcept { return m_CommandStats; }
 
 		VulkanRenderer(const VulkanRenderer&) = delete;
 		VulkanRenderer& operator=(const VulkanRenderer&) = delete;
@@ -46,43 +66,183 @@ namespace Banshee
 		VulkanRenderer& operator=(VulkanRenderer&&) = delete;
 
 	private:
-		void FetchGraphicsComponents();
+		// Material contents (diffuse, specular, shininess). Sub-meshes with identical materials share one material slot
+		using MaterialKey = std::array<float, 9>;
+
+		// One sub-mesh to draw this frame. Consecutive items with the same shader, mesh and sub-mesh form one batch, drawn as one instanced draw.
+		// Materials are indexed per instance, so they don't split batches
+		struct DrawItem
+		{
+			uint64 m_SortKey;
+			ShaderType m_ShaderType;
+			uint32 m_MeshId;
+			uint32 m_IndexOffset;
+			uint32 m_IndexCount;
+			uint32 m_Instance;   // Index into m_Instances
+			uint32 m_Batch;      // Index into m_Batches, assigned once the items are sorted
+			glm::vec4 m_BoundingSphere;
+		};
+
+		// Consecutive batches sharing a pipeline and vertex buffer. Both are resolved while gathering, so recording jobs don't touch the managers
+		struct BatchGroup
+		{
+			ShaderType m_ShaderType;
+			uint32 m_MeshId;
+			uint32 m_FirstBatch;
+			uint32 m_BatchCount;
+			const VulkanGraphicsPipeline* m_Pipeline;
+			const VulkanVertexBuffer* m_VertexBuffer;
+		};
+
+		// Where a frame's GPU culling left its draw commands and per-group draw counts, the second entries belong to the late occlusion culling phase.
+		// Read once the frame's fence has signaled to count the instances the device drew
+		struct CullingReadback
+		{
+			std::array<const DrawBatch*, 2> m_Commands;
+			std::array<const uint32*, 2> m_Counts;
+			std::vector<uint32> m_GroupFirstBatches;
+			uint32 m_ObjectCount;
+		};
+
+	private:
 		void AllocateDynamicBufferSpace() noexcept;
 		void CreateDescriptorSetWriteBufferProperties();
-		void UpdateMaterialData();
-		void UpdateLightData();
-		void UpdateDescriptorSets(const uint8 _descriptorSetIndex);
+		void RegisterMeshComponent(const Entity _entity);
+		void UnregisterMeshComponent(const Entity _entity);
+		uint32 AcquireMaterialSlot(const Material& _material);
+		void ReleaseMaterialSlot(const uint32 _slot) noexcept;
+		void WriteMaterialData(const uint32 _slot, const Material& _material);
+		// Applies the mesh events delivered since the last frame. Vertex uploads for new meshes are recorded into _cmdBuffer
+		void ProcessComponentChanges(const VkCommandBuffer& _cmdBuffer);
+		// Uploads every point and spot light in view space and records the compute pass that bins them into clusters
+		void UpdateLightData(const VkCommandBuffer& _cmdBuffer);
+		void UpdateFrameData(VulkanFrameContext& _frame);
 		void StaticUpdateDescriptorSets() noexcept;
-		void RecordRenderCommands(const uint8 _imgIndex);
+		// Collects every registered sub-mesh at the LOD matching its screen size, drops those outside the camera frustum, orders the rest through the render queue
+		// and builds the batches and their groups
+		void GatherDrawItems();
+		void WriteInstanceData();
+		// Uploads the culling objects and batches that changed since the last frame and records the compute pass that culls the objects and writes the indirect draws
+		void RecordGpuCulling(const VkCommandBuffer& _cmdBuffer);
+		// Second occlusion culling phase, run once the depth pyramid was rebuilt from the first phase's depth
+		void RecordLateCulling(const VkCommandBuffer& _cmdBuffer) const noexcept;
+		void ReadCullingStats(const uint8 _frameIndex) noexcept;
+		// Both record the draws of groups [_firstGroup, _endGroup) and may run on any thread. A non-null _pipeline replaces every group's own
+		void RecordInstancedDraws(VulkanCommandEncoder& _encoder, const uint32 _firstGroup, const uint32 _endGroup, const VulkanGraphicsPipeline* _pipeline = nullptr) const noexcept;
+		void RecordIndirectDraws(VulkanCommandEncoder& _encoder, const uint32 _firstGroup, const uint32 _endGroup, const VulkanGraphicsPipeline* _pipeline = nullptr) const noexcept;
+		void SetViewportAndScissor(const VkCommandBuffer& _cmdBuffer) const noexcept;
+		// Records the shadow pass's redrawn tiles with the frame's descriptor set, only runs on frames with a tile to redraw
+		void RecordShadowPass(const VkCommandBuffer& _cmdBuffer);
+		// Draws the opaque groups with the depth-only pipeline, directly into the primary buffer
+		void RecordDepthPrepass(const VkCommandBuffer& _cmdBuffer);
+		// Splits the batch groups into chunks recorded in parallel into the frame's secondary buffers and executes them from the primary buffer
+		void RecordDrawCommands(VulkanFrameContext& _frame);
+		// Draws what the second culling phase found visible, translucent groups included, directly into the primary buffer
+		void RecordLateDrawCommands(const VkCommandBuffer& _cmdBuffer);
+		// Declares the frame's passes and attachments. The backbuffer is imported and bound to the acquired swapchain image every frame
+		void BuildRenderGraph();
+		void RecordRenderCommands(VulkanFrameContext& _frame, const uint32 _imgIndex);
 
 	private:
 		VulkanInstance m_VkInstance;
 		VulkanSurface m_VkSurface;
 		VulkanDevice m_VkDevice;
 		VulkanSwapchain m_VkSwapchain;
-		VulkanDepthBuffer m_DepthBuffer;
-		VulkanRenderPass m_VkRenderPass;
+		uint32 m_DepthFormat;
+		// Used for one-off uploads outside of a frame. Each frame context records into its own pool
 		VulkanCommandPool m_VkCommandPool;
-		VulkanCommandBuffer m_VkCommandBuffers;
-		VulkanFramebuffer m_VkFramebuffers;
-		VulkanSemaphore m_VkSemaphores;
-		VulkanFence m_VkInFlightFences;
+		VulkanRenderGraph m_RenderGraph;
+		RenderGraphResource m_BackbufferResource;
+		VulkanShadowAtlas m_ShadowAtlas;
+		RenderGraphResource m_ShadowAtlasResource;
 		VulkanVertexBufferManager m_VertexBufferManager;
 		VulkanTextureSampler m_VkTextureSampler;
 		VulkanTextureManager m_VkTextureManager;
 		VulkanDescriptorSetLayout m_VkDescriptorSetLayout;
 		VulkanDescriptorPool m_VkDescriptorPool;
 		VulkanGraphicsPipelineManager m_VkGraphicsPipelineManager;
-		std::vector<VulkanUniformBuffer> m_VPUniformBuffers;
-		std::vector<VulkanUniformBuffer> m_MaterialUniformBuffers;
-		std::vector<VulkanUniformBuffer> m_LightUniformBuffers;
-		std::vector<VulkanDescriptorSet> m_DescriptorSets;
+		JobSystem& m_JobSystem;
+		// View-projection, material, light and instance data of every frame in flight are sub-allocated from one persistently mapped buffer
+		VulkanFrameAllocator m_FrameAllocator;
+		// Only created with occlusion culling, which also needs the culling pass
+		std::unique_ptr<VulkanDepthPyramid> m_DepthPyramid;
+		RenderGraphResource m_DepthPyramidResource;
+		// False until a frame built the pyramid, the first culling phase skips the occlusion test until then
+		bool m_DepthPyramidValid;
+		// Only created when GPU-driven rendering is enabled and the device supports vkCmdDrawIndexedIndirectCount
+		std::unique_ptr<VulkanCullingPass> m_CullingPass;
+		VulkanLightClusteringPass m_LightClusteringPass;
+		VulkanShadowPass m_ShadowPass;
+		std::vector<std::unique_ptr<VulkanFrameContext>> m_FrameContexts;
+		// Fence of the frame that last rendered into each swapchain image, for when more frames are in flight than there are images
+		std::vector<VkFence> m_ImagesInFlight;
 		Camera m_Camera;
 		MeshSystem m_MeshSystem;
-		LightSystem m_LightSystem;
+		View<MeshComponent> m_MeshView;
+		View<LightComponent> m_LightView;
+		Frustum m_Frustum;
 		uint8 m_CurrentFrameIndex;
-		uint64 m_MaterialDynamicBufferMemAlignment;
+		uint32 m_MaxInstances;
+		// Sub-meshes left out of the last frame for lack of instance space, so the warning is only logged when this changes
+		uint32 m_DroppedInstances;
+		bool m_DepthPrepass;
+		uint64 m_MaterialStride;
 		std::unique_ptr<Material, void(*)(Material*) noexcept> m_MaterialDynamicBufferMemBlock;
+		// Material version each slot was last written at, so a frame only copies the slots that changed since it last ran
+		std::vector<uint64> m_MaterialSlotVersions;
+		// Dynamic offsets of the current frame's view-projection, material, cluster, instance, light, cluster light list and shadow allocations, in binding order
+		std::array<uint32, 7> m_DynamicOffsets;
+		// Offsets of the current frame's indirect draw commands and per-group draw counts when rendering GPU-driven
+		uint32 m_DrawCommandsOffset;
+		uint32 m_DrawCountsOffset;
+		// Allocations and constants of the second occlusion culling phase, whose instances, draw commands and counts are separate from the first's
+		std::array<uint32, 5> m_LateCullingOffsets;
+		CullingConstants m_LateCullingConstants;
+		// Each instance's culling object stays in the culling pass's scene buffer at the instance's index. Mesh events and changed opaque batches upload
+		// every object again, otherwise only those that moved or switched LOD are uploaded, along with the translucent ones whose batches follow the depth order
+		bool m_CullObjectsDirty;
+		// Latest transform model version the uploaded culling objects have seen
+		uint32 m_CullingModelVersion;
+		// Instances whose culling object changed this frame, in ascending order
+		std::vector<uint32> m_ChangedCullObjects;
+		// Draw item of each instance, for building the changed culling objects
+		std::vector<uint32> m_InstanceItems;
+		// Batches as last uploaded, with their full instance counts
+		std::vector<DrawBatch> m_UploadedBatches;
+		std::vector<CullingUpload> m_ObjectUploads;
+		std::vector<CullingUpload> m_BatchUploads;
+		std::unordered_map<uint32, std::vector<uint32>> m_MaterialSlotsByEntity;
+		std::map<MaterialKey, uint32> m_MaterialSlotsByKey;
+		std::vector<MaterialKey> m_MaterialSlotKeys;
+		std::vector<uint32> m_MaterialSlotRefCounts;
+		std::vector<uint32> m_FreeMaterialSlots;
+		uint32 m_NextMaterialSlot;
+		// Set once every slot is taken so the fallback is only logged once, cleared when a slot is released
+		bool m_MaterialSlotsExhausted;
+		// Versions let each frame's uniform region and descriptor set catch up on their own the next time that frame is recorded
+		uint64 m_MaterialVersion;
+		uint64 m_TextureVersion;
+		std::vector<Entity> m_AddedMeshEntities;
+		std::vector<Entity> m_RemovedMeshEntities;
+		std::vector<Entity> m_ChangedMeshEntities;
+		// Per-frame scratch, kept as members so their capacity is reused
+		std::vector<DrawItem> m_DrawItems;
+		std::vector<DrawItem> m_SortedDrawItems;
+		RenderQueue m_RenderQueue;
+		std::vector<InstanceData> m_Instances;
+		std::vector<DrawBatch> m_Batches;
+		std::vector<BatchGroup> m_BatchGroups;
+		// Opaque groups come first in m_BatchGroups, translucent ones never share a group with them
+		uint32 m_OpaqueGroupCount;
+		CullingBoundsSoA m_CullingBounds;
+		std::vector<uint8> m_Visibility;
+		CullingStats m_CullingStats;
+		// One per frame in flight
+		std::vector<CullingReadback> m_CullingReadbacks;
+		std::vector<VkCommandBuffer> m_RecordedCommandBuffers;
+		std::vector<CommandEncoderStats> m_JobCommandStats;
+		CommandEncoderStats m_CommandStats;
+		std::vector<uint32> m_EventSubscriptions;
 		std::vector<DescriptorSetWriteBufferProperties> m_DescriptorSetWriteBufferProperties;
 		std::vector<DescriptorSetWriteTextureProperties> m_DescriptorSetWriteTextureProperties;
 	};
@@ -0,0 +1,81 @@
+#include "VulkanShadowAtlas.h"
+#include "VulkanUtils.h"
+#include "Foundation/Logging/Logger.h"
+#include <vulkan/vulkan.h>
+#include <stdexcept>
+
+namespace Banshee
+{
+	VulkanShadowAtlas::VulkanShadowAtlas(const VkDevice& _logicalDevice, const VkPhysicalDevice& _gpu, const VkCommandPool& _commandPool, const VkQueue& _queue) :
+		m_LogicalDevice{ _logicalDevice },
+		m_Format{ 0 },
+		m_Image{ VK_NULL_HANDLE },
+		m_ImageMemory{ VK_NULL_HANDLE },
+		m_ImageView{ VK_NULL_HANDLE },
+		m_Sampler{ VK_NULL_HANDLE }
+	{
+		BE_LOG(LogCategory::Trace, "[SHADOW ATLAS]: Creating %ux%u shadow atlas", s_AtlasSize, s_AtlasSize);
+
+		// Depth comparisons are filtered, so the format has to support linear filtering as well as being rendered to
+		const VkFormat format = VulkanUtils::FindSupportedFormat
+		(
+			_gpu,
+			{ VK_FORMAT_D32_SFLOAT, VK_FORMAT_D16_UNORM },
+			VK_IMAGE_TILING_OPTIMAL,
+			VK_FORMAT_FEATURE_DEPTH_STENCIL_ATTACHMENT_BIT | VK_FORMAT_FEATURE_SAMPLED_IMAGE_BIT | VK_FORMAT_FEATURE_SAMPLED_IMAGE_FILTER_LINEAR_BIT
+		);
+		m_Format = static_cast<uint32>(format);
+
+		VulkanUtils::CreateImage
+		(
+			_logicalDevice,
+			_gpu,
+			s_AtlasSize,
+			s_AtlasSize,
+			format,
+			VK_IMAGE_TILING_OPTIMAL,
+			static_cast<VkImageUsageFlagBits>(VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT | VK_IMAGE_USAGE_SAMPLED_BIT),
+			VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
+			m_Image,
+			m_ImageMemory
+		);
+
+		VulkanUtils::CreateImageView(_logicalDevice, m_Image, m_Format, VK_IMAGE_ASPECT_DEPTH_BIT, m_ImageView);
+
+		// The render graph expects the atlas in its final layout at the start of every frame, including the first
+		VulkanUtils::TransitionImageLayout(_logicalDevice, _commandPool, _queue, m_Image, format, VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
+
+		// Fragments outside of a tile are never sampled, the shader clamps its filter taps to the tile's rectangle
+		VkSamplerCreateInfo samplerCreateInfo{};
+		samplerCreateInfo.sType = VK_STRUCTURE_TYPE_SAMPLER_CREATE_INFO;
+		samplerCreateInfo.magFilter = VK_FILTER_LINEAR;
+		samplerCreateInfo.minFilter = VK_FILTER_LINEAR;
+		samplerCreateInfo.addressModeU = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE;
+		samplerCreateInfo.addressModeV = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE;
+		samplerCreateInfo.addressModeW = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE;
+		samplerCreateInfo.unnormalizedCoordinates = VK_FALSE;
+		samplerCreateInfo.compareEnable = VK_TRUE;
+		samplerCreateInfo.compareOp = VK_COMPARE_OP_LESS_OR_EQUAL;
+		samplerCreateInfo.mipmapMode = VK_SAMPLER_MIPMAP_MODE_NEAREST;
+		samplerCreateInfo.mipLodBias = 0.0f;
+		samplerCreateInfo.minLod = 0.0f;
+		samplerCreateInfo.maxLod = 0.0f;
+		samplerCreateInfo.anisotropyEnable = VK_FALSE;
+		samplerCreateInfo.maxAnisotropy = 1.0f;
+
+		if (vkCreateSampler(_logicalDevice, &samplerCreateInfo, nullptr, &m_Sampler) != VK_SUCCESS)
+		{
+			throw std::runtime_error("ERROR: Failed to create shadow atlas sampler");
+		}
+
+		BE_LOG(LogCategory::Info, "[SHADOW ATLAS]: Created shadow atlas with %u tiles", s_TileCount);
+	}
+
+	VulkanShadowAtlas::~VulkanShadowAtlas()
+	{
+		vkDestroySampler(m_LogicalDevice, m_Sampler, nullptr);
+		vkDestroyImageView(m_LogicalDevice, m_ImageView, nullptr);
+		vkDestroyImage(m_LogicalDevice, m_Image, nullptr);
+		vkFreeMemory(m_LogicalDevice, m_ImageMemory, nullptr);
+	}
+} // End of Banshee namespace
\ No newline at end of file
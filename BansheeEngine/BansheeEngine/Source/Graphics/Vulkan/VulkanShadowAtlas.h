@@ -0,0 +1,68 @@
+#pragma once
+
+#include "Foundation/Platform.h"
+#include <glm/glm.hpp>
+#include <array>
+
+typedef struct VkDevice_T* VkDevice;
+typedef struct VkPhysicalDevice_T* VkPhysicalDevice;
+typedef struct VkCommandPool_T* VkCommandPool;
+typedef struct VkQueue_T* VkQueue;
+typedef struct VkImage_T* VkImage;
+typedef struct VkImageView_T* VkImageView;
+typedef struct VkDeviceMemory_T* VkDeviceMemory;
+typedef struct VkSampler_T* VkSampler;
+
+namespace Banshee
+{
+	constexpr uint32 g_ShadowAtlasTileCount{ 16 };
+
+	// Mirrors the shadow uniform of standard.frag. Tile matrices take view-space positions straight to atlas texture coordinates and depth.
+	// The directional light's cascades always occupy the first tiles
+	struct ShadowData
+	{
+		std::array<glm::mat4, g_ShadowAtlasTileCount> m_TileMatrices;
+		glm::vec4 m_CascadeSplits;           // View-space distance at which each cascade ends
+		glm::vec4 m_DirectionalDirection;    // View-space direction the directional light travels, cascade count in w (0 without shadows)
+		glm::vec4 m_DirectionalColor;        // 1 in w when the scene has a directional light
+		glm::vec4 m_Params;                  // Atlas texel size, tile size in texture coordinates, tiles per row
+	};
+
+	// One depth image split into equally sized tiles, each holding one shadow map (a cascade of the directional light or a spot light).
+	// The atlas outlives frames so tiles whose light and casters didn't change keep their depth, and it's sampled with depth comparison.
+	// It's kept in the shader read layout between frames
+	class VulkanShadowAtlas
+	{
+	public:
+		static constexpr uint32 s_AtlasSize{ 4096 };
+		static constexpr uint32 s_TileSize{ 1024 };
+		static constexpr uint32 s_TilesPerRow{ s_AtlasSize / s_TileSize };
+		static constexpr uint32 s_TileCount{ s_TilesPerRow * s_TilesPerRow };
+		static constexpr uint32 s_CascadeCount{ 4 };
+
+		static_assert(s_TileCount == g_ShadowAtlasTileCount, "ShadowData must have one matrix per atlas tile");
+
+		VulkanShadowAtlas(const VkDevice& _logicalDevice, const VkPhysicalDevice& _gpu, const VkCommandPool& _commandPool, const VkQueue& _queue);
+		~VulkanShadowAtlas();
+
+		VkImage GetImage() const noexcept { return m_Image; }
+		VkImageView GetImageView() const noexcept { return m_ImageView; }
+		VkSampler GetSampler() const noexcept { return m_Sampler; }
+		uint32 GetFormat() const noexcept { return m_Format; }
+		// Top-left pixel of the tile
+		glm::uvec2 GetTileOffset(const uint32 _tile) const noexcept { return glm::uvec2(_tile % s_TilesPerRow, _tile / s_TilesPerRow) * s_TileSize; }
+
+		VulkanShadowAtlas(const VulkanShadowAtlas&) = delete;
+		VulkanShadowAtlas& operator=(const VulkanShadowAtlas&) = delete;
+		VulkanShadowAtlas(VulkanShadowAtlas&&) = delete;
+		VulkanShadowAtlas& operator=(VulkanShadowAtlas&&) = delete;
+
+	private:
+		VkDevice m_LogicalDevice;
+		uint32 m_Format;
+		VkImage m_Image;
+		VkDeviceMemory m_ImageMemory;
+		VkImageView m_ImageView;
+		VkSampler m_Sampler;
+	};
+} // End of Banshee namespace
\ No newline at end of file
@@ -0,0 +1,425 @@
+#include "VulkanShadowPass.h"
+#include "VulkanVertexBufferManager.h"
+#include "VulkanVertexBuffer.h"
+#include "VulkanGraphicsPipeline.h"
+#include "VulkanCommandEncoder.h"
+#include "Graphics/Camera.h"
+#include "Graphics/Components/TransformComponent.h"
+#include <glm/gtc/matrix_transform.hpp>
+#include <vulkan/vulkan.h>
+#include <algorithm>
+#include <cmath>
+
+namespace Banshee
+{
+	// Casters up to this far beyond a cascade, towards the directional light, still shadow it
+	constexpr static float g_ShadowCasterDistance{ 50.0f };
+	// Cascades move in steps of this many texels, so a cascade's cached shadow map stays valid while the camera moves within one step
+	constexpr static float g_CascadeSnapTexels{ 128.0f };
+	// Blend between logarithmic (1) and uniform (0) cascade splits
+	constexpr static float g_CascadeSplitLambda{ 0.75f };
+	constexpr static float g_SpotShadowNear{ 0.1f };
+
+	static bool IsSphereInFrustum(const Frustum& _frustum, const glm::vec3& _center, const float _radius) noexcept
+	{
+		for (const glm::vec4& plane : _frustum.m_Planes)
+		{
+			if (glm::dot(glm::vec3(plane), _center) + plane.w < -_radius)
+			{
+				return false;
+			}
+		}
+
+		return true;
+	}
+
+	// Any up vector works for a light as long as it's not parallel to the light's direction
+	static glm::vec3 GetLightUp(const glm::vec3& _direction) noexcept
+	{
+		return std::abs(_direction.y) > 0.99f ? glm::vec3(0.0f, 0.0f, 1.0f) : glm::vec3(0.0f, 1.0f, 0.0f);
+	}
+
+	// Maps clip-space x and y of a shadow map to the rectangle of its tile in atlas texture coordinates. Depth passes through
+	static glm::mat4 GetTileTextureMatrix(const uint32 _tile) noexcept
+	{
+		constexpr float tileScale{ 1.0f / VulkanShadowAtlas::s_TilesPerRow };
+		const glm::vec2 tileOffset = glm::vec2(_tile % VulkanShadowAtlas::s_TilesPerRow, _tile / VulkanShadowAtlas::s_TilesPerRow) * tileScale;
+
+		glm::mat4 matrix{ 1.0f };
+		matrix[0][0] = 0.5f * tileScale;
+		matrix[1][1] = 0.5f * tileScale;
+		matrix[3][0] = 0.5f * tileScale + tileOffset.x;
+		matrix[3][1] = 0.5f * tileScale + tileOffset.y;
+		return matrix;
+	}
+
+	// Orthographic shadow map of the directional light covering the camera's view depths [_near, _far]. The cascade is fitted around the bounding
+	// sphere of that slice of the view frustum, whose radius only depends on the projection, so the shadow map doesn't change size as the camera turns.
+	// The sphere's center is snapped to a light-space grid g_CascadeSnapTexels wide and the map is grown by half a step to still contain it,
+	// which keeps the projection, and with it the cached map, identical until the camera crosses a grid cell
+	static void ComputeCascade(const glm::mat4& _inverseView, const glm::mat4& _projection, const glm::vec3& _direction, const float _near, const float _far,
+		glm::mat4& _outView, glm::mat4& _outProj) noexcept
+	{
+		const float tanHalfFovX = 1.0f / _projection[0][0];
+		const float tanHalfFovY = 1.0f / std::abs(_projection[1][1]);
+		const float halfDepth = 0.5f * (_far - _near);
+		const float radius = std::sqrt(halfDepth * halfDepth + _far * _far * (tanHalfFovX * tanHalfFovX + tanHalfFovY * tanHalfFovY));
+
+		// A step of k texels over a map of r + step / 2 texels per half side solves to step = 2kr / (size - k)
+		constexpr float tileSize{ static_cast<float>(VulkanShadowAtlas::s_TileSize) };
+		const float snapStep = 2.0f * g_CascadeSnapTexels * radius / (tileSize - g_CascadeSnapTexels);
+		const float halfExtent = radius + 0.5f * snapStep;
+
+		const glm::vec3 up = GetLightUp(_direction);
+		const glm::mat4 lightRotation = glm::lookAt(glm::vec3(0.0f), _direction, up);
+		const glm::vec3 center = glm::vec3(_inverseView * glm::vec4(0.0f, 0.0f, -(_near + halfDepth), 1.0f));
+		const glm::vec3 lightSpaceCenter = (glm::floor(glm::vec3(lightRotation * glm::vec4(center, 1.0f)) / snapStep) + 0.5f) * snapStep;
+		const glm::vec3 snappedCenter = glm::vec3(glm::transpose(lightRotation) * glm::vec4(lightSpaceCenter, 1.0f));
+
+		const float eyeDistance = halfExtent + g_ShadowCasterDistance;
+		_outView = glm::lookAt(snappedCenter - _direction * eyeDistance, snappedCenter, up);
+		_outProj = glm::ortho(-halfExtent, halfExtent, -halfExtent, halfExtent, 0.0f, eyeDistance + halfExtent);
+	}
+
+	VulkanShadowPass::VulkanShadowPass(const VulkanShadowAtlas& _atlas, VulkanFrameAllocator& _frameAllocator, VulkanVertexBufferManager& _vertexBufferManager, const uint32 _maxInstances) :
+		m_Atlas{ _atlas },
+		m_FrameAllocator{ _frameAllocator },
+		m_VertexBufferManager{ _vertexBufferManager },
+		m_LightView{},
+		m_MaxInstances{ _maxInstances },
+		m_ShadowTiles{},
+		m_ShadowDraws{},
+		m_ShadowCasters{},
+		m_ShadowCasterBounds{},
+		m_ChangedCasterIds{},
+		m_ModelVersion{ 0 },
+		m_ShadowInstances{},
+		m_ShadowInstanceCount{ 0 },
+		m_ShadowLights{},
+		m_ShadowCasterVisibility{},
+		m_ShadowCasterOrder{}
+	{
+		for (ShadowTile& tile : m_ShadowTiles)
+		{
+			tile.m_LightId = Entity::s_InvalidId;
+		}
+	}
+
+	void VulkanShadowPass::ClearCasters() noexcept
+	{
+		m_ShadowCasters.clear();
+		m_ShadowCasterBounds.Clear();
+	}
+
+	void VulkanShadowPass::AddCaster(const ShadowCaster& _caster, const glm::mat4& _model, const BoundingSphere& _sphere, const AxisAlignedBox& _box)
+	{
+		m_ShadowCasters.push_back(_caster);
+		m_ShadowCasterBounds.Add(_model, _sphere, _box);
+	}
+
+	void VulkanShadowPass::InvalidateCaster(const uint32 _entityId)
+	{
+		m_ChangedCasterIds.push_back(_entityId);
+	}
+
+	uint32 VulkanShadowPass::Update(const Camera& _camera, const Frustum& _frustum, const std::vector<InstanceData>& _instances)
+	{
+		constexpr uint32 cascadeCount{ VulkanShadowAtlas::s_CascadeCount };
+		constexpr uint32 tileCount{ VulkanShadowAtlas::s_TileCount };
+
+		// Tiles redrawn this frame share one instance range, each tile's draws read a contiguous run of it
+		m_ShadowInstances = m_FrameAllocator.Allocate(sizeof(InstanceData) * m_MaxInstances);
+		m_ShadowInstanceCount = 0;
+		m_ShadowDraws.clear();
+		std::sort(m_ChangedCasterIds.begin(), m_ChangedCasterIds.end());
+		m_ChangedCasterIds.erase(std::unique(m_ChangedCasterIds.begin(), m_ChangedCasterIds.end()), m_ChangedCasterIds.end());
+
+		for (ShadowTile& tile : m_ShadowTiles)
+		{
+			tile.m_Redraw = false;
+		}
+
+		const glm::mat4& viewMatrix = _camera.GetViewMatrix();
+		ShadowData shadowData{};
+		uint32 directionalId{ Entity::s_InvalidId };
+		bool directionalShadows{ false };
+		bool directionalChanged{ false };
+		glm::vec3 directionalDirection{ 0.0f, -1.0f, 0.0f };
+
+		// Only the first directional light is shaded. Spot lights outside the camera frustum don't light anything visible and give up their tile
+		m_ShadowLights.clear();
+		m_LightView.ForEach([&](const Entity _entity, LightComponent& _lightComponent)
+			{
+				const TransformComponent* const transformComponent = _entity.GetTransform();
+				const bool changed = _lightComponent.NeedsUpdate() || (transformComponent && transformComponent->GetModelVersion() > m_ModelVersion);
+				_lightComponent.ClearNeedsUpdate();
+
+				if (_lightComponent.GetType() == LightType::Directional)
+				{
+					if (directionalId == Entity::s_InvalidId)
+					{
+						directionalId = _entity.GetUniqueId();
+						directionalShadows = _lightComponent.CastsShadows();
+						directionalChanged = changed;
+						directionalDirection = _lightComponent.GetDirection();
+						shadowData.m_DirectionalDirection = glm::vec4(glm::mat3(viewMatrix) * directionalDirection, 0.0f);
+						shadowData.m_DirectionalColor = glm::vec4(_lightComponent.GetColor(), 1.0f);
+					}
+				}
+				else if (_lightComponent.GetType() == LightType::Spot && _lightComponent.CastsShadows() && transformComponent &&
+					IsSphereInFrustum(_frustum, transformComponent->GetPosition(), _lightComponent.GetRange()))
+				{
+					m_ShadowLights.push_back({ _entity.GetUniqueId(), Entity::s_InvalidId, transformComponent->GetPosition(), _lightComponent.GetDirection(),
+						_lightComponent.GetRange(), _lightComponent.GetOuterConeAngle(), changed });
+				}
+			});
+
+		// Spot lights keep their tile for as long as they cast shadows, tiles of lights that stopped are handed to new ones.
+		// Lights left without a tile are shaded unshadowed
+		for (uint32 tile = cascadeCount; tile < tileCount; ++tile)
+		{
+			ShadowTile& shadowTile = m_ShadowTiles[tile];
+			const auto light = std::find_if(m_ShadowLights.begin(), m_ShadowLights.end(), [&shadowTile](const ShadowLight& _light) noexcept { return _light.m_Id == shadowTile.m_LightId; });
+			if (light != m_ShadowLights.end())
+			{
+				light->m_Tile = tile;
+			}
+			else
+			{
+				shadowTile.m_LightId = Entity::s_InvalidId;
+				shadowTile.m_Valid = false;
+			}
+		}
+
+		uint32 freeTile{ cascadeCount };
+		for (ShadowLight& light : m_ShadowLights)
+		{
+			while (light.m_Tile == Entity::s_InvalidId && freeTile < tileCount)
+			{
+				if (m_ShadowTiles[freeTile].m_LightId == Entity::s_InvalidId)
+				{
+					light.m_Tile = freeTile;
+					m_ShadowTiles[freeTile].m_LightId = light.m_Id;
+				}
+
+				++freeTile;
+			}
+		}
+
+		// Cascades end at practical split distances, a blend of logarithmic and uniform splits of the camera's depth range.
+		// The directional light is only shadowed once every cascade has a shadow map
+		if (directionalShadows)
+		{
+			const float nearPlane = _camera.GetNear();
+			const float farPlane = _camera.GetFar();
+			const glm::mat4 inverseView = glm::inverse(viewMatrix);
+			float cascadeNear = nearPlane;
+			bool cascadesValid{ true };
+
+			for (uint32 cascade = 0; cascade < cascadeCount; ++cascade)
+			{
+				const float ratio = static_cast<float>(cascade + 1) / cascadeCount;
+				const float logSplit = nearPlane * std::pow(farPlane / nearPlane, ratio);
+				const float uniformSplit = nearPlane + (farPlane - nearPlane) * ratio;
+				const float cascadeFar = g_CascadeSplitLambda * logSplit + (1.0f - g_CascadeSplitLambda) * uniformSplit;
+
+				glm::mat4 view{ 1.0f };
+				glm::mat4 proj{ 1.0f };
+				ComputeCascade(inverseView, _camera.GetProjectionMatrix(), directionalDirection, cascadeNear, cascadeFar, view, proj);
+				UpdateTile(cascade, directionalId, directionalChanged, view, proj, _instances);
+
+				cascadesValid = cascadesValid && m_ShadowTiles[cascade].m_Valid;
+				shadowData.m_CascadeSplits[cascade] = cascadeFar;
+				cascadeNear = cascadeFar;
+			}
+
+			shadowData.m_DirectionalDirection.w = cascadesValid ? static_cast<float>(cascadeCount) : 0.0f;
+		}
+		else
+		{
+			for (uint32 cascade = 0; cascade < cascadeCount; ++cascade)
+			{
+				m_ShadowTiles[cascade].m_LightId = Entity::s_InvalidId;
+				m_ShadowTiles[cascade].m_Valid = false;
+			}
+		}
+
+		for (const ShadowLight& light : m_ShadowLights)
+		{
+			if (light.m_Tile != Entity::s_InvalidId)
+			{
+				const glm::mat4 view = glm::lookAt(light.m_Position, light.m_Position + light.m_Direction, GetLightUp(light.m_Direction));
+				const glm::mat4 proj = glm::perspective(glm::radians(2.0f * light.m_OuterConeAngle), 1.0f, g_SpotShadowNear, light.m_Range);
+				UpdateTile(light.m_Tile, light.m_Id, light.m_Changed, view, proj, _instances);
+			}
+		}
+
+		// Shading happens in view space, so every tile matrix starts by undoing the camera's view
+		const glm::mat4 inverseView = glm::inverse(viewMatrix);
+		for (uint32 tile = 0; tile < tileCount; ++tile)
+		{
+			const ShadowTile& shadowTile = m_ShadowTiles[tile];
+			if (shadowTile.m_Valid && shadowTile.m_LightId != Entity::s_InvalidId)
+			{
+				shadowData.m_TileMatrices[tile] = GetTileTextureMatrix(tile) * shadowTile.m_ViewProj * inverseView;
+			}
+		}
+
+		shadowData.m_Params = glm::vec4(1.0f / VulkanShadowAtlas::s_AtlasSize, 1.0f / VulkanShadowAtlas::s_TilesPerRow, static_cast<float>(VulkanShadowAtlas::s_TilesPerRow), 0.0f);
+		m_ChangedCasterIds.clear();
+		m_ModelVersion = TransformComponent::GetLatestModelVersion();
+		return m_FrameAllocator.Write(shadowData);
+	}
+
+	void VulkanShadowPass::UpdateTile(const uint32 _tile, const uint32 _lightId, const bool _lightChanged, const glm::mat4& _view, const glm::mat4& _proj,
+		const std::vector<InstanceData>& _instances)
+	{
+		ShadowTile& tile = m_ShadowTiles[_tile];
+		const glm::mat4 viewProj = _proj * _view;
+		tile.m_Valid = tile.m_Valid && tile.m_LightId == _lightId && !_lightChanged && tile.m_ViewProj == viewProj;
+		tile.m_LightId = _lightId;
+		tile.m_ViewProj = viewProj;
+
+		if (tile.m_Valid && m_ChangedCasterIds.empty())
+		{
+			return;
+		}
+
+		m_ShadowCasterVisibility.resize(m_ShadowCasterBounds.Size());
+		FrustumCuller::Cull(Frustum::FromViewProj(viewProj), m_ShadowCasterBounds, m_ShadowCasterVisibility.data());
+
+		// A caster that changed while inside the tile, or that changed and is inside it now, makes the cached depth stale
+		const auto isChanged = [this](const uint32 _entityId) noexcept { return std::binary_search(m_ChangedCasterIds.begin(), m_ChangedCasterIds.end(), _entityId); };
+		if (tile.m_Valid)
+		{
+			tile.m_Valid = std::none_of(tile.m_Casters.begin(), tile.m_Casters.end(), isChanged);
+			for (size_t caster = 0; caster < m_ShadowCasters.size() && tile.m_Valid; ++caster)
+			{
+				tile.m_Valid = m_ShadowCasterVisibility[caster] == 0 || !isChanged(m_ShadowCasters[caster].m_EntityId);
+			}
+
+			if (tile.m_Valid)
+			{
+				return;
+			}
+		}
+
+		// Casters of the same sub-mesh become one instanced draw
+		m_ShadowCasterOrder.clear();
+		for (uint32 caster = 0; caster < m_ShadowCasters.size(); ++caster)
+		{
+			if (m_ShadowCasterVisibility[caster] != 0)
+			{
+				m_ShadowCasterOrder.push_back(caster);
+			}
+		}
+
+		std::sort(m_ShadowCasterOrder.begin(), m_ShadowCasterOrder.end(), [this](const uint32 _lhs, const uint32 _rhs) noexcept
+			{
+				const ShadowCaster& lhs = m_ShadowCasters[_lhs];
+				const ShadowCaster& rhs = m_ShadowCasters[_rhs];
+				return lhs.m_MeshId != rhs.m_MeshId ? lhs.m_MeshId < rhs.m_MeshId : lhs.m_IndexOffset < rhs.m_IndexOffset;
+			});
+
+		// Out of instance space the tile stays unshadowed and tries again next frame
+		if (m_ShadowInstanceCount + m_ShadowCasterOrder.size() > m_MaxInstances)
+		{
+			tile.m_Valid = false;
+			return;
+		}
+
+		InstanceData* const instanceData = reinterpret_cast<InstanceData*>(m_ShadowInstances.m_Data);
+		tile.m_FirstDraw = static_cast<uint32>(m_ShadowDraws.size());
+		tile.m_Casters.clear();
+
+		for (const uint32 casterIndex : m_ShadowCasterOrder)
+		{
+			const ShadowCaster& caster = m_ShadowCasters[casterIndex];
+			const VulkanVertexBuffer* const vertexBuffer = m_VertexBufferManager.GetVertexBuffer(caster.m_MeshId);
+			if (m_ShadowDraws.size() == tile.m_FirstDraw || m_ShadowDraws.back().m_VertexBuffer != vertexBuffer || m_ShadowDraws.back().m_IndexOffset != caster.m_IndexOffset)
+			{
+				m_ShadowDraws.push_back({ caster.m_IndexOffset, caster.m_IndexCount, m_ShadowInstanceCount, 0, vertexBuffer });
+			}
+
+			instanceData[m_ShadowInstanceCount++] = _instances[caster.m_Instance];
+			++m_ShadowDraws.back().m_InstanceCount;
+			tile.m_Casters.push_back(caster.m_EntityId);
+		}
+
+		std::sort(tile.m_Casters.begin(), tile.m_Casters.end());
+		tile.m_Casters.erase(std::unique(tile.m_Casters.begin(), tile.m_Casters.end()), tile.m_Casters.end());
+
+		tile.m_DrawCount = static_cast<uint32>(m_ShadowDraws.size()) - tile.m_FirstDraw;
+		tile.m_ViewProjOffset = m_FrameAllocator.Write(ViewProjMatrix(_view, _proj));
+		tile.m_Valid = true;
+		tile.m_Redraw = true;
+	}
+
+	void VulkanShadowPass::Record(VulkanCommandEncoder& _encoder, const VulkanGraphicsPipeline& _pipeline, const VkDescriptorSet& _descriptorSet, std::array<uint32, 7> _dynamicOffsets) const noexcept
+	{
+		constexpr uint32 tileSize{ VulkanShadowAtlas::s_TileSize };
+		const VkCommandBuffer cmdBuffer = _encoder.Get();
+
+		// Tiles read the view-projection of their light and the shadow instance range in place of the camera's
+		_dynamicOffsets[3] = m_ShadowInstances.m_Offset;
+
+		for (uint32 tile = 0; tile < VulkanShadowAtlas::s_TileCount; ++tile)
+		{
+			const ShadowTile& shadowTile = m_ShadowTiles[tile];
+			if (!shadowTile.m_Redraw)
+			{
+				continue;
+			}
+
+			const glm::uvec2 tileOffset = m_Atlas.GetTileOffset(tile);
+			VkViewport viewport{};
+			viewport.x = static_cast<float>(tileOffset.x);
+			viewport.y = static_cast<float>(tileOffset.y);
+			viewport.width = static_cast<float>(tileSize);
+			viewport.height = static_cast<float>(tileSize);
+			viewport.minDepth = 0.0f;
+			viewport.maxDepth = 1.0f;
+			vkCmdSetViewport(cmdBuffer, 0, 1, &viewport);
+
+			VkRect2D tileRect{};
+			tileRect.offset = { static_cast<int32>(tileOffset.x), static_cast<int32>(tileOffset.y) };
+			tileRect.extent = { tileSize, tileSize };
+			vkCmdSetScissor(cmdBuffer, 0, 1, &tileRect);
+
+			VkClearAttachment clearAttachment{};
+			clearAttachment.aspectMask = VK_IMAGE_ASPECT_DEPTH_BIT;
+			clearAttachment.clearValue.depthStencil = { 1.0f, 0 };
+			const VkClearRect clearRect{ tileRect, 0, 1 };
+			vkCmdClearAttachments(cmdBuffer, 1, &clearAttachment, 1, &clearRect);
+
+			_encoder.BindPipeline(_pipeline.Get());
+			_dynamicOffsets[0] = shadowTile.m_ViewProjOffset;
+			_encoder.BindDescriptorSet(_pipeline.GetLayout(), 0, _descriptorSet, _dynamicOffsets);
+
+			for (uint32 draw = shadowTile.m_FirstDraw; draw < shadowTile.m_FirstDraw + shadowTile.m_DrawCount; ++draw)
+			{
+				const ShadowDraw& shadowDraw = m_ShadowDraws[draw];
+				shadowDraw.m_VertexBuffer->Bind(_encoder, 0);
+				_encoder.DrawIndexed(shadowDraw.m_IndexCount, shadowDraw.m_InstanceCount, shadowDraw.m_IndexOffset, 0, shadowDraw.m_FirstInstance);
+			}
+		}
+	}
+
+	bool VulkanShadowPass::HasTilesToRedraw() const noexcept
+	{
+		return std::any_of(m_ShadowTiles.begin(), m_ShadowTiles.end(), [](const ShadowTile& _tile) noexcept { return _tile.m_Redraw; });
+	}
+
+	int32 VulkanShadowPass::GetLightTile(const uint32 _lightId) const noexcept
+	{
+		for (uint32 tile = VulkanShadowAtlas::s_CascadeCount; tile < VulkanShadowAtlas::s_TileCount; ++tile)
+		{
+			if (m_ShadowTiles[tile].m_LightId == _lightId && m_ShadowTiles[tile].m_Valid)
+			{
+				return static_cast<int32>(tile);
+			}
+		}
+
+		return -1;
+	}
+} // End of Banshee namespace
\ No newline at end of file
@@ -0,0 +1,130 @@
+#pragma once
+
+#include "VulkanShadowAtlas.h"
+#include "VulkanFrameAllocator.h"
+#include "Foundation/Platform.h"
+#include "Foundation/Entity/View.h"
+#include "Graphics/Components/Light/LightComponent.h"
+#include "Graphics/MVP.h"
+#include "Graphics/FrustumCuller.h"
+#include <glm/glm.hpp>
+#include <array>
+#include <vector>
+
+typedef struct VkDescriptorSet_T* VkDescriptorSet;
+
+namespace Banshee
+{
+	class Camera;
+	class VulkanCommandEncoder;
+	class VulkanGraphicsPipeline;
+	class VulkanVertexBuffer;
+	class VulkanVertexBufferManager;
+
+	// Opaque sub-mesh that may cast shadows this frame, shadow casters aren't culled against the camera
+	struct ShadowCaster
+	{
+		uint32 m_EntityId;
+		uint32 m_MeshId;
+		uint32 m_IndexOffset;
+		uint32 m_IndexCount;
+		uint32 m_Instance;   // Index into the frame's instances
+	};
+
+	// Renders the shadow maps of the directional light's cascades and of the shadow casting spot lights into the tiles of the shadow atlas.
+	// Tiles are cached across frames and only redrawn once their light, projection or one of the casters inside them changed, so on most
+	// frames there is nothing to record. Casters are handed over every frame while the renderer gathers its draw items
+	class VulkanShadowPass
+	{
+	public:
+		// _maxInstances bounds the instances drawn into the tiles redrawn in one frame
+		VulkanShadowPass(const VulkanShadowAtlas& _atlas, VulkanFrameAllocator& _frameAllocator, VulkanVertexBufferManager& _vertexBufferManager, const uint32 _maxInstances);
+		~VulkanShadowPass() = default;
+
+		void ClearCasters() noexcept;
+		void AddCaster(const ShadowCaster& _caster, const glm::mat4& _model, const BoundingSphere& _sphere, const AxisAlignedBox& _box);
+		// The entity's meshes were added, removed, changed or switched LOD, so every tile it is or was inside gets redrawn
+		void InvalidateCaster(const uint32 _entityId);
+		// Latest transform model version the tiles have seen, casters with a newer one moved since
+		uint32 GetModelVersion() const noexcept { return m_ModelVersion; }
+
+		// Assigns atlas tiles to the shadow casting lights, finds the tiles whose cached shadow map is out of date and prepares their draws
+		// from _instances. Returns the offset of the frame's shadow uniform, which also carries the directional light
+		uint32 Update(const Camera& _camera, const Frustum& _frustum, const std::vector<InstanceData>& _instances);
+		// Clears and redraws the tiles Update found out of date, the rest of the atlas keeps its depth from earlier frames.
+		// _dynamicOffsets are the frame's, each tile replaces the view-projection and instance range with its own
+		void Record(VulkanCommandEncoder& _encoder, const VulkanGraphicsPipeline& _pipeline, const VkDescriptorSet& _descriptorSet, std::array<uint32, 7> _dynamicOffsets) const noexcept;
+		bool HasTilesToRedraw() const noexcept;
+		// Tile holding the light's shadow map, or -1 while it has no valid one
+		int32 GetLightTile(const uint32 _lightId) const noexcept;
+
+		VulkanShadowPass(const VulkanShadowPass&) = delete;
+		VulkanShadowPass& operator=(const VulkanShadowPass&) = delete;
+		VulkanShadowPass(VulkanShadowPass&&) = delete;
+		VulkanShadowPass& operator=(VulkanShadowPass&&) = delete;
+
+	private:
+		// Instanced draw of one sub-mesh into a shadow tile
+		struct ShadowDraw
+		{
+			uint32 m_IndexOffset;
+			uint32 m_IndexCount;
+			uint32 m_FirstInstance;
+			uint32 m_InstanceCount;
+			const VulkanVertexBuffer* m_VertexBuffer;
+		};
+
+		// A tile of the shadow atlas remembers what it was rendered with, and is only rendered again once its light's projection,
+		// the light itself or one of the casters inside or previously inside it changed
+		struct ShadowTile
+		{
+			uint32 m_LightId;                // Unique id of the light entity, Entity::s_InvalidId for unused tiles
+			glm::mat4 m_ViewProj;
+			std::vector<uint32> m_Casters;   // Sorted unique ids of the entities drawn into the tile
+			uint32 m_ViewProjOffset;         // This frame's view-projection and draws, for tiles redrawn this frame
+			uint32 m_FirstDraw;
+			uint32 m_DrawCount;
+			bool m_Valid;
+			bool m_Redraw;
+		};
+
+		// Spot light that gets a shadow tile this frame
+		struct ShadowLight
+		{
+			uint32 m_Id;
+			uint32 m_Tile;
+			glm::vec3 m_Position;
+			glm::vec3 m_Direction;
+			float m_Range;
+			float m_OuterConeAngle;
+			bool m_Changed;   // The light or its transform changed since the tiles were last brought up to date
+		};
+
+	private:
+		// Keeps the tile's cached shadow map when its light and projection are unchanged and no changed caster is or was inside it.
+		// Otherwise the casters inside the light's frustum are collected into the tile's draws and the tile is redrawn this frame
+		void UpdateTile(const uint32 _tile, const uint32 _lightId, const bool _lightChanged, const glm::mat4& _view, const glm::mat4& _proj,
+			const std::vector<InstanceData>& _instances);
+
+	private:
+		const VulkanShadowAtlas& m_Atlas;
+		VulkanFrameAllocator& m_FrameAllocator;
+		VulkanVertexBufferManager& m_VertexBufferManager;
+		View<LightComponent> m_LightView;
+		uint32 m_MaxInstances;
+		std::array<ShadowTile, VulkanShadowAtlas::s_TileCount> m_ShadowTiles;
+		std::vector<ShadowDraw> m_ShadowDraws;
+		std::vector<ShadowCaster> m_ShadowCasters;
+		CullingBoundsSoA m_ShadowCasterBounds;
+		// Entities whose meshes were added, removed, changed or moved since the tiles were last brought up to date
+		std::vector<uint32> m_ChangedCasterIds;
+		uint32 m_ModelVersion;
+		// Instances of the casters drawn into this frame's redrawn tiles
+		UniformAllocation m_ShadowInstances;
+		uint32 m_ShadowInstanceCount;
+		// Per-frame scratch, kept as members so their capacity is reused
+		std::vector<ShadowLight> m_ShadowLights;
+		std::vector<uint8> m_ShadowCasterVisibility;
+		std::vector<uint32> m_ShadowCasterOrder;
+	};
+} // End of Banshee namespace
\ No newline at end of file
@@ -14,7 +14,19 @@ namespace Banshee
 
 		if (!_window)
 		{
-			throw std::runtime_error("ERROR: Failed to create a Vulkan surface");
+			// Headless surfaces come from an instance extension, so the loader doesn't export the entry point
+			const auto createHeadlessSurface = reinterpret_cast<PFN_vkCreateHeadlessSurfaceEXT>(vkGetInstanceProcAddr(_instance, "vkCreateHeadlessSurfaceEXT"));
+
+			VkHeadlessSurfaceCreateInfoEXT surfaceCreateInfo{};
+			surfaceCreateInfo.sType = VK_STRUCTURE_TYPE_HEADLESS_SURFACE_CREATE_INFO_EXT;
+
+			if (!createHeadlessSurface || createHeadlessSurface(_instance, &surfaceCreateInfo, nullptr, &m_Surface) != VK_SUCCESS)
+			{
+				throw std::runtime_error("ERROR: Failed to create a headless Vulkan surface");
+			}
+
+			BE_LOG(LogCategory::Info, "[SURFACE]: Created headless Vulkan surface");
+			return;
 		}
 
 		if (glfwCreateWindowSurface(_instance, _window, nullptr, &m_Surface) != VK_SUCCESS)
@@ -9,6 +9,7 @@ namespace Banshee
 	class VulkanSurface
 	{
 	public:
+		// Without a window the surface is a headless one, which needs an instance created with VK_EXT_headless_surface
 		VulkanSurface(GLFWwindow* _window, const VkInstance& _instance);
 		~VulkanSurface();
 
@@ -19,6 +19,7 @@ namespace Banshee
 		~VulkanSwapchain();
 
 		VkSwapchainKHR Get() const noexcept { return m_Swapchain; }
+		const std::vector<VkImage>& GetImages() const noexcept { return m_SwapchainImages; }
 		const std::vector<VkImageView>& GetImageViews() const noexcept { return m_SwapchainImageViews; }
 		uint32 GetFormat() const noexcept { return m_Format; }
 		uint32 GetWidth() const noexcept { return m_Width; }
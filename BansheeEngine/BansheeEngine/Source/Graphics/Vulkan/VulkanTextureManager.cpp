@@ -15,11 +15,17 @@ namespace Banshee
 		m_CommandPool{ _commandPool },
 		m_TextureImageFormat{ VK_FORMAT_R8G8B8A8_SRGB },
 		m_TextureImages{},
-		m_TextureImageViews{}
+		m_TextureImageViews{},
+		m_PendingStagingReleases{}
 	{}
 
 	VulkanTextureManager::~VulkanTextureManager()
 	{
+		for (uint8 i = 0; i < m_PendingStagingReleases.size(); ++i)
+		{
+			ReleaseStagingBuffers(i);
+		}
+
 		for (const auto& image : m_TextureImages)
 		{
 			vkDestroyImageView(m_LogicalDevice, image.m_ImageView, nullptr);
@@ -28,14 +34,75 @@ namespace Banshee
 		}
 	}
 
-	void VulkanTextureManager::UploadTextures()
+	bool VulkanTextureManager::UploadTextures()
+	{
+		VkCommandBufferAllocateInfo allocInfo{};
+		allocInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
+		allocInfo.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+		allocInfo.commandPool = m_CommandPool;
+		allocInfo.commandBufferCount = 1;
+
+		VkCommandBuffer commandBuffer{};
+		vkAllocateCommandBuffers(m_LogicalDevice, &allocInfo, &commandBuffer);
+
+		VkCommandBufferBeginInfo beginInfo{};
+		beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+		beginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+		vkBeginCommandBuffer(commandBuffer, &beginInfo);
+
+		const bool uploaded = UploadTextures(commandBuffer, 0);
+
+		vkEndCommandBuffer(commandBuffer);
+
+		VkSubmitInfo submitInfo{};
+		submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+		submitInfo.commandBufferCount = 1;
+		submitInfo.pCommandBuffers = &commandBuffer;
+		vkQueueSubmit(m_GraphicsQueue, 1, &submitInfo, VK_NULL_HANDLE);
+		vkQueueWaitIdle(m_GraphicsQueue);
+		vkFreeCommandBuffers(m_LogicalDevice, m_CommandPool, 1, &commandBuffer);
+
+		// The queue is idle, so nothing recorded for frame 0 can still be reading its staging memory
+		ReleaseStagingBuffers(0);
+		return uploaded;
+	}
+
+	bool VulkanTextureManager::UploadTextures(const VkCommandBuffer& _commandBuffer, const uint8 _frameIndex)
 	{
 		const std::vector<Image>& images = g_ResourceManager.GetImages();
+		const uint64 uploadedCount{ m_TextureImages.size() };
 
-		for (const auto& image : images)
+		if (images.size() > uploadedCount && _frameIndex >= m_PendingStagingReleases.size())
 		{
-			CreateStagingBuffer(image.m_ImageSize, image.m_Pixels, image.m_ImageWidth, image.m_ImageHeight);
+			m_PendingStagingReleases.resize(_frameIndex + 1);
 		}
+
+		for (uint64 i = uploadedCount; i < images.size(); ++i)
+		{
+			VkBuffer stagingBuffer{};
+			VkDeviceMemory stagingBufferMemory{};
+			CreateStagingBuffer(images[i].m_ImageSize, images[i].m_Pixels, stagingBuffer, stagingBufferMemory);
+			CreateTextureImage(_commandBuffer, stagingBuffer, images[i].m_ImageWidth, images[i].m_ImageHeight);
+			m_PendingStagingReleases[_frameIndex].emplace_back(stagingBuffer, stagingBufferMemory);
+		}
+
+		return images.size() > uploadedCount;
+	}
+
+	void VulkanTextureManager::ReleaseStagingBuffers(const uint8 _frameIndex)
+	{
+		if (_frameIndex >= m_PendingStagingReleases.size())
+		{
+			return;
+		}
+
+		for (const auto& [stagingBuffer, stagingBufferMemory] : m_PendingStagingReleases[_frameIndex])
+		{
+			vkFreeMemory(m_LogicalDevice, stagingBufferMemory, nullptr);
+			vkDestroyBuffer(m_LogicalDevice, stagingBuffer, nullptr);
+		}
+
+		m_PendingStagingReleases[_frameIndex].clear();
 	}
 
 	const std::vector<VkImageView>& VulkanTextureManager::GetTextureImageViews() const noexcept
@@ -43,11 +110,8 @@ namespace Banshee
 		return m_TextureImageViews;
 	}
 
-	void VulkanTextureManager::CreateStagingBuffer(const uint64 _sizeOfBuffer, const unsigned char* _pixels, const uint32 _imgW, const uint32 _imgH)
+	void VulkanTextureManager::CreateStagingBuffer(const uint64 _sizeOfBuffer, const unsigned char* _pixels, VkBuffer& _stagingBuffer, VkDeviceMemory& _stagingBufferMemory)
 	{
-		VkBuffer stagingBuffer{};
-		VkDeviceMemory stagingBufferMemory{};
-
 		VulkanUtils::CreateBuffer
 		(
 			m_LogicalDevice,
@@ -55,24 +119,17 @@ namespace Banshee
 			_sizeOfBuffer,
 			VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
 			VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
-			stagingBuffer,
-			stagingBufferMemory
+			_stagingBuffer,
+			_stagingBufferMemory
 		);
 
 		void* data = nullptr;
-		vkMapMemory(m_LogicalDevice, stagingBufferMemory, 0, _sizeOfBuffer, 0, &data);
+		vkMapMemory(m_LogicalDevice, _stagingBufferMemory, 0, _sizeOfBuffer, 0, &data);
 		memcpy(data, _pixels, _sizeOfBuffer);
-		vkUnmapMemory(m_LogicalDevice, stagingBufferMemory);
-
-		CreateTextureImage(stagingBuffer, _imgW, _imgH);
-
-		vkFreeMemory(m_LogicalDevice, stagingBufferMemory, nullptr);
-		vkDestroyBuffer(m_LogicalDevice, stagingBuffer, nullptr);
-		stagingBufferMemory = VK_NULL_HANDLE;
-		stagingBuffer = VK_NULL_HANDLE;
+		vkUnmapMemory(m_LogicalDevice, _stagingBufferMemory);
 	}
 
-	void VulkanTextureManager::CreateTextureImage(const VkBuffer& _buffer, const uint32 _imgW, const uint32 _imgH)
+	void VulkanTextureManager::CreateTextureImage(const VkCommandBuffer& _commandBuffer, const VkBuffer& _buffer, const uint32 _imgW, const uint32 _imgH)
 	{
 		VkImage textureImage{};
 		VkImageView textureImageView{};
@@ -95,9 +152,7 @@ namespace Banshee
 		// Transition image layout to read pixels from VkBuffer
 		VulkanUtils::TransitionImageLayout
 		(
-			m_LogicalDevice,
-			m_CommandPool,
-			m_GraphicsQueue,
+			_commandBuffer,
 			textureImage,
 			m_TextureImageFormat,
 			VK_IMAGE_LAYOUT_UNDEFINED,
@@ -107,9 +162,7 @@ namespace Banshee
 		// Copy the pixels in VkBuffer to the image
 		VulkanUtils::CopyBufferToImage
 		(
-			m_LogicalDevice,
-			m_CommandPool,
-			m_GraphicsQueue,
+			_commandBuffer,
 			_buffer,
 			textureImage,
 			_imgW,
@@ -119,9 +172,7 @@ namespace Banshee
 		// Transition image layout so that it can be sampled in the shader
 		VulkanUtils::TransitionImageLayout
 		(
-			m_LogicalDevice,
-			m_CommandPool,
-			m_GraphicsQueue,
+			_commandBuffer,
 			textureImage,
 			m_TextureImageFormat,
 			VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
@@ -2,11 +2,13 @@
 
 #include "Foundation/Platform.h"
 #include <vector>
+#include <utility>
 
 typedef struct VkPhysicalDevice_T* VkPhysicalDevice;
 typedef struct VkDevice_T* VkDevice;
 typedef struct VkBuffer_T* VkBuffer;
 typedef struct VkCommandPool_T* VkCommandPool;
+typedef struct VkCommandBuffer_T* VkCommandBuffer;
 typedef struct VkQueue_T* VkQueue;
 typedef struct VkImage_T* VkImage;
 typedef struct VkImageView_T* VkImageView;
@@ -35,7 +37,12 @@ namespace Banshee
 		~VulkanTextureManager();
 
 		const std::vector<VkImageView>& GetTextureImageViews() const noexcept;
-		void UploadTextures();
+		// Uploads images loaded since the last call and waits for them to complete. Returns true if any new texture was created
+		bool UploadTextures();
+		// Records the uploads into _commandBuffer instead of waiting on the queue. Their staging memory is held until ReleaseStagingBuffers(_frameIndex)
+		bool UploadTextures(const VkCommandBuffer& _commandBuffer, const uint8 _frameIndex);
+		// Frees the staging memory of uploads recorded for _frameIndex. Call once that frame's fence has signaled
+		void ReleaseStagingBuffers(const uint8 _frameIndex);
 
 		VulkanTextureManager(const VulkanTextureManager&) = delete;
 		VulkanTextureManager& operator=(const VulkanTextureManager&) = delete;
@@ -43,8 +50,8 @@ namespace Banshee
 		VulkanTextureManager& operator=(VulkanTextureManager&&) = delete;
 
 	private:
-		void CreateStagingBuffer(const uint64 _sizeOfBuffer, const unsigned char* _pixels, const uint32 _imgW, const uint32 _imgH);
-		void CreateTextureImage(const VkBuffer& _buffer, const uint32 _imgW, const uint32 _imgH);
+		void CreateStagingBuffer(const uint64 _sizeOfBuffer, const unsigned char* _pixels, VkBuffer& _stagingBuffer, VkDeviceMemory& _stagingBufferMemory);
+		void CreateTextureImage(const VkCommandBuffer& _commandBuffer, const VkBuffer& _buffer, const uint32 _imgW, const uint32 _imgH);
 
 	private:
 		VkDevice m_LogicalDevice;
@@ -54,5 +61,7 @@ namespace Banshee
 		VkFormat m_TextureImageFormat;
 		std::vector<VulkanImage> m_TextureImages;
 		std::vector<VkImageView> m_TextureImageViews;
+		// Staging buffers of recorded uploads, indexed by the frame that recorded them
+		std::vector<std::vector<std::pair<VkBuffer, VkDeviceMemory>>> m_PendingStagingReleases;
 	};
 } // End of Banshee namespace
\ No newline at end of file
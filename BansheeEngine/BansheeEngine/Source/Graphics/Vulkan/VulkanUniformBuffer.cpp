@@ -5,17 +5,18 @@
 
 namespace Banshee
 {
-	VulkanUniformBuffer::VulkanUniformBuffer(const VkDevice& _logicalDevice, const VkPhysicalDevice& _gpu, const uint64 _size) :
+	VulkanUniformBuffer::VulkanUniformBuffer(const VkDevice& _logicalDevice, const VkPhysicalDevice& _gpu, const uint64 _size, const bool _allowStorageAccess) :
 		m_LogicalDevice{ _logicalDevice },
 		m_Buffer{ VK_NULL_HANDLE },
 		m_BufferMemory{ VK_NULL_HANDLE },
+		m_MappedData{ nullptr },
 		m_BufferSize{ _size }
 	{
 		// Create buffer object
 		VkBufferCreateInfo bufferCreateInfo{};
 		bufferCreateInfo.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
 		bufferCreateInfo.size = _size;
-		bufferCreateInfo.usage = VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT;
+		bufferCreateInfo.usage = VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT | (_allowStorageAccess ? VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_SRC_BIT : 0);
 		bufferCreateInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
 
 		if (vkCreateBuffer(_logicalDevice, &bufferCreateInfo, nullptr, &m_Buffer) != VK_SUCCESS)
@@ -34,26 +35,29 @@ namespace Banshee
 
 		vkAllocateMemory(_logicalDevice, &allocInfo, nullptr, &m_BufferMemory);
 		vkBindBufferMemory(_logicalDevice, m_Buffer, m_BufferMemory, 0);
+
+		// The memory is coherent, so writes through the mapping need no flushing
+		void* mappedData{ nullptr };
+		if (vkMapMemory(_logicalDevice, m_BufferMemory, 0, VK_WHOLE_SIZE, 0, &mappedData) != VK_SUCCESS)
+		{
+			throw std::runtime_error("ERROR: Failed to map uniform buffer memory");
+		}
+
+		m_MappedData = static_cast<uint8*>(mappedData);
 	}
 
 	VulkanUniformBuffer::~VulkanUniformBuffer()
 	{
+		vkUnmapMemory(m_LogicalDevice, m_BufferMemory);
+		m_MappedData = nullptr;
 		vkFreeMemory(m_LogicalDevice, m_BufferMemory, nullptr);
 		vkDestroyBuffer(m_LogicalDevice, m_Buffer, nullptr);
 		m_BufferMemory = VK_NULL_HANDLE;
 		m_Buffer = VK_NULL_HANDLE;
 	}
 
-	void VulkanUniformBuffer::CopyData(void* _pData) const noexcept
+	void VulkanUniformBuffer::Write(const void* const _data, const uint64 _size, const uint64 _offset) const noexcept
 	{
-		// Map the memory
-		void* mappedData{ nullptr };
-		vkMapMemory(m_LogicalDevice, m_BufferMemory, 0, m_BufferSize, 0, &mappedData);
-
-		// Copy the data to the buffer
-		memcpy(mappedData, _pData, m_BufferSize);
-
-		// Unmap the memory
-		vkUnmapMemory(m_LogicalDevice, m_BufferMemory);
+		memcpy(m_MappedData + _offset, _data, _size);
 	}
 } // End of Banshee namespace
\ No newline at end of file
@@ -9,21 +9,31 @@ typedef struct VkDeviceMemory_T* VkDeviceMemory;
 
 namespace Banshee
 {
+	// Host-visible, coherent uniform buffer that stays mapped for its whole lifetime, so writes are plain memcpys without map/unmap calls.
+	// With _allowStorageAccess the buffer can also be bound as a storage buffer, read as indirect draw arguments and copied from, for data too large or too
+	// variable in size for a uniform block, for data written by compute passes and for staging uploads to device-local buffers
 	class VulkanUniformBuffer
 	{
 	public:
-		VulkanUniformBuffer(const VkDevice& _logicalDevice, const VkPhysicalDevice& _gpu, const uint64 _size);
+		VulkanUniformBuffer(const VkDevice& _logicalDevice, const VkPhysicalDevice& _gpu, const uint64 _size, const bool _allowStorageAccess = false);
 		~VulkanUniformBuffer();
 
-		void CopyData(void* _pData) const noexcept;
+		void Write(const void* const _data, const uint64 _size, const uint64 _offset = 0) const noexcept;
+		uint8* GetMappedData() const noexcept { return m_MappedData; }
 		VkBuffer GetBuffer() const noexcept { return m_Buffer; }
 		uint64 GetBufferSize() const noexcept { return m_BufferSize; }
 		VkDeviceMemory GetBufferMemory() const noexcept { return m_BufferMemory; }
 
+		VulkanUniformBuffer(const VulkanUniformBuffer&) = delete;
+		VulkanUniformBuffer& operator=(const VulkanUniformBuffer&) = delete;
+		VulkanUniformBuffer(VulkanUniformBuffer&&) = delete;
+		VulkanUniformBuffer& operator=(VulkanUniformBuffer&&) = delete;
+
 	private:
 		VkDevice m_LogicalDevice;
 		VkBuffer m_Buffer;
 		VkDeviceMemory m_BufferMemory;
+		uint8* m_MappedData;
 		uint64 m_BufferSize;
 	};
 } // End of Banshee namespace
\ No newline at end of file
@@ -92,7 +92,7 @@ namespace Banshee
 		return shaderModule;
 	}
 
-	void VulkanUtils::CreateImageView(const VkDevice& _logicalDevice, const VkImage& _image, const uint32 _format, const uint32 _aspect, VkImageView& _imageView)
+	void VulkanUtils::CreateImageView(const VkDevice& _logicalDevice, const VkImage& _image, const uint32 _format, const uint32 _aspect, VkImageView& _imageView, const uint32 _baseMipLevel, const uint32 _mipLevelCount)
 	{
 		VkImageViewCreateInfo imageViewCreateInfo{};
 		imageViewCreateInfo.sType = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO;
@@ -104,8 +104,8 @@ namespace Banshee
 		imageViewCreateInfo.components.b = VK_COMPONENT_SWIZZLE_B;
 		imageViewCreateInfo.components.a = VK_COMPONENT_SWIZZLE_A;
 		imageViewCreateInfo.subresourceRange.aspectMask = _aspect;
-		imageViewCreateInfo.subresourceRange.baseMipLevel = 0;
-		imageViewCreateInfo.subresourceRange.levelCount = 1;
+		imageViewCreateInfo.subresourceRange.baseMipLevel = _baseMipLevel;
+		imageViewCreateInfo.subresourceRange.levelCount = _mipLevelCount;
 		imageViewCreateInfo.subresourceRange.baseArrayLayer = 0;
 		imageViewCreateInfo.subresourceRange.layerCount = 1;
 
@@ -146,7 +146,7 @@ namespace Banshee
 		vkBindBufferMemory(_logicalDevice, _buffer, _bufferMemory, 0);
 	}
 
-	void VulkanUtils::CreateImage(const VkDevice& _logicalDevice, const VkPhysicalDevice& _gpu, const uint32 _w, const uint32 _h, const VkFormat _format, const VkImageTiling _tiling, const VkImageUsageFlagBits _usage, const uint32 _memoryPropertyFlags, VkImage& _image, VkDeviceMemory& _imageMemory)
+	void VulkanUtils::CreateImage(const VkDevice& _logicalDevice, const VkPhysicalDevice& _gpu, const uint32 _w, const uint32 _h, const VkFormat _format, const VkImageTiling _tiling, const VkImageUsageFlagBits _usage, const uint32 _memoryPropertyFlags, VkImage& _image, VkDeviceMemory& _imageMemory, const uint32 _mipLevels)
 	{
 		// Create image object
 		VkImageCreateInfo imageCreateInfo{};
@@ -155,7 +155,7 @@ namespace Banshee
 		imageCreateInfo.extent.width = _w;
 		imageCreateInfo.extent.height = _h;
 		imageCreateInfo.extent.depth = 1;
-		imageCreateInfo.mipLevels = 1;
+		imageCreateInfo.mipLevels = _mipLevels;
 		imageCreateInfo.arrayLayers = 1;
 		imageCreateInfo.format = _format;
 		imageCreateInfo.tiling = _tiling;
@@ -242,10 +242,15 @@ namespace Banshee
 		return _format == VK_FORMAT_D32_SFLOAT_S8_UINT || _format == VK_FORMAT_D24_UNORM_S8_UINT;
 	}
 
-	void VulkanUtils::TransitionImageLayout(const VkDevice& _logicalDevice, const VkCommandPool& _commandPool, const VkQueue& _queue, VkImage& _image, const VkFormat _imageFormat, const VkImageLayout _oldLayout, const VkImageLayout _newLayout)
+	void VulkanUtils::TransitionImageLayout(const VkDevice& _logicalDevice, const VkCommandPool& _commandPool, const VkQueue& _queue, VkImage& _image, const VkFormat _imageFormat, const VkImageLayout _oldLayout, const VkImageLayout _newLayout, const uint32 _mipLevels)
 	{
 		VkCommandBuffer cmdBuffer = BeginSingleTimeCommands(_logicalDevice, _commandPool, _queue);
+		TransitionImageLayout(cmdBuffer, _image, _imageFormat, _oldLayout, _newLayout, _mipLevels);
+		EndSingleTimeCommands(_logicalDevice, _commandPool, _queue, cmdBuffer);
+	}
 
+	void VulkanUtils::TransitionImageLayout(const VkCommandBuffer& _cmdBuffer, VkImage& _image, const VkFormat _imageFormat, const VkImageLayout _oldLayout, const VkImageLayout _newLayout, const uint32 _mipLevels)
+	{
 		VkImageMemoryBarrier barrier{};
 		barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
 		barrier.oldLayout = _oldLayout;
@@ -254,8 +259,16 @@ namespace Banshee
 		barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
 		barrier.image = _image;
 		barrier.subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+		if (_imageFormat == VK_FORMAT_D32_SFLOAT || _imageFormat == VK_FORMAT_D16_UNORM)
+		{
+			barrier.subresourceRange.aspectMask = VK_IMAGE_ASPECT_DEPTH_BIT;
+		}
+		else if (HasStencilComponent(_imageFormat))
+		{
+			barrier.subresourceRange.aspectMask = VK_IMAGE_ASPECT_DEPTH_BIT | VK_IMAGE_ASPECT_STENCIL_BIT;
+		}
 		barrier.subresourceRange.baseMipLevel = 0;
-		barrier.subresourceRange.levelCount = 1;
+		barrier.subresourceRange.levelCount = _mipLevels;
 		barrier.subresourceRange.baseArrayLayer = 0;
 		barrier.subresourceRange.layerCount = 1;
 		barrier.srcAccessMask = 0;
@@ -280,6 +293,15 @@ namespace Banshee
 			srcStage = VK_PIPELINE_STAGE_TRANSFER_BIT;
 			dstStage = VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT;
 		}
+		else if (_oldLayout == VK_IMAGE_LAYOUT_UNDEFINED && _newLayout == VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL)
+		{
+			// Images whose contents are produced on the GPU later on, but which are sampled from in the layout they're kept in between frames
+			barrier.srcAccessMask = 0;
+			barrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
+
+			srcStage = VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT;
+			dstStage = VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT;
+		}
 		else
 		{
 			throw std::runtime_error("ERROR: Unsupported image layout transition");
@@ -287,21 +309,24 @@ namespace Banshee
 
 		vkCmdPipelineBarrier
 		(
-			cmdBuffer,
+			_cmdBuffer,
 			srcStage, dstStage,
 			0,
 			0, nullptr,
 			0, nullptr,
 			1, &barrier
 		);
-
-		EndSingleTimeCommands(_logicalDevice, _commandPool, _queue, cmdBuffer);
 	}
 
 	void VulkanUtils::CopyBufferToImage(const VkDevice& _logicalDevice, const VkCommandPool& _commandPool, const VkQueue& _queue, const VkBuffer& _srcBuffer, const VkImage& _image, const uint32 _w, const uint32 _h) noexcept
 	{
 		VkCommandBuffer cmdBuffer = BeginSingleTimeCommands(_logicalDevice, _commandPool, _queue);
+		CopyBufferToImage(cmdBuffer, _srcBuffer, _image, _w, _h);
+		EndSingleTimeCommands(_logicalDevice, _commandPool, _queue, cmdBuffer);
+	}
 
+	void VulkanUtils::CopyBufferToImage(const VkCommandBuffer& _cmdBuffer, const VkBuffer& _srcBuffer, const VkImage& _image, const uint32 _w, const uint32 _h) noexcept
+	{
 		VkBufferImageCopy region{};
 		region.bufferOffset = 0;
 		region.bufferRowLength = 0;
@@ -317,15 +342,13 @@ namespace Banshee
 
 		vkCmdCopyBufferToImage
 		(
-			cmdBuffer,
+			_cmdBuffer,
 			_srcBuffer,
 			_image,
 			VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
 			1,
 			&region
 		);
-
-		EndSingleTimeCommands(_logicalDevice, _commandPool, _queue, cmdBuffer);
 	}
 
 	VkCommandBuffer VulkanUtils::BeginSingleTimeCommands(const VkDevice& _logicalDevice, const VkCommandPool& _commandPool, const VkQueue& _queue) noexcept
@@ -28,14 +28,17 @@ namespace Banshee
 		static void CheckDeviceExtSupport(const VkPhysicalDevice& _gpu, const std::vector<const char*>& _requiredExtensions);
 		static VkShaderModule CreateShaderModule(const VkDevice& _logicalDevice, const std::vector<char>& _shaderBinaryCode);
 		static void CreateBuffer(const VkDevice& _logicalDevice, const VkPhysicalDevice& _gpu, const uint64 _size, const uint32 _usage, const uint32 _memoryPropertyFlags, VkBuffer& _buffer, VkDeviceMemory& _bufferMemory);
-		static void CreateImage(const VkDevice& _logicalDevice, const VkPhysicalDevice& _gpu, const uint32 _w, const uint32 _h, const VkFormat _format, const VkImageTiling _tiling, const VkImageUsageFlagBits _usage, const uint32 _memoryPropertyFlags, VkImage& _image, VkDeviceMemory& _imageMemory);
-		static void CreateImageView(const VkDevice& _logicalDevice, const VkImage& _image, const uint32 _format, const uint32 _aspect, VkImageView& _imageView);
+		static void CreateImage(const VkDevice& _logicalDevice, const VkPhysicalDevice& _gpu, const uint32 _w, const uint32 _h, const VkFormat _format, const VkImageTiling _tiling, const VkImageUsageFlagBits _usage, const uint32 _memoryPropertyFlags, VkImage& _image, VkDeviceMemory& _imageMemory, const uint32 _mipLevels = 1);
+		static void CreateImageView(const VkDevice& _logicalDevice, const VkImage& _image, const uint32 _format, const uint32 _aspect, VkImageView& _imageView, const uint32 _baseMipLevel = 0, const uint32 _mipLevelCount = 1);
 		static uint32 FindMemoryTypeIndex(const VkPhysicalDevice& _gpu, const uint32 _memoryTypeBits, const uint32 _memoryPropertyFlags) noexcept;
 		static void CopyBuffer(const VkDevice& _logicalDevice, const VkCommandPool& _commandPool, const VkQueue& _queue, const uint64 _size, const VkBuffer& _srcBuffer, const VkBuffer& _dstBuffer);
 		static VkFormat FindSupportedFormat(const VkPhysicalDevice& _gpu, const std::vector<VkFormat>& _formats, const VkImageTiling _tiling, const uint32 _formatFeatures);
 		static constexpr bool HasStencilComponent(const VkFormat _format) noexcept;
-		static void TransitionImageLayout(const VkDevice& _logicalDevice, const VkCommandPool& _commandPool, const VkQueue& _queue, VkImage& _image, const VkFormat _imageFormat, const VkImageLayout _oldLayout, const VkImageLayout _newLayout);
+		static void TransitionImageLayout(const VkDevice& _logicalDevice, const VkCommandPool& _commandPool, const VkQueue& _queue, VkImage& _image, const VkFormat _imageFormat, const VkImageLayout _oldLayout, const VkImageLayout _newLayout, const uint32 _mipLevels = 1);
 		static void CopyBufferToImage(const VkDevice& _logicalDevice, const VkCommandPool& _commandPool, const VkQueue& _queue, const VkBuffer& _srcBuffer, const VkImage& _image, const uint32 _w, const uint32 _h) noexcept;
+		// Record into _cmdBuffer instead of submitting and waiting on the queue
+		static void TransitionImageLayout(const VkCommandBuffer& _cmdBuffer, VkImage& _image, const VkFormat _imageFormat, const VkImageLayout _oldLayout, const VkImageLayout _newLayout, const uint32 _mipLevels = 1);
+		static void CopyBufferToImage(const VkCommandBuffer& _cmdBuffer, const VkBuffer& _srcBuffer, const VkImage& _image, const uint32 _w, const uint32 _h) noexcept;
 	
 	private:
 		static VkCommandBuffer BeginSingleTimeCommands(const VkDevice& _logicalDevice, const VkCommandPool& _commandPool, const VkQueue& _queue) noexcept;
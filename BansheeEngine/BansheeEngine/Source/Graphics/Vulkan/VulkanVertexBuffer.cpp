@@ -1,11 +1,12 @@
 #include "VulkanVertexBuffer.h"
+#include "VulkanCommandEncoder.h"
 #include "VulkanUtils.h"
 #include <vulkan/vulkan.h>
 
 namespace Banshee
 {
 	VulkanVertexBuffer::VulkanVertexBuffer(const VkDevice& _logicalDevice, const VkPhysicalDevice& _physicalDevice, const VkCommandPool& _commandPool, const VkQueue& _graphicsQueue,
-		void* _vertexData, const uint64 _sizeOfVertexData, void* _indexData, const uint64 _sizeOfIndexData) :
+		void* _vertexData, const uint64 _sizeOfVertexData, void* _indexData, const uint64 _sizeOfIndexData, const VkCommandBuffer& _uploadCommandBuffer) :
 		m_LogicalDevice{ _logicalDevice },
 		m_PhysicalDevice{ _physicalDevice },
 		m_CommandPool{ _commandPool },
@@ -13,26 +14,42 @@ namespace Banshee
 		m_VertexBuffer{ VK_NULL_HANDLE },
 		m_IndexBuffer{ VK_NULL_HANDLE },
 		m_VertexBufferMemory{ VK_NULL_HANDLE },
-		m_IndexBufferMemory{ VK_NULL_HANDLE }
+		m_IndexBufferMemory{ VK_NULL_HANDLE },
+		m_VertexStagingBuffer{ VK_NULL_HANDLE },
+		m_IndexStagingBuffer{ VK_NULL_HANDLE },
+		m_VertexStagingBufferMemory{ VK_NULL_HANDLE },
+		m_IndexStagingBufferMemory{ VK_NULL_HANDLE }
 	{
-		CreateVertexBuffer(_vertexData, _sizeOfVertexData);
-		CreateIndexBuffer(_indexData, _sizeOfIndexData);
+		CreateVertexBuffer(_vertexData, _sizeOfVertexData, _uploadCommandBuffer);
+		CreateIndexBuffer(_indexData, _sizeOfIndexData, _uploadCommandBuffer);
 	}
 
 	VulkanVertexBuffer::~VulkanVertexBuffer()
 	{
+		ReleaseStagingBuffers();
 		CleanUpVertexBuffer();
 		CleanUpIndexBuffer();
 	}
 
-	void VulkanVertexBuffer::Bind(const VkCommandBuffer& _commandBuffer, const uint64 _indexOffset) const noexcept
+	void VulkanVertexBuffer::ReleaseStagingBuffers() noexcept
 	{
-		const VkDeviceSize offsets[] = { 0 };
-		vkCmdBindVertexBuffers(_commandBuffer, 0, 1, &m_VertexBuffer, offsets);
-		vkCmdBindIndexBuffer(_commandBuffer, m_IndexBuffer, _indexOffset, VK_INDEX_TYPE_UINT32);
+		vkFreeMemory(m_LogicalDevice, m_VertexStagingBufferMemory, nullptr);
+		vkDestroyBuffer(m_LogicalDevice, m_VertexStagingBuffer, nullptr);
+		vkFreeMemory(m_LogicalDevice, m_IndexStagingBufferMemory, nullptr);
+		vkDestroyBuffer(m_LogicalDevice, m_IndexStagingBuffer, nullptr);
+		m_VertexStagingBufferMemory = VK_NULL_HANDLE;
+		m_VertexStagingBuffer = VK_NULL_HANDLE;
+		m_IndexStagingBufferMemory = VK_NULL_HANDLE;
+		m_IndexStagingBuffer = VK_NULL_HANDLE;
 	}
 
-	void VulkanVertexBuffer::CreateVertexBuffer(void* _data, const uint64 _size)
+	void VulkanVertexBuffer::Bind(VulkanCommandEncoder& _encoder, const uint64 _indexOffset) const noexcept
+	{
+		_encoder.BindVertexBuffer(m_VertexBuffer, 0);
+		_encoder.BindIndexBuffer(m_IndexBuffer, _indexOffset);
+	}
+
+	void VulkanVertexBuffer::CreateVertexBuffer(void* _data, const uint64 _size, const VkCommandBuffer& _uploadCommandBuffer)
 	{
 		// Create staging buffer
 		VkBuffer stagingBuffer{};
@@ -58,6 +75,16 @@ namespace Banshee
 			VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_VERTEX_BUFFER_BIT,
 			VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, m_VertexBuffer, m_VertexBufferMemory);
 
+		// Record the copy into the frame's command buffer and keep the staging buffer until it has executed
+		if (_uploadCommandBuffer)
+		{
+			const VkBufferCopy bufferCopy{ 0, 0, _size };
+			vkCmdCopyBuffer(_uploadCommandBuffer, stagingBuffer, m_VertexBuffer, 1, &bufferCopy);
+			m_VertexStagingBuffer = stagingBuffer;
+			m_VertexStagingBufferMemory = stagingBufferMemory;
+			return;
+		}
+
 		// Copy content of staging buffer into vertex buffer
 		VulkanUtils::CopyBuffer(m_LogicalDevice, m_CommandPool, m_GraphicsQueue, _size, stagingBuffer, m_VertexBuffer);
 
@@ -68,7 +95,7 @@ namespace Banshee
 		stagingBuffer = VK_NULL_HANDLE;
 	}
 
-	void VulkanVertexBuffer::CreateIndexBuffer(void* _data, const uint64 _size)
+	void VulkanVertexBuffer::CreateIndexBuffer(void* _data, const uint64 _size, const VkCommandBuffer& _uploadCommandBuffer)
 	{
 		// Create staging buffer
 		VkBuffer stagingBuffer{};
@@ -94,6 +121,15 @@ namespace Banshee
 			VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_INDEX_BUFFER_BIT,
 			VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, m_IndexBuffer, m_IndexBufferMemory);
 
+		if (_uploadCommandBuffer)
+		{
+			const VkBufferCopy bufferCopy{ 0, 0, _size };
+			vkCmdCopyBuffer(_uploadCommandBuffer, stagingBuffer, m_IndexBuffer, 1, &bufferCopy);
+			m_IndexStagingBuffer = stagingBuffer;
+			m_IndexStagingBufferMemory = stagingBufferMemory;
+			return;
+		}
+
 		// Copy content of staging buffer into index buffer
 		VulkanUtils::CopyBuffer(m_LogicalDevice, m_CommandPool, m_GraphicsQueue, _size, stagingBuffer, m_IndexBuffer);
 
@@ -12,13 +12,18 @@ typedef struct VkQueue_T* VkQueue;
 
 namespace Banshee
 {
+	class VulkanCommandEncoder;
+
 	class VulkanVertexBuffer
 	{
 	public:
-		VulkanVertexBuffer(const VkDevice& _logicalDevice, const VkPhysicalDevice& _physicalDevice, const VkCommandPool& _commandPool, const VkQueue& _graphicsQueue, void* _vertexData, const uint64 _sizeOfVertexData, void* _indexData, const uint64 _sizeOfIndexData);
+		// When _uploadCommandBuffer is provided the staging copies are recorded into it instead of being submitted and waited on.
+		// The staging buffers must then be kept alive until that command buffer has finished executing, see ReleaseStagingBuffers
+		VulkanVertexBuffer(const VkDevice& _logicalDevice, const VkPhysicalDevice& _physicalDevice, const VkCommandPool& _commandPool, const VkQueue& _graphicsQueue, void* _vertexData, const uint64 _sizeOfVertexData, void* _indexData, const uint64 _sizeOfIndexData, const VkCommandBuffer& _uploadCommandBuffer = nullptr);
 		~VulkanVertexBuffer();
 
-		void Bind(const VkCommandBuffer& _commandBuffer, const uint64 _indexOffset) const noexcept;
+		void Bind(VulkanCommandEncoder& _encoder, const uint64 _indexOffset) const noexcept;
+		void ReleaseStagingBuffers() noexcept;
 
 		VulkanVertexBuffer(const VulkanVertexBuffer&) = delete;
 		VulkanVertexBuffer& operator=(const VulkanVertexBuffer&) = delete;
@@ -26,8 +31,8 @@ namespace Banshee
 		VulkanVertexBuffer& operator=(VulkanVertexBuffer&&) = delete;
 
 	private:
-		void CreateVertexBuffer(void* _data, const uint64 _size);
-		void CreateIndexBuffer(void* _data, const uint64 _size);
+		void CreateVertexBuffer(void* _data, const uint64 _size, const VkCommandBuffer& _uploadCommandBuffer);
+		void CreateIndexBuffer(void* _data, const uint64 _size, const VkCommandBuffer& _uploadCommandBuffer);
 		void CleanUpVertexBuffer() noexcept;
 		void CleanUpIndexBuffer() noexcept;
 
@@ -40,5 +45,9 @@ namespace Banshee
 		VkBuffer m_IndexBuffer;
 		VkDeviceMemory m_VertexBufferMemory;
 		VkDeviceMemory m_IndexBufferMemory;
+		VkBuffer m_VertexStagingBuffer;
+		VkBuffer m_IndexStagingBuffer;
+		VkDeviceMemory m_VertexStagingBufferMemory;
+		VkDeviceMemory m_IndexStagingBufferMemory;
 	};
 } // End of Banshee namespace
\ No newline at end of file
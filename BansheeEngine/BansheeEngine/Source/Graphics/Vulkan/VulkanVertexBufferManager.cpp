@@ -4,7 +4,7 @@
 #include "Graphics/Components/MeshComponent.h"
 #include "Graphics/Shapes/ShapeFactory.h"
 #include "Graphics/Systems/ModelLoadingSystem.h"
-#include "Graphics/Systems/MeshSystem.h"
+#include <vulkan/vulkan.h>
 #include <stdexcept>
 
 namespace Banshee
@@ -14,7 +14,13 @@ namespace Banshee
 		m_PhysicalDevice{ _physicalDevice },
 		m_CommandPool{ _commandPool },
 		m_GraphicsQueue{ _graphicsQueue },
-		m_VertexBuffers{}
+		m_UploadCommandBuffer{ VK_NULL_HANDLE },
+		m_UploadFrameIndex{ 0 },
+		m_HasRecordedUploads{ false },
+		m_VertexBuffers{},
+		m_ModelNameToIdMap{},
+		m_SubMeshTemplates{},
+		m_PendingStagingReleases{}
 	{}
 
 	void VulkanVertexBufferManager::GenerateBuffers(const uint32 _bufferId, void* _vertexData, const uint64 _sizeOfVertexData, void* _indexData, const uint64 _sizeOfIndexData)
@@ -23,26 +29,78 @@ namespace Banshee
 		(
 			std::piecewise_construct,
 			std::forward_as_tuple(_bufferId),
-			std::forward_as_tuple(m_LogicalDevice, m_PhysicalDevice, m_CommandPool, m_GraphicsQueue, _vertexData, _sizeOfVertexData, _indexData, _sizeOfIndexData)
+			std::forward_as_tuple(m_LogicalDevice, m_PhysicalDevice, m_CommandPool, m_GraphicsQueue, _vertexData, _sizeOfVertexData, _indexData, _sizeOfIndexData, m_UploadCommandBuffer)
 		);
+
+		if (m_UploadCommandBuffer)
+		{
+			if (m_UploadFrameIndex >= m_PendingStagingReleases.size())
+			{
+				m_PendingStagingReleases.resize(m_UploadFrameIndex + 1);
+			}
+
+			m_PendingStagingReleases[m_UploadFrameIndex].push_back(_bufferId);
+			m_HasRecordedUploads = true;
+		}
+	}
+
+	void VulkanVertexBufferManager::BeginRecordedUploads(const VkCommandBuffer& _commandBuffer, const uint8 _frameIndex) noexcept
+	{
+		m_UploadCommandBuffer = _commandBuffer;
+		m_UploadFrameIndex = _frameIndex;
+		m_HasRecordedUploads = false;
+	}
+
+	void VulkanVertexBufferManager::EndRecordedUploads()
+	{
+		if (m_HasRecordedUploads)
+		{
+			VkMemoryBarrier barrier{};
+			barrier.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+			barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+			barrier.dstAccessMask = VK_ACCESS_VERTEX_ATTRIBUTE_READ_BIT | VK_ACCESS_INDEX_READ_BIT;
+			vkCmdPipelineBarrier(m_UploadCommandBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_VERTEX_INPUT_BIT, 0, 1, &barrier, 0, nullptr, 0, nullptr);
+		}
+
+		m_UploadCommandBuffer = VK_NULL_HANDLE;
+		m_HasRecordedUploads = false;
+	}
+
+	void VulkanVertexBufferManager::ReleaseStagingBuffers(const uint8 _frameIndex)
+	{
+		if (_frameIndex >= m_PendingStagingReleases.size())
+		{
+			return;
+		}
+
+		for (const uint32 bufferId : m_PendingStagingReleases[_frameIndex])
+		{
+			auto vertexBuffer = m_VertexBuffers.find(bufferId);
+			if (vertexBuffer != m_VertexBuffers.end())
+			{
+				vertexBuffer->second.ReleaseStagingBuffers();
+			}
+		}
+
+		m_PendingStagingReleases[_frameIndex].clear();
 	}
 
-	void VulkanVertexBufferManager::CreateBasicShapeVertexBuffer(MeshComponent* const _meshComponent, const MeshSystem* const _meshSystem)
+	void VulkanVertexBufferManager::CreateBasicShapeVertexBuffer(MeshComponent* const _meshComponent)
 	{
-		assert(_meshComponent != nullptr && _meshSystem != nullptr);
+		assert(_meshComponent != nullptr);
 
 		const uint32 meshId{ _meshComponent->GetMeshId() };
 		auto vertexBuffer{ m_VertexBuffers.find(meshId) };
 
 		if (vertexBuffer != m_VertexBuffers.end())
 		{
-			const auto duplicatedMesh = _meshSystem->GetMeshComponentById(meshId);
-			if (!duplicatedMesh || duplicatedMesh->GetSubMeshes().empty())
+			auto subMeshTemplate = m_SubMeshTemplates.find(meshId);
+			if (subMeshTemplate == m_SubMeshTemplates.end() || subMeshTemplate->second.empty())
 			{
 				return;
 			}
 
-			auto subMesh = duplicatedMesh->GetSubMeshes()[0];
+			auto subMesh = subMeshTemplate->second[0];
 			subMesh.SetTexId(_meshComponent->GetTexId());
 			subMesh.material.SetDiffuseColor(_meshComponent->GetColor());
 			_meshComponent->SetSubMesh(subMesh);
@@ -55,19 +113,21 @@ namespace Banshee
 
 			ShapeFactory::GetShapeData(static_cast<PrimitiveShape>(meshId), vertices, indices);
 			Mesh mesh{};
-			mesh.vertices = vertices;
-			mesh.indices = indices;
+			mesh.indexCount = static_cast<uint32>(indices.size());
+			mesh.boundingBox = ComputeAxisAlignedBox(vertices.data(), vertices.size());
+			mesh.boundingSphere = ComputeBoundingSphere(vertices.data(), vertices.size(), mesh.boundingBox);
 			mesh.SetTexId(_meshComponent->GetTexId());
 			mesh.material.SetDiffuseColor(_meshComponent->GetColor());
 			_meshComponent->SetSubMesh(mesh);
+			m_SubMeshTemplates[meshId] = _meshComponent->GetSubMeshes();
 
 			GenerateBuffers(meshId, vertices.data(), sizeof(Vertex) * vertices.size(), indices.data(), sizeof(uint32) * indices.size());
 		}
 	}
 
-	void VulkanVertexBufferManager::CreateModelVertexBuffer(MeshComponent* const _meshComponent, const MeshSystem* const _meshSystem)
+	void VulkanVertexBufferManager::CreateModelVertexBuffer(MeshComponent* const _meshComponent)
 	{
-		assert(_meshComponent != nullptr && _meshSystem != nullptr);
+		assert(_meshComponent != nullptr);
 
 		const std::string_view modelName{ _meshComponent->GetModelName() };
 		uint32 modelId{ 0 };
@@ -78,8 +138,7 @@ namespace Banshee
 			modelId = it->second;
 			_meshComponent->SetMeshId(modelId);
 
-			const auto duplicatedMesh = _meshSystem->GetMeshComponentById(modelId);
-			_meshComponent->SetSubMeshes(duplicatedMesh->GetSubMeshes());
+			_meshComponent->SetSubMeshes(m_SubMeshTemplates[modelId]);
 			return;
 		}
 		else
@@ -100,6 +159,7 @@ namespace Banshee
 		std::vector<Vertex> vertices{};
 		std::vector<uint32> indices{};
 		const ModelLoadingSystem modelLoadingSystem{ _meshComponent->GetModelPath().c_str(), _meshComponent, vertices, indices };
+		m_SubMeshTemplates[modelId] = _meshComponent->GetSubMeshes();
 
 		GenerateBuffers(modelId, vertices.data(), sizeof(Vertex) * vertices.size(), indices.data(), sizeof(uint32) * indices.size());
 	}
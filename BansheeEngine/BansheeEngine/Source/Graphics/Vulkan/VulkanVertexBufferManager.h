@@ -2,13 +2,14 @@
 
 #include "VulkanVertexBuffer.h"
 #include "Foundation/Platform.h"
+#include "Graphics/Mesh.h"
 #include <unordered_map>
 #include <string>
+#include <vector>
 
 namespace Banshee
 {
 	class MeshComponent;
-	class MeshSystem;
 
 	class VulkanVertexBufferManager
 	{
@@ -16,10 +17,17 @@ namespace Banshee
 		VulkanVertexBufferManager(const VkDevice& _logicalDevice, const VkPhysicalDevice& _physicalDevice, const VkCommandPool& _commandPool, const VkQueue& _graphicsQueue);
 
 		void GenerateBuffers(const uint32 _bufferId, void* _vertexData, const uint64 _sizeOfVertexData, void* _indexData, const uint64 _sizeOfIndexData);
-		void CreateBasicShapeVertexBuffer(MeshComponent* const _meshComponent, const MeshSystem* const _meshSystem);
-		void CreateModelVertexBuffer(MeshComponent* const _meshComponent, const MeshSystem* const _meshSystem);
+		void CreateBasicShapeVertexBuffer(MeshComponent* const _meshComponent);
+		void CreateModelVertexBuffer(MeshComponent* const _meshComponent);
 		VulkanVertexBuffer* GetVertexBuffer(const uint32 _bufferId);
 
+		// Buffers generated between these calls record their staging copies into _commandBuffer instead of blocking on the queue.
+		// EndRecordedUploads records the barrier that makes the copies visible to vertex input, if any copies were recorded
+		void BeginRecordedUploads(const VkCommandBuffer& _commandBuffer, const uint8 _frameIndex) noexcept;
+		void EndRecordedUploads();
+		// Frees the staging memory of uploads recorded for _frameIndex. Call once that frame's fence has signaled
+		void ReleaseStagingBuffers(const uint8 _frameIndex);
+
 		VulkanVertexBufferManager(const VulkanVertexBufferManager&) = delete;
 		VulkanVertexBufferManager& operator=(const VulkanVertexBufferManager&) = delete;
 		VulkanVertexBufferManager(VulkanVertexBufferManager&&) = delete;
@@ -30,7 +38,12 @@ namespace Banshee
 		VkPhysicalDevice m_PhysicalDevice;
 		VkCommandPool m_CommandPool;
 		VkQueue m_GraphicsQueue;
+		VkCommandBuffer m_UploadCommandBuffer;
+		uint8 m_UploadFrameIndex;
+		bool m_HasRecordedUploads;
 		std::unordered_map<uint32, VulkanVertexBuffer> m_VertexBuffers;
 		std::unordered_map<std::string, uint32> m_ModelNameToIdMap;
+		std::unordered_map<uint32, std::vector<Mesh>> m_SubMeshTemplates;
+		std::vector<std::vector<uint32>> m_PendingStagingReleases;
 	};
 } // End of Banshee namespace
\ No newline at end of file
@@ -6,9 +6,20 @@
 
 namespace Banshee
 {
-	Window::Window(const uint16 _width, const uint16 _height, const std::string_view _title) :
-		m_Window{ nullptr }
+	Window::Window(const uint16 _width, const uint16 _height, const std::string_view _title, const bool _headless, const uint32 _frameLimit) :
+		m_Window{ nullptr },
+		m_Width{ _width },
+		m_Height{ _height },
+		m_FrameLimit{ _frameLimit },
+		m_FrameCount{ 0 },
+		m_Headless{ _headless }
 	{
+		if (m_Headless)
+		{
+			BE_LOG(LogCategory::Info, "[WINDOW]: Running headless at %ux%u", _width, _height);
+			return;
+		}
+
 		BE_LOG(LogCategory::Trace, "[WINDOW]: Creating window");
 
 		if (!glfwInit())
@@ -31,6 +42,11 @@ namespace Banshee
 
 	Window::~Window()
 	{
+		if (m_Headless)
+		{
+			return;
+		}
+
 		if (m_Window)
 		{
 			glfwDestroyWindow(m_Window);
@@ -42,16 +58,30 @@ namespace Banshee
 
 	bool Window::ShouldWindowClose() const noexcept
 	{
-		return glfwWindowShouldClose(m_Window);
+		if (m_FrameLimit != 0 && m_FrameCount >= m_FrameLimit)
+		{
+			return true;
+		}
+
+		return m_Window && glfwWindowShouldClose(m_Window);
 	}
 
 	void Window::PollEvents() noexcept
 	{
-		glfwPollEvents();
+		++m_FrameCount;
+		if (m_Window)
+		{
+			glfwPollEvents();
+		}
 	}
 
 	uint16 Window::GetWidth() const noexcept
 	{
+		if (!m_Window)
+		{
+			return m_Width;
+		}
+
 		int w{ 0 };
 		glfwGetFramebufferSize(m_Window, &w, nullptr);
 		return w;
@@ -59,6 +89,11 @@ namespace Banshee
 
 	uint16 Window::GetHeight() const noexcept
 	{
+		if (!m_Window)
+		{
+			return m_Height;
+		}
+
 		int h{ 0 };
 		glfwGetFramebufferSize(m_Window, nullptr, &h);
 		return h;
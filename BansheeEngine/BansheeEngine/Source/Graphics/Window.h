@@ -7,15 +7,18 @@ struct GLFWwindow;
 
 namespace Banshee
 {
+	// A headless window creates no GLFW window, the renderer presents to a headless surface of the same size instead.
+	// With a frame limit the window reports that it should close once that many frames have been polled
 	class Window
 	{
 	public:
-		Window(const uint16 _width, const uint16 _height, const std::string_view _title);
+		Window(const uint16 _width, const uint16 _height, const std::string_view _title, const bool _headless = false, const uint32 _frameLimit = 0);
 		~Window();
 
 		bool ShouldWindowClose() const noexcept;
 		void PollEvents() noexcept;
 		GLFWwindow* GetWindow() const noexcept { return m_Window; }
+		bool IsHeadless() const noexcept { return m_Headless; }
 		uint16 GetWidth() const noexcept;
 		uint16 GetHeight() const noexcept;
 
@@ -26,5 +29,10 @@ namespace Banshee
 
 	private:
 		GLFWwindow* m_Window;
+		uint16 m_Width;
+		uint16 m_Height;
+		uint32 m_FrameLimit;
+		uint32 m_FrameCount;
+		bool m_Headless;
 	};
 } // End of Banshee namespace
\ No newline at end of file
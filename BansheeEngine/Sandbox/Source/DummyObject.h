@@ -10,16 +10,17 @@ class DummyObjectOne
 {
 public:
 	DummyObjectOne() : 
-		m_Entity(EntityManager::CreateEntity()),
-		m_Transform(m_Entity->AddComponent<TransformComponent>())
+		m_Entity(EntityManager::CreateEntity())
 	{
-		const auto& meshComponent = m_Entity->AddComponent<MeshComponent>(PrimitiveShape::CubeShape, ShaderType::Standard, glm::vec3(1.0f, 1.0f, 1.0f));
+		m_Entity.AddComponent<TransformComponent>();
+		MeshComponent* const meshComponent = m_Entity.AddComponent<MeshComponent>(PrimitiveShape::CubeShape, ShaderType::Standard, glm::vec3(1.0f, 1.0f, 1.0f));
 		meshComponent->SetTexture("Textures/wood.jpg");
-		m_Transform->SetPosition(glm::vec3(0.0f, 2.0f, -4.0f));
-		m_Transform->SetScale(glm::vec3(2.0f));
+
+		TransformComponent* const transform = m_Entity.GetTransform();
+		transform->SetPosition(glm::vec3(0.0f, 2.0f, -4.0f));
+		transform->SetScale(glm::vec3(2.0f));
 	}
 
 private:
-	std::shared_ptr<Entity> m_Entity;
-	std::shared_ptr<TransformComponent> m_Transform;
+	Entity m_Entity;
 };
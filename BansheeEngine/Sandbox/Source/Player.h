@@ -9,14 +9,13 @@ class Player
 {
 public:
 	Player() : 
-		m_Entity(EntityManager::CreateEntity()),
-		m_Transform(m_Entity->AddComponent<TransformComponent>())
+		m_Entity(EntityManager::CreateEntity())
 	{
-		m_Entity->AddComponent<MeshComponent>("Models/scene2.glb");
-		m_Transform->SetPosition(glm::vec3(0.0f, 0.0f, -1.0f));
+		m_Entity.AddComponent<TransformComponent>();
+		m_Entity.AddComponent<MeshComponent>("Models/scene2.glb");
+		m_Entity.GetTransform()->SetPosition(glm::vec3(0.0f, 0.0f, -1.0f));
 	}
 
 private:
-	std::shared_ptr<Entity> m_Entity;
-	std::shared_ptr<TransformComponent> m_Transform;
+	Entity m_Entity;
 };
\ No newline at end of file
@@ -0,0 +1,72 @@
+#pragma once
+
+#include "Foundation/Math/TransformKernel.h"
+#include <glm/gtc/matrix_transform.hpp>
+#include <chrono>
+#include <cstdio>
+#include <random>
+
+using namespace Banshee;
+
+// Prints matrices per second for the per-entity glm chain and each TransformKernel path.
+// Build the Sandbox with BANSHEE_TRANSFORM_BENCHMARK defined to run it at startup
+class TransformBenchmark
+{
+public:
+	static void Run()
+	{
+		for (const size_t transformCount : { 1'000, 100'000, 1'000'000 })
+		{
+			TransformSoA transforms{};
+			transforms.Reserve(transformCount);
+
+			std::mt19937 rng{ 1234 };
+			std::uniform_real_distribution<float> distribution{ -1.0f, 1.0f };
+			for (size_t i = 0; i < transformCount; ++i)
+			{
+				const glm::quat rotation = glm::normalize(glm::quat(distribution(rng), distribution(rng), distribution(rng), distribution(rng)));
+				transforms.Add(glm::vec3(distribution(rng), distribution(rng), distribution(rng)) * 100.0f, rotation, glm::vec3(1.0f + distribution(rng) * 0.5f));
+			}
+
+			std::vector<glm::mat4> matrices(transformCount);
+			std::printf("%zu transforms\n", transformCount);
+
+			Measure("glm chain", transforms, matrices, [](const TransformSoA& _transforms, glm::mat4* const _outMatrices)
+				{
+					for (size_t i = 0; i < _transforms.Size(); ++i)
+					{
+						const glm::vec3 position(_transforms.m_PositionX[i], _transforms.m_PositionY[i], _transforms.m_PositionZ[i]);
+						const glm::quat rotation(_transforms.m_RotationW[i], _transforms.m_RotationX[i], _transforms.m_RotationY[i], _transforms.m_RotationZ[i]);
+						const glm::vec3 scale(_transforms.m_ScaleX[i], _transforms.m_ScaleY[i], _transforms.m_ScaleZ[i]);
+						_outMatrices[i] = glm::translate(glm::mat4(1.0f), position) * glm::mat4_cast(rotation) * glm::scale(glm::mat4(1.0f), scale);
+					}
+				});
+
+			Measure("scalar", transforms, matrices, &TransformKernel::ComputeMatricesScalar);
+			Measure("SSE", transforms, matrices, &TransformKernel::ComputeMatricesSSE);
+
+			if (TransformKernel::IsAVXSupported())
+			{
+				Measure("AVX", transforms, matrices, &TransformKernel::ComputeMatricesAVX);
+			}
+		}
+	}
+
+private:
+	template<typename Func>
+	static void Measure(const char* const _name, const TransformSoA& _transforms, std::vector<glm::mat4>& _matrices, Func&& _func)
+	{
+		// Repeat small batches so every measurement covers roughly ten million matrices
+		const size_t iterations = std::max<size_t>(1, 10'000'000 / _transforms.Size());
+
+		const auto start = std::chrono::steady_clock::now();
+		for (size_t i = 0; i < iterations; ++i)
+		{
+			_func(_transforms, _matrices.data());
+		}
+		const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+		const double matricesPerSecond = static_cast<double>(_transforms.Size() * iterations) / elapsed.count();
+		std::printf("  %-10s %8.1f M matrices/s (checksum %f)\n", _name, matricesPerSecond / 1'000'000.0, _matrices.back()[3][0]);
+	}
+};
\ No newline at end of file
@@ -2,6 +2,36 @@
 #include "Player.h"
 #include "Light.h"
 
+#ifdef BANSHEE_TRANSFORM_BENCHMARK
+#include "TransformBenchmark.h"
+#endif
+
+#ifdef BANSHEE_SCENE_SNAPSHOT
+#include "Foundation/Serialization/SceneSnapshot.h"
+#include <optional>
+
+// Restores the scene from the last run's snapshot and only builds it from code when there is none.
+// Delete Generated/Sandbox.bsnap after changing the scene setup below
+class ClientApp : public Banshee::Application
+{
+public:
+	ClientApp() :
+		m_Player(),
+		m_Light()
+	{
+		if (!Banshee::SceneSnapshot::Load("Sandbox.bsnap"))
+		{
+			m_Player.emplace();
+			m_Light.emplace();
+			Banshee::SceneSnapshot::Save("Sandbox.bsnap");
+		}
+	}
+
+private:
+	std::optional<Player> m_Player;
+	std::optional<Light> m_Light;
+};
+#else
 class ClientApp : public Banshee::Application
 {
 public:
@@ -14,8 +44,13 @@ private:
 	Player m_Player;
 	Light m_Light;
 };
+#endif
 
 std::unique_ptr<Banshee::Application> CreateApplication()
 {
+#ifdef BANSHEE_TRANSFORM_BENCHMARK
+	TransformBenchmark::Run();
+#endif
+
 	return std::make_unique<ClientApp>();
 }
\ No newline at end of file